@@ -23,6 +23,7 @@ void CubismBreath::Delete(CubismBreath* instance)
 
 CubismBreath::CubismBreath()
                             : _currentTime(0.0f)
+                            , _parameterIndexModelId(0)
 { }
 
 CubismBreath::~CubismBreath()
@@ -31,6 +32,7 @@ CubismBreath::~CubismBreath()
 void CubismBreath::SetParameters(const csmVector<BreathParameterData>& breathParameters)
 {
     _breathParameters = breathParameters;
+    _parameterIndexModelId = 0;
 }
 
 const csmVector<CubismBreath::BreathParameterData>& CubismBreath::GetParameters() const
@@ -44,11 +46,21 @@ void CubismBreath::UpdateParameters(CubismModel* model, csmFloat32 deltaTimeSeco
 
     const csmFloat32 t = _currentTime * 2.0f * CubismMath::Pi;
 
+    if (model->GetModelId() != _parameterIndexModelId)
+    {
+        _parameterIndices.Resize(_breathParameters.GetSize(), -1);
+        for (csmUint32 i = 0; i < _breathParameters.GetSize(); ++i)
+        {
+            _parameterIndices[i] = model->GetParameterIndex(_breathParameters[i].ParameterId);
+        }
+        _parameterIndexModelId = model->GetModelId();
+    }
+
     for (csmUint32 i = 0; i < _breathParameters.GetSize(); ++i)
     {
         BreathParameterData* data = &_breathParameters[i];
 
-        model->AddParameterValue(data->ParameterId, data->Offset + (data->Peak * sinf(t / data->Cycle)), data->Weight);
+        model->AddParameterValue(_parameterIndices[i], data->Offset + (data->Peak * sinf(t / data->Cycle)), data->Weight);
     }
 }
 
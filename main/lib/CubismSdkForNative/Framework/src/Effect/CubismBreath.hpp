@@ -110,6 +110,8 @@ private:
 
     csmVector<BreathParameterData> _breathParameters;
     csmFloat32 _currentTime;
+    csmUint32 _parameterIndexModelId; ///< Model (GetModelId) the indices in _parameterIndices were resolved for, 0 if unresolved
+    csmVector<csmInt32> _parameterIndices;      ///< Parameter index of each entry in _breathParameters
 };
 
 }}}
@@ -35,6 +35,7 @@ CubismEyeBlink::CubismEyeBlink(ICubismModelSetting* modelSetting)
     , _closedSeconds(0.05f)
     , _openingSeconds(0.15f)
     , _userTimeSeconds(0.0f)
+    , _parameterIndexModelId(0)
 {
     if (modelSetting == NULL)
     {
@@ -72,6 +73,7 @@ void CubismEyeBlink::SetBlinkingSettings(csmFloat32 closing, csmFloat32 closed,
 void CubismEyeBlink::SetParameterIds(const csmVector<CubismIdHandle>& parameterIds)
 {
     _parameterIds = parameterIds;
+    _parameterIndexModelId = 0;
 }
 
 const csmVector<CubismIdHandle>& CubismEyeBlink::GetParameterIds() const
@@ -150,9 +152,19 @@ void CubismEyeBlink::UpdateParameters(CubismModel* model, csmFloat32 deltaTimeSe
         parameterValue = -parameterValue;
     }
 
-    for (csmUint32 i = 0; i < _parameterIds.GetSize(); ++i)
+    if (model->GetModelId() != _parameterIndexModelId)
     {
-        model->SetParameterValue(_parameterIds[i], parameterValue);
+        _parameterIndices.Resize(_parameterIds.GetSize(), -1);
+        for (csmUint32 i = 0; i < _parameterIds.GetSize(); ++i)
+        {
+            _parameterIndices[i] = model->GetParameterIndex(_parameterIds[i]);
+        }
+        _parameterIndexModelId = model->GetModelId();
+    }
+
+    for (csmUint32 i = 0; i < _parameterIndices.GetSize(); ++i)
+    {
+        model->SetParameterValue(_parameterIndices[i], parameterValue);
     }
 }
 
@@ -108,6 +108,8 @@ private:
     csmFloat32                  _closedSeconds;
     csmFloat32                  _openingSeconds;
     csmFloat32                  _userTimeSeconds;
+    csmUint32                   _parameterIndexModelId; ///< Model (GetModelId) the indices in _parameterIndices were resolved for, 0 if unresolved
+    csmVector<csmInt32>         _parameterIndices;      ///< Parameter index of each entry in _parameterIds
 
 };
 
@@ -6,22 +6,31 @@
  */
 
 #include "CubismId.hpp"
+#include "CubismIdManager.hpp"
 #include "Type/CubismBasicType.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
 CubismId::CubismId()
+                        : _hash(0)
 { }
 
 CubismId::CubismId(const CubismId& c)
                         : _id(c._id)
+                        , _hash(c._hash)
 { }
 
 CubismId::CubismId(const csmChar* id)
 {
     _id = id;
+    _hash = CubismIdManager::CalculateHash(_id.GetRawString(), _id.GetLength());
 }
 
+CubismId::CubismId(const csmChar* id, csmInt32 length, csmUint32 hash)
+                        : _id(id, length)
+                        , _hash(hash)
+{ }
+
 CubismId::~CubismId()
 { }
 
@@ -30,6 +39,7 @@ CubismId& CubismId::operator=(const CubismId& c)
     if (this != &c)
     {
         _id = c._id;
+        _hash = c._hash;
     }
 
     return *this;
@@ -37,12 +47,13 @@ CubismId& CubismId::operator=(const CubismId& c)
 
 csmBool CubismId::operator==(const CubismId& c) const
 {
-    return (_id == c._id);
+    // Registered IDs are interned, so the same string is always the same object.
+    return (this == &c) || (_hash == c._hash && _id == c._id);
 }
 
 csmBool CubismId::operator!=(const CubismId& c) const
 {
-    return !(_id == c._id);
+    return !(*this == c);
 }
 
 const csmString& CubismId::GetString() const
@@ -50,4 +61,9 @@ const csmString& CubismId::GetString() const
     return _id;
 }
 
+csmUint32 CubismId::GetHash() const
+{
+    return _hash;
+}
+
 }}}
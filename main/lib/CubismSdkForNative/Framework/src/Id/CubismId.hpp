@@ -27,6 +27,13 @@ struct CubismId
      */
     const csmString& GetString() const;
 
+    /**
+     * Returns the hash of the ID string.
+     *
+     * @return Hash computed by CubismIdManager when the ID was registered
+     */
+    csmUint32 GetHash() const;
+
     /**
      * Assigns the ID held by another CubismId to this ID.
      *
@@ -59,11 +66,14 @@ private:
 
     CubismId(const csmChar* id);
 
+    CubismId(const csmChar* id, csmInt32 length, csmUint32 hash);
+
     ~CubismId();
 
     CubismId(const CubismId& c);
 
     csmString _id;
+    csmUint32 _hash;
 };
 
 typedef const CubismId* CubismIdHandle;
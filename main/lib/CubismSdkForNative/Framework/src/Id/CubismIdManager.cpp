@@ -7,17 +7,31 @@
 
 #include "CubismIdManager.hpp"
 #include "CubismId.hpp"
+#include <string.h>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
 CubismIdManager::CubismIdManager()
+    : _chunkUsed(ChunkSize)
+    , _table(NULL)
+    , _tableSize(0)
 { }
 
 CubismIdManager::~CubismIdManager()
 {
     for (csmUint32 i = 0; i < _ids.GetSize(); ++i)
     {
-        CSM_DELETE_SELF(CubismId, _ids[i]);
+        _ids[i]->~CubismId();
+    }
+
+    for (csmUint32 i = 0; i < _chunks.GetSize(); ++i)
+    {
+        CSM_FREE(_chunks[i]);
+    }
+
+    if (_table != NULL)
+    {
+        CSM_FREE(_table);
     }
 }
 
@@ -39,7 +53,7 @@ void CubismIdManager::RegisterIds(const csmVector<csmString>& ids)
 
 const CubismId* CubismIdManager::GetId(const csmString& id)
 {
-    return RegisterId(id.GetRawString());
+    return RegisterId(id.GetRawString(), id.GetLength());
 }
 
 const CubismId* CubismIdManager::GetId(const csmChar* id)
@@ -49,44 +63,124 @@ const CubismId* CubismIdManager::GetId(const csmChar* id)
 
 csmBool CubismIdManager::IsExist(const csmString& id) const
 {
-    return IsExist(id.GetRawString());
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (FindId(id.GetRawString(), id.GetLength(), CalculateHash(id.GetRawString(), id.GetLength())) != NULL);
 }
 csmBool CubismIdManager::IsExist(const csmChar* id) const
 {
-    return (FindId(id) != NULL);
+    const csmInt32 length = static_cast<csmInt32>(strlen(id));
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (FindId(id, length, CalculateHash(id, length)) != NULL);
 }
 
 const CubismId* CubismIdManager::RegisterId(const csmChar* id)
 {
+    return RegisterId(id, static_cast<csmInt32>(strlen(id)));
+}
+
+const CubismId* CubismIdManager::RegisterId(const csmString& id)
+{
+    return RegisterId(id.GetRawString(), id.GetLength());
+}
+
+const CubismId* CubismIdManager::RegisterId(const csmChar* id, csmInt32 length)
+{
+    const csmUint32 hash = CalculateHash(id, length);
     CubismId* result = NULL;
 
-    if ((result = FindId(id)) != NULL)
+    // Assets may be parsed on several threads at once.
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if ((result = FindId(id, length, hash)) != NULL)
     {
         return result;
     }
 
-    result = CSM_NEW CubismId(id);
+    // Keep the load factor at or below 1/2.
+    if (static_cast<csmInt32>(_ids.GetSize() + 1) * 2 > _tableSize)
+    {
+        ResizeTable(_tableSize == 0 ? DefaultTableSize : _tableSize * 2);
+    }
+
+    result = AllocateId(id, length, hash);
     _ids.PushBack(result);
+    InsertToTable(result);
 
     return result;
 }
 
-const CubismId* CubismIdManager::RegisterId(const csmString& id)
+csmUint32 CubismIdManager::CalculateHash(const csmChar* id, csmInt32 length)
 {
-    return RegisterId(id.GetRawString());
+    // FNV-1a
+    csmUint32 hash = 2166136261u;
+    for (csmInt32 i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<csmUint8>(id[i]);
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-CubismId* CubismIdManager::FindId(const csmChar* id) const
+CubismId* CubismIdManager::FindId(const csmChar* id, csmInt32 length, csmUint32 hash) const
 {
-    for (csmUint32 i = 0; i < _ids.GetSize(); ++i)
+    if (_tableSize == 0)
     {
-        if (_ids[i]->GetString() == id)
+        return NULL;
+    }
+
+    const csmUint32 mask = static_cast<csmUint32>(_tableSize - 1);
+    for (csmUint32 slot = hash & mask; _table[slot] != NULL; slot = (slot + 1) & mask)
+    {
+        const CubismId* candidate = _table[slot];
+        if (candidate->_hash == hash &&
+            candidate->_id.GetLength() == length &&
+            memcmp(candidate->_id.GetRawString(), id, length) == 0)
         {
-            return _ids[i];
+            return _table[slot];
         }
     }
 
     return NULL;
 }
 
+CubismId* CubismIdManager::AllocateId(const csmChar* id, csmInt32 length, csmUint32 hash)
+{
+    if (_chunkUsed >= ChunkSize)
+    {
+        _chunks.PushBack(static_cast<CubismId*>(CSM_MALLOC(sizeof(CubismId) * ChunkSize)));
+        _chunkUsed = 0;
+    }
+
+    void* address = &_chunks[_chunks.GetSize() - 1][_chunkUsed++];
+    return CSM_PLACEMENT_NEW(address) CubismId(id, length, hash);
+}
+
+void CubismIdManager::InsertToTable(CubismId* id)
+{
+    const csmUint32 mask = static_cast<csmUint32>(_tableSize - 1);
+    csmUint32 slot = id->_hash & mask;
+    while (_table[slot] != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+    _table[slot] = id;
+}
+
+void CubismIdManager::ResizeTable(csmInt32 size)
+{
+    if (_table != NULL)
+    {
+        CSM_FREE(_table);
+    }
+
+    _table = static_cast<CubismId**>(CSM_MALLOC(sizeof(CubismId*) * size));
+    _tableSize = size;
+    memset(_table, 0, sizeof(CubismId*) * size);
+
+    for (csmUint32 i = 0; i < _ids.GetSize(); ++i)
+    {
+        InsertToTable(_ids[i]);
+    }
+}
+
 }}}
@@ -10,6 +10,7 @@
 #include "Type/CubismBasicType.hpp"
 #include "Type/csmString.hpp"
 #include "Type/csmVector.hpp"
+#include <mutex>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -17,6 +18,13 @@ struct CubismId;
 
 /**
  * Handles ID names.
+ *
+ * IDs are interned: each string is registered once, and lookups go through an
+ * open-addressing hash table keyed by the string hash, so GetId is O(1) amortized
+ * and equal IDs are always the same CubismId object.
+ * CubismId objects are allocated from fixed-size chunks owned by the manager.
+ * Registration and lookup are serialized by a mutex, so motions, physics and other
+ * assets that resolve IDs while parsing may be loaded on several threads at once.
  */
 class CubismIdManager
 {
@@ -105,13 +113,39 @@ public:
      */
     csmBool IsExist(const csmChar* id) const;
 
+    /**
+     * Calculates the hash of an ID string.
+     *
+     * @param id ID string
+     * @param length Length of the string
+     *
+     * @return Hash value
+     */
+    static csmUint32 CalculateHash(const csmChar* id, csmInt32 length);
+
 private:
+    static const csmInt32 ChunkSize = 128;      ///< Number of CubismId objects per arena chunk
+    static const csmInt32 DefaultTableSize = 256; ///< Initial slot count of the hash table (power of two)
+
     CubismIdManager(const CubismIdManager&);
     CubismIdManager& operator=(const CubismIdManager&);
 
-    CubismId* FindId(const csmChar* id) const;
+    CubismId* FindId(const csmChar* id, csmInt32 length, csmUint32 hash) const;
+
+    const CubismId* RegisterId(const csmChar* id, csmInt32 length);
+
+    CubismId* AllocateId(const csmChar* id, csmInt32 length, csmUint32 hash);
+
+    void InsertToTable(CubismId* id);
+
+    void ResizeTable(csmInt32 size);
 
-    csmVector<CubismId*> _ids;
+    csmVector<CubismId*> _ids;      ///< Registered IDs in registration order
+    csmVector<CubismId*> _chunks;   ///< Arena chunks holding the CubismId objects
+    csmInt32 _chunkUsed;            ///< Number of used objects in the last chunk
+    CubismId** _table;              ///< Hash table (NULL for an empty slot)
+    csmInt32 _tableSize;            ///< Slot count of the hash table
+    mutable std::mutex _mutex;      ///< Guards the members above
 };
 
 }}}
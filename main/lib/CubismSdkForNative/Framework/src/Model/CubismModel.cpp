@@ -10,6 +10,7 @@
 #include "Id/CubismId.hpp"
 #include "Id/CubismIdManager.hpp"
 #include "Math/CubismMath.hpp"
+#include <atomic>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -18,6 +19,9 @@ static csmInt32 IsBitSet(const csmUint8 byte, const csmUint8 mask)
     return ((byte & mask) == mask);
 }
 
+// モデルの識別子の採番。0は未割り当てを表すため1から始める
+static std::atomic<csmUint32> s_nextModelId(1);
+
 CubismModel::CubismModel(Core::csmModel* model)
     : _model(model)
     , _parameterValues(NULL)
@@ -29,6 +33,8 @@ CubismModel::CubismModel(Core::csmModel* model)
     , _isOverriddenModelScreenColors(false)
     , _isOverriddenCullings(false)
     , _modelOpacity(1.0f)
+    , _modelId(s_nextModelId.fetch_add(1, std::memory_order_relaxed))
+    , _drawableDynamicSource(NULL)
 { }
 
 CubismModel::~CubismModel()
@@ -162,23 +168,18 @@ csmFloat32 CubismModel::GetParameterMinimumValue(csmUint32 parameterIndex) const
 csmInt32 CubismModel::GetParameterIndex(CubismIdHandle parameterId)
 {
     csmInt32            parameterIndex;
-    const csmInt32      idCount = Core::csmGetParameterCount(_model);
-
+    const csmInt32*     found = _parameterIndices.Find(parameterId);
 
-    for (parameterIndex = 0; parameterIndex < idCount; ++parameterIndex)
+    if (found != NULL)
     {
-        if (parameterId != _parameterIds[parameterIndex])
-        {
-            continue;
-        }
-
-        return parameterIndex;
+        return *found;
     }
 
     // モデルに存在していない場合、非存在パラメータIDリスト内を検索し、そのインデックスを返す
-    if (_notExistParameterId.IsExist(parameterId))
+    found = _notExistParameterId.Find(parameterId);
+    if (found != NULL)
     {
-        return _notExistParameterId[parameterId];
+        return *found;
     }
 
     // 非存在パラメータIDリストにない場合、新しく要素を追加する
@@ -430,22 +431,20 @@ const csmFloat32* CubismModel::GetDrawableVertices(csmInt32 drawableIndex) const
 csmInt32 CubismModel::GetPartIndex(CubismIdHandle partId)
 {
     csmInt32            partIndex;
-    const csmInt32      idCount = Core::csmGetPartCount(_model);
+    const csmInt32*     found = _partIndices.Find(partId);
 
-    for (partIndex = 0; partIndex < idCount; ++partIndex)
+    if (found != NULL)
     {
-        if (partId == _partIds[partIndex])
-        {
-            return partIndex;
-        }
+        return *found;
     }
 
     const csmInt32 partCount = Core::csmGetPartCount(_model);
 
     // モデルに存在していない場合、非存在パーツIDリスト内にあるかを検索し、そのインデックスを返す
-    if (_notExistPartId.IsExist(partId))
+    found = _notExistPartId.Find(partId);
+    if (found != NULL)
     {
-        return _notExistPartId[partId];
+        return *found;
     }
 
     // 非存在パーツIDリストにない場合、新しく要素を追加する
@@ -472,11 +471,13 @@ void CubismModel::Initialize()
         ParameterRepeatData parameterRepeatData(false, false);
 
         _parameterIds.PrepareCapacity(parameterCount);
+        _parameterIndices.PrepareCapacity(parameterCount, true);
         _userParameterRepeatDataList.PrepareCapacity(parameterCount);
 
         for (csmInt32 i = 0; i < parameterCount; ++i)
         {
             _parameterIds.PushBack(CubismFramework::GetIdManager()->GetId(parameterIds[i]));
+            _parameterIndices[_parameterIds[i]] = i;
 
             _userParameterRepeatDataList.PushBack(parameterRepeatData);
         }
@@ -487,9 +488,11 @@ void CubismModel::Initialize()
         const csmChar** partIds = Core::csmGetPartIds(_model);
 
         _partIds.PrepareCapacity(partCount);
+        _partIndices.PrepareCapacity(partCount, true);
         for (csmInt32 i = 0; i < partCount; ++i)
         {
             _partIds.PushBack(CubismFramework::GetIdManager()->GetId(partIds[i]));
+            _partIndices[_partIds[i]] = i;
         }
 
         _userPartMultiplyColors.PrepareCapacity(partCount);
@@ -599,7 +602,7 @@ const csmInt32* CubismModel::GetPartParentPartIndices() const
 
 const csmInt32* CubismModel::GetDrawableRenderOrders() const
 {
-    const csmInt32* renderOrders = Core::csmGetDrawableRenderOrders(_model);
+    const csmInt32* renderOrders = _drawableDynamicSource ? _drawableDynamicSource->RenderOrders : Core::csmGetDrawableRenderOrders(_model);
     return renderOrders;
 }
 
@@ -640,7 +643,7 @@ const csmUint16* CubismModel::GetDrawableVertexIndices(csmInt32 drawableIndex) c
 
 const Core::csmVector2* CubismModel::GetDrawableVertexPositions(csmInt32 drawableIndex) const
 {
-    const Core::csmVector2** verticesArray = Core::csmGetDrawableVertexPositions(_model);
+    const Core::csmVector2* const* verticesArray = _drawableDynamicSource ? _drawableDynamicSource->VertexPositions : Core::csmGetDrawableVertexPositions(_model);
     return verticesArray[drawableIndex];
 }
 
@@ -652,19 +655,19 @@ const Core::csmVector2* CubismModel::GetDrawableVertexUvs(csmInt32 drawableIndex
 
 csmFloat32 CubismModel::GetDrawableOpacity(csmInt32 drawableIndex) const
 {
-    const csmFloat32* opacities = Core::csmGetDrawableOpacities(_model);
+    const csmFloat32* opacities = _drawableDynamicSource ? _drawableDynamicSource->Opacities : Core::csmGetDrawableOpacities(_model);
     return opacities[drawableIndex];
 }
 
 Core::csmVector4 CubismModel::GetDrawableMultiplyColor(csmInt32 drawableIndex) const
 {
-    const Core::csmVector4* multiplyColors = Core::csmGetDrawableMultiplyColors(_model);
+    const Core::csmVector4* multiplyColors = _drawableDynamicSource ? _drawableDynamicSource->MultiplyColors : Core::csmGetDrawableMultiplyColors(_model);
     return multiplyColors[drawableIndex];
 }
 
 Core::csmVector4 CubismModel::GetDrawableScreenColor(csmInt32 drawableIndex) const
 {
-    const Core::csmVector4* screenColors = Core::csmGetDrawableScreenColors(_model);
+    const Core::csmVector4* screenColors = _drawableDynamicSource ? _drawableDynamicSource->ScreenColors : Core::csmGetDrawableScreenColors(_model);
     return screenColors[drawableIndex];
 }
 
@@ -675,43 +678,43 @@ csmInt32 CubismModel::GetDrawableParentPartIndex(csmUint32 drawableIndex) const
 
 csmBool CubismModel::GetDrawableDynamicFlagIsVisible(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmIsVisible)!=0 ? true : false;
 }
 
 csmBool CubismModel::GetDrawableDynamicFlagVisibilityDidChange(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmVisibilityDidChange)!=0 ? true : false;
 }
 
 csmBool CubismModel::GetDrawableDynamicFlagOpacityDidChange(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmOpacityDidChange) != 0 ? true : false;
 }
 
 csmBool CubismModel::GetDrawableDynamicFlagDrawOrderDidChange(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmDrawOrderDidChange) != 0 ? true : false;
 }
 
 csmBool CubismModel::GetDrawableDynamicFlagRenderOrderDidChange(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmRenderOrderDidChange) != 0 ? true : false;
 }
 
 csmBool CubismModel::GetDrawableDynamicFlagVertexPositionsDidChange(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmVertexPositionsDidChange) != 0 ? true : false;
 }
 
 csmBool CubismModel::GetDrawableDynamicFlagBlendColorDidChange(csmInt32 drawableIndex) const
 {
-    const Core::csmFlags* dynamicFlags = Core::csmGetDrawableDynamicFlags(_model);
+    const Core::csmFlags* dynamicFlags = _drawableDynamicSource ? _drawableDynamicSource->DynamicFlags : Core::csmGetDrawableDynamicFlags(_model);
     return IsBitSet(dynamicFlags[drawableIndex], Core::csmBlendColorDidChange) != 0 ? true : false;
 }
 
@@ -1157,6 +1160,16 @@ Core::csmModel* CubismModel::GetModel() const
     return _model;
 }
 
+csmUint32 CubismModel::GetModelId() const
+{
+    return _modelId;
+}
+
+void CubismModel::SetDrawableDynamicSource(const DrawableDynamicSource* source)
+{
+    _drawableDynamicSource = source;
+}
+
 csmBool CubismModel::IsUsingMasking() const
 {
     for (csmInt32 d = 0; d < Core::csmGetDrawableCount(_model); ++d)
@@ -153,6 +153,22 @@ public:
         csmBool IsParameterRepeated;     ///< Override flag for settings
     };
 
+    /**
+     * Drawable data that changes on every update, supplied from outside the Core model.
+     *
+     * Every array is indexed by drawable index and must stay valid while it is set
+     * (see SetDrawableDynamicSource).
+     */
+    struct DrawableDynamicSource
+    {
+        const Core::csmVector2* const* VertexPositions;    ///< Vertex positions of each drawable
+        const csmFloat32* Opacities;                        ///< Opacities
+        const csmInt32* RenderOrders;                       ///< Render orders
+        const Core::csmFlags* DynamicFlags;                 ///< Dynamic flags
+        const Core::csmVector4* MultiplyColors;             ///< Multiply colors
+        const Core::csmVector4* ScreenColors;               ///< Screen colors
+    };
+
     /**
      * Calculates and updates the model state based on the set parameters.
      */
@@ -196,6 +212,10 @@ public:
     /**
      * Returns the index of the part.
      *
+     * Resolved through a hash index built in Initialize(). The index of a given ID never
+     * changes for the lifetime of the model, so callers that touch the same parts every
+     * frame should resolve once and use the index-based accessors.
+     *
      * @param partId Part ID
      *
      * @return Index of the part
@@ -261,6 +281,11 @@ public:
     /**
      * Returns the index of the parameter.
      *
+     * Resolved through a hash index built in Initialize(). The index of a given ID never
+     * changes for the lifetime of the model (IDs the model does not have get a stable
+     * index past GetParameterCount()), so callers that touch the same parameters every
+     * frame should resolve once and use the index-based accessors.
+     *
      * @param parameterId Parameter ID
      *
      * @return Parameter index
@@ -1111,6 +1136,29 @@ public:
 
     Core::csmModel*     GetModel() const;
 
+    /**
+     * Returns the identifier of this model instance.
+     *
+     * Identifiers are never reused within the process, unlike the address of a model that
+     * was deleted, so objects that cache per-model data (such as resolved parameter indices)
+     * key the cache on this value.
+     *
+     * @return Identifier of the model (never 0)
+     */
+    csmUint32           GetModelId() const;
+
+    /**
+     * Makes the drawable accessors read the given arrays instead of the Core model.
+     *
+     * This lets a model that is never updated be drawn from data computed by another
+     * instance of the same moc without writing into the read-only arrays of the Core.
+     * The accessors affected are those of vertex positions, opacities, render orders,
+     * dynamic flags, multiply colors and screen colors.
+     *
+     * @param source Arrays to read, or NULL to read the Core model again. Not copied.
+     */
+    void                SetDrawableDynamicSource(const DrawableDynamicSource* source);
+
 private:
     CubismModel(Core::csmModel* model);
 
@@ -1151,8 +1199,14 @@ private:
 
     csmFloat32 _modelOpacity;
 
+    csmUint32 _modelId;     ///< Identifier unique to this instance (see GetModelId)
+
+    const DrawableDynamicSource* _drawableDynamicSource;    ///< Replaces the Core drawable data when not NULL
+
     csmVector<CubismIdHandle> _parameterIds;
     csmVector<CubismIdHandle> _partIds;
+    csmMap<CubismIdHandle, csmInt32> _parameterIndices;   ///< Parameter ID -> index
+    csmMap<CubismIdHandle, csmInt32> _partIndices;        ///< Part ID -> index
     csmVector<CubismIdHandle> _drawableIds;
     csmVector<ParameterRepeatData> _userParameterRepeatDataList;
     csmVector<DrawableColorData> _userScreenColors;
@@ -272,6 +272,11 @@ CubismModel* CubismUserModel::GetModel() const
 }
 
 void CubismUserModel::CreateRenderer(csmInt32 maskBufferCount)
+{
+    CreateRenderer(_model, maskBufferCount);
+}
+
+void CubismUserModel::CreateRenderer(CubismModel* model, csmInt32 maskBufferCount)
 {
     if (_renderer)
     {
@@ -279,7 +284,7 @@ void CubismUserModel::CreateRenderer(csmInt32 maskBufferCount)
     }
     _renderer = Rendering::CubismRenderer::Create();
 
-    _renderer->Initialize(_model, maskBufferCount);
+    _renderer->Initialize(model, maskBufferCount);
 }
 
 void CubismUserModel::DeleteRenderer()
@@ -196,6 +196,16 @@ public:
      */
     void CreateRenderer(csmInt32 maskBufferCount = 1);
 
+    /**
+     * Makes the renderer for another model created from the same moc.
+     *
+     * Lets the renderer draw a copy of the drawable data while this instance keeps updating its own model.
+     *
+     * @param model             Model that the renderer draws
+     * @param maskBufferCount   Number of mask buffers
+     */
+    void CreateRenderer(CubismModel* model, csmInt32 maskBufferCount = 1);
+
     /**
      * Destroys the renderer.
      */
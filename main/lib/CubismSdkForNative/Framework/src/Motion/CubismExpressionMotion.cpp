@@ -9,6 +9,8 @@
 #include "CubismMotionQueueEntry.hpp"
 #include "Id/CubismIdManager.hpp"
 #include "Math/CubismMath.hpp"
+#include "Utils/CubismBinary.hpp"
+#include <atomic>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -27,40 +29,109 @@ const csmChar* BlendValueAdd = "Add";
 const csmChar* BlendValueMultiply = "Multiply";
 const csmChar* BlendValueOverwrite = "Overwrite";
 const csmFloat32 DefaultFadeTime = 1.0f;
+
+// バイナリ形式の本体
+struct ExpressionBinaryBody
+{
+    csmFloat32 FadeInTime;
+    csmFloat32 FadeOutTime;
+    csmInt32 ParameterCount;
+    csmUint32 ParameterOffset;
+};
+
+// バイナリ形式のパラメータ
+struct ExpressionBinaryParameter
+{
+    csmUint32 IdOffset;
+    csmInt32 BlendType;
+    csmFloat32 Value;
+};
 }
 
 
+struct CubismExpressionMotion::ExpressionData
+{
+    ExpressionData()
+        : ReferenceCount(1)
+    { }
+
+    csmVector<ExpressionParameter> Parameters;     ///< パラメータのリスト
+    std::atomic<csmInt32> ReferenceCount;          ///< このデータを使う表情の数（CreateShared を参照）
+};
+
 CubismExpressionMotion::CubismExpressionMotion()
+    : _data(NULL)
+    , _parameterIndexModelId(0)
 { }
 
 CubismExpressionMotion::~CubismExpressionMotion()
-{ }
+{
+    // 共有しているデータは最後の表情が解放する
+    if (_data != NULL && --_data->ReferenceCount == 0)
+    {
+        CSM_DELETE(_data);
+    }
+}
 
 CubismExpressionMotion* CubismExpressionMotion::Create(const csmByte* buffer, csmSizeInt size)
 {
     CubismExpressionMotion* expression = CSM_NEW CubismExpressionMotion();
-    expression->Parse(buffer, size);
+    expression->_data = CSM_NEW ExpressionData();
+    if (Utils::CubismBinary::IsBinary(buffer, size))
+    {
+        expression->ParseBinary(buffer, size);
+    }
+    else
+    {
+        expression->Parse(buffer, size);
+    }
+    return expression;
+}
+
+CubismExpressionMotion* CubismExpressionMotion::CreateShared(const CubismExpressionMotion* source)
+{
+    CubismExpressionMotion* expression = CSM_NEW CubismExpressionMotion();
+
+    expression->_data = source->_data;
+    ++expression->_data->ReferenceCount;
+
+    expression->_fadeInSeconds = source->_fadeInSeconds;
+    expression->_fadeOutSeconds = source->_fadeOutSeconds;
     return expression;
 }
 
 void CubismExpressionMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSeconds, csmFloat32 weight, CubismMotionQueueEntry* motionQueueEntry)
 {
-    for (csmUint32 i = 0; i < _parameters.GetSize(); ++i)
+    // パラメータのインデックスはモデルが変わったときだけ引き直す
+    if (model->GetModelId() != _parameterIndexModelId)
     {
-        ExpressionParameter& parameter = _parameters[i];
+        const csmVector<ExpressionParameter>& parameters = _data->Parameters;
+        _parameterIndices.Resize(parameters.GetSize(), -1);
+        for (csmUint32 i = 0; i < parameters.GetSize(); ++i)
+        {
+            _parameterIndices[i] = model->GetParameterIndex(parameters[i].ParameterId);
+        }
+        _parameterIndexModelId = model->GetModelId();
+    }
+
+    const csmVector<ExpressionParameter>& parameters = _data->Parameters;
+    for (csmUint32 i = 0; i < parameters.GetSize(); ++i)
+    {
+        const ExpressionParameter& parameter = parameters[i];
+        const csmInt32 parameterIndex = _parameterIndices[i];
 
         switch (parameter.BlendType)
         {
         case Additive: {
-            model->AddParameterValue(parameter.ParameterId, parameter.Value, weight);            // 相対変化 加算
+            model->AddParameterValue(parameterIndex, parameter.Value, weight);            // 相対変化 加算
             break;
         }
         case Multiply: {
-            model->MultiplyParameterValue(parameter.ParameterId, parameter.Value, weight);       // 相対変化 乗算
+            model->MultiplyParameterValue(parameterIndex, parameter.Value, weight);       // 相対変化 乗算
             break;
         }
         case Overwrite: {
-            model->SetParameterValue(parameter.ParameterId, parameter.Value, weight);            // 絶対変化 上書き
+            model->SetParameterValue(parameterIndex, parameter.Value, weight);            // 絶対変化 上書き
             break;
         }
         default:
@@ -98,9 +169,9 @@ void CubismExpressionMotion::CalculateExpressionParameters(CubismModel* model, c
         }
 
         const csmFloat32 currentParameterValue = expressionParameterValue.OverwriteValue =
-            model->GetParameterValue(expressionParameterValue.ParameterId);
+            model->GetParameterValue(expressionParameterValue.ParameterIndex);
 
-        csmVector<ExpressionParameter> expressionParameters = GetExpressionParameters();
+        const csmVector<ExpressionParameter>& expressionParameters = _data->Parameters;
         csmInt32 parameterIndex = -1;
         for (csmInt32 j = 0; j < expressionParameters.GetSize(); ++j)
         {
@@ -140,9 +211,9 @@ void CubismExpressionMotion::CalculateExpressionParameters(CubismModel* model, c
         }
 
         // 値を計算
-        csmFloat32 value = expressionParameters.At(parameterIndex).Value;
+        csmFloat32 value = expressionParameters[parameterIndex].Value;
         csmFloat32 newAdditiveValue, newMultiplyValue, newSetValue;
-        switch (expressionParameters.At(parameterIndex).BlendType) {
+        switch (expressionParameters[parameterIndex].BlendType) {
         case Additive:
             newAdditiveValue = value;
             newMultiplyValue = DefaultMultiplyValue;
@@ -175,9 +246,9 @@ void CubismExpressionMotion::CalculateExpressionParameters(CubismModel* model, c
     }
 }
 
-csmVector<CubismExpressionMotion::ExpressionParameter> CubismExpressionMotion::GetExpressionParameters()
+const csmVector<CubismExpressionMotion::ExpressionParameter>& CubismExpressionMotion::GetExpressionParameters() const
 {
-    return _parameters;
+    return _data->Parameters;
 }
 
 csmFloat32 CubismExpressionMotion::GetFadeWeight()
@@ -202,7 +273,7 @@ void CubismExpressionMotion::Parse(const csmByte* buffer, csmSizeInt size)
 
     // 各パラメータについて
     const csmInt32 parameterCount = root[ExpressionKeyParameters].GetSize();
-    _parameters.PrepareCapacity(parameterCount);
+    _data->Parameters.PrepareCapacity(parameterCount);
 
     for (csmInt32 i = 0; i < parameterCount; ++i)
     {
@@ -238,12 +309,95 @@ void CubismExpressionMotion::Parse(const csmByte* buffer, csmSizeInt size)
         item.BlendType = blendType;
         item.Value = value;
 
-        _parameters.PushBack(item);
+        _data->Parameters.PushBack(item);
     }
 
     Utils::CubismJson::Delete(json);// JSONデータは不要になったら削除する
 }
 
+void CubismExpressionMotion::ParseBinary(const csmByte* buffer, csmSizeInt size)
+{
+    using Utils::CubismBinary;
+
+    const CubismBinary::Header* header = CubismBinary::GetHeader(buffer, size, CubismBinary::Kind_Expression);
+    const ExpressionBinaryBody* body = (header != NULL) ? CubismBinary::GetBody<ExpressionBinaryBody>(header) : NULL;
+    const ExpressionBinaryParameter* parameters = (body != NULL && body->ParameterCount >= 0)
+        ? CubismBinary::GetArray<ExpressionBinaryParameter>(header, body->ParameterOffset, body->ParameterCount)
+        : NULL;
+
+    if (parameters == NULL)
+    {
+        CubismLogError("Invalid binary expression.");
+        return;
+    }
+
+    SetFadeInTime(body->FadeInTime);
+    SetFadeOutTime(body->FadeOutTime);
+
+    _data->Parameters.PrepareCapacity(body->ParameterCount);
+
+    for (csmInt32 i = 0; i < body->ParameterCount; ++i)
+    {
+        const csmChar* parameterId = CubismBinary::GetString(header, parameters[i].IdOffset);
+        if (parameterId == NULL)
+        {
+            CubismLogError("Invalid binary expression parameter.");
+            _data->Parameters.Clear();
+            return;
+        }
+
+        ExpressionParameter item;
+
+        item.ParameterId = CubismFramework::GetIdManager()->GetId(parameterId);
+        item.Value = parameters[i].Value;
+
+        // 仕様にない値は JSON と同様に加算モードにする
+        switch (parameters[i].BlendType)
+        {
+        case Multiply:
+            item.BlendType = Multiply;
+            break;
+        case Overwrite:
+            item.BlendType = Overwrite;
+            break;
+        default:
+            item.BlendType = Additive;
+            break;
+        }
+
+        _data->Parameters.PushBack(item);
+    }
+}
+
+void CubismExpressionMotion::ExportBinary(csmVector<csmByte>& buffer) const
+{
+    using Utils::CubismBinary;
+    using Utils::CubismBinaryWriter;
+
+    ExpressionBinaryBody body;
+    body.FadeInTime = GetFadeInTime();
+    body.FadeOutTime = GetFadeOutTime();
+    body.ParameterCount = _data->Parameters.GetSize();
+
+    CubismBinaryWriter writer(CubismBinary::Kind_Expression, sizeof(body));
+
+    csmVector<ExpressionBinaryParameter> parameters(body.ParameterCount > 0 ? body.ParameterCount : 1);
+    for (csmInt32 i = 0; i < body.ParameterCount; ++i)
+    {
+        ExpressionBinaryParameter item;
+
+        item.IdOffset = writer.AddString(_data->Parameters[i].ParameterId->GetString().GetRawString());
+        item.BlendType = _data->Parameters[i].BlendType;
+        item.Value = _data->Parameters[i].Value;
+
+        parameters.PushBack(item);
+    }
+
+    body.ParameterOffset = writer.AddArray(parameters.GetPtr(), sizeof(ExpressionBinaryParameter) * parameters.GetSize());
+
+    writer.Finish(&body, buffer);
+}
+
 csmFloat32 CubismExpressionMotion::CalculateValue(csmFloat32 source, csmFloat32 destination, csmFloat32 fadeWeight)
 {
     return (source * (1.0f - fadeWeight)) + (destination * fadeWeight);
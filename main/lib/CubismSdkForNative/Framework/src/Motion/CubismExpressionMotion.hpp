@@ -43,6 +43,8 @@ public:
     /**
      * Makes an instance.
      *
+     * The buffer may hold either an exp3.json or the CubismBinary form written by ExportBinary.
+     *
      * @param buf buffer containing the loaded facial expression settings file
      * @param size size of the buffer in bytes
      *
@@ -50,6 +52,26 @@ public:
      */
     static CubismExpressionMotion* Create(const csmByte* buf, csmSizeInt size);
 
+    /**
+     * Makes an instance that shares the parameter list of another expression.
+     *
+     * The fade times are copied. The parameter indices are resolved per instance,
+     * so the expressions can be used on different models and threads at the same time.
+     * The shared list is reference-counted and released with the last expression using it.
+     *
+     * @param source expression to share the parameter list with
+     *
+     * @return created instance
+     */
+    static CubismExpressionMotion* CreateShared(const CubismExpressionMotion* source);
+
+    /**
+     * Writes the facial expression in the CubismBinary format.
+     *
+     * @param buffer receives the file contents
+     */
+    void ExportBinary(csmVector<csmByte>& buffer) const;
+
     /**
      * Updates the model parameters.
      *
@@ -75,7 +97,7 @@ public:
     /**
      * Returns the parameters referenced by the facial expression.
      */
-    csmVector<ExpressionParameter> GetExpressionParameters();
+    const csmVector<ExpressionParameter>& GetExpressionParameters() const;
 
     /**
      * Returns the current fade weight value of the facial expression.
@@ -99,7 +121,14 @@ protected:
 
     void Parse(const csmByte* exp3Json, csmSizeInt size);
 
-    csmVector<ExpressionParameter> _parameters;
+    void ParseBinary(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * Parameter list shared by the expressions made with CreateShared
+     */
+    struct ExpressionData;
+
+    ExpressionData* _data;  ///< Parsed parameter list, read-only once the expression is created
 
 private:
 
@@ -107,6 +136,9 @@ private:
 
 
     csmFloat32 _fadeWeight;
+
+    csmUint32           _parameterIndexModelId; ///< Model (GetModelId) the indices in _parameterIndices were resolved for, 0 if unresolved
+    csmVector<csmInt32> _parameterIndices;      ///< Parameter index of each entry in _parameters
 };
 
 }}}
@@ -98,12 +98,12 @@ csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat
 
         if (expressionMotion == NULL)
         {
-            CSM_DELETE(motionQueueEntry);
+            ReleaseEntry(motionQueueEntry);
             ite = motions->Erase(ite);          // 削除
             continue;
         }
 
-        csmVector<CubismExpressionMotion::ExpressionParameter> expressionParameters = expressionMotion->GetExpressionParameters();
+        const csmVector<CubismExpressionMotion::ExpressionParameter>& expressionParameters = expressionMotion->GetExpressionParameters();
         if (motionQueueEntry->IsAvailable())
         {
             // 再生中のExpressionが参照しているパラメータをすべてリストアップ
@@ -135,9 +135,10 @@ csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat
                 // パラメータがリストに存在しないなら新規追加
                 ExpressionParameterValue item;
                 item.ParameterId = expressionParameters[i].ParameterId;
+                item.ParameterIndex = model->GetParameterIndex(item.ParameterId);
                 item.AdditiveValue = CubismExpressionMotion::DefaultAdditiveValue;
                 item.MultiplyValue = CubismExpressionMotion::DefaultMultiplyValue;
-                item.OverwriteValue = model->GetParameterValue(item.ParameterId);
+                item.OverwriteValue = model->GetParameterValue(item.ParameterIndex);
                 _expressionParameterValues->PushBack(item);
             }
         }
@@ -176,7 +177,7 @@ csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat
             for (csmInt32 i = motions->GetSize()-2; i >= 0; i--)
             {
                 CubismMotionQueueEntry* motionQueueEntry = motions->At(i);
-                CSM_DELETE(motionQueueEntry);
+                ReleaseEntry(motionQueueEntry);
                 motions->Remove(i);
                 _fadeWeights->Remove(i);
             }
@@ -191,7 +192,7 @@ csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat
     // モデルに各値を適用
     for (csmInt32 i = 0; i < _expressionParameterValues->GetSize(); ++i)
     {
-        model->SetParameterValue(_expressionParameterValues->At(i).ParameterId,
+        model->SetParameterValue(_expressionParameterValues->At(i).ParameterIndex,
             (_expressionParameterValues->At(i).OverwriteValue + _expressionParameterValues->At(i).AdditiveValue) * _expressionParameterValues->At(i).MultiplyValue,
             expressionWeight);
 
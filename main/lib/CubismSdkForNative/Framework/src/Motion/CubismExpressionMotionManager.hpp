@@ -25,6 +25,7 @@ public:
     struct ExpressionParameterValue
     {
         CubismIdHandle      ParameterId;        ///< Parameter ID
+        csmInt32            ParameterIndex;     ///< Parameter index in the model, resolved when the entry is added
         csmFloat32          AdditiveValue;      ///< Added value
         csmFloat32          MultiplyValue;      ///< Multiplied value
         csmFloat32          OverwriteValue;     ///< Overwritten value
@@ -7,6 +7,8 @@
 
 #include "CubismMotion.hpp"
 #include <float.h>
+#include <math.h>
+#include <string.h>
 #include "CubismFramework.hpp"
 #include "CubismMotionInternal.hpp"
 #include "CubismMotionJson.hpp"
@@ -15,6 +17,12 @@
 #include "Math/CubismMath.hpp"
 #include "Type/csmVector.hpp"
 #include "Id/CubismIdManager.hpp"
+#include "Utils/CubismBinary.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CSM_MOTION_BAKE_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -34,6 +42,16 @@ const csmChar* IdNameOpacity = "Opacity";
 */
 const csmBool UseOldBeziersCurveMotion = false;
 
+/**
+* セグメントカーソルから前方へ線形に探索する最大セグメント数。超えた場合は二分探索に切り替える。
+*/
+const csmInt32 SegmentCursorMaxSteps = 4;
+
+/**
+* ベイクしたテーブルの行のアラインメント[バイト]
+*/
+const csmUint32 BakedRowAlignment = 16;
+
 CubismMotionPoint LerpPoints(const CubismMotionPoint a, const CubismMotionPoint b, const csmFloat32 t)
 {
     CubismMotionPoint result;
@@ -214,34 +232,97 @@ csmFloat32 CorrectEndPoint(
     }
 }
 
-csmFloat32 EvaluateCurve(const CubismMotionData* motionData, const csmInt32 index, csmFloat32 time, const csmBool isCorrection, const csmFloat32 endTime)
+/**
+* セグメントの終点（次のセグメントの始点）のインデックスを返す
+*/
+inline csmInt32 GetSegmentEndPointIndex(const CubismMotionData* motionData, const csmInt32 segmentIndex)
 {
-    // Find segment to evaluate.
-    const CubismMotionCurve& curve = motionData->Curves[index];
+    const CubismMotionSegment& segment = motionData->Segments[segmentIndex];
 
-    csmInt32 target = -1;
+    return segment.BasePointIndex
+        + (segment.SegmentType == CubismMotionSegmentType_Bezier
+            ? 3
+            : 1);
+}
+
+/**
+* time を含むセグメントを探す
+*
+* 終点の時刻が time を超える最初のセグメントを返す。該当がなければ -1 。
+* segmentCursor には前回のセグメントを保持しておき、再生時間が単調に進む間は
+* そこから数セグメント先までを調べるだけで済ませる。ループやシークで外れた場合は二分探索する。
+*
+* @param[in]     motionData    モーションデータ
+* @param[in]     curve         対象のカーブ
+* @param[in]     time          時間[秒]
+* @param[in,out] segmentCursor 前回のセグメントのインデックス（-1 で未設定、NULL 可）
+*/
+csmInt32 FindSegment(const CubismMotionData* motionData, const CubismMotionCurve& curve, const csmFloat32 time, csmInt32* segmentCursor)
+{
+    const csmInt32 firstSegment = curve.BaseSegmentIndex;
     const csmInt32 totalSegmentCount = curve.BaseSegmentIndex + curve.SegmentCount;
-    csmInt32 pointPosition = 0;
-    for (csmInt32 i = curve.BaseSegmentIndex; i < totalSegmentCount; ++i)
+    csmInt32 i = (segmentCursor != NULL) ? *segmentCursor : -1;
+
+    // 前回のセグメントより前に戻っていなければ、そこから前方へ探索する
+    if (i >= firstSegment && i < totalSegmentCount
+        && (i == firstSegment || motionData->Points[GetSegmentEndPointIndex(motionData, i - 1)].Time <= time))
     {
-        // Get first point of next segment.
-        pointPosition = motionData->Segments[i].BasePointIndex
-            + (motionData->Segments[i].SegmentType == CubismMotionSegmentType_Bezier
-                ? 3
-                : 1);
+        for (csmInt32 step = 0; step < SegmentCursorMaxSteps && i < totalSegmentCount; ++step, ++i)
+        {
+            if (motionData->Points[GetSegmentEndPointIndex(motionData, i)].Time > time)
+            {
+                *segmentCursor = i;
+                return i;
+            }
+        }
 
+        if (i == totalSegmentCount)
+        {
+            *segmentCursor = totalSegmentCount - 1;
+            return -1;
+        }
+    }
+
+    // 終点の時刻は昇順に並んでいるため二分探索できる
+    csmInt32 low = firstSegment;
+    csmInt32 high = totalSegmentCount;
+    while (low < high)
+    {
+        const csmInt32 middle = low + (high - low) / 2;
 
-        // Break if time lies within current segment.
-        if (motionData->Points[pointPosition].Time > time)
+        if (motionData->Points[GetSegmentEndPointIndex(motionData, middle)].Time > time)
         {
-            target = i;
-            break;
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
         }
     }
 
+    if (segmentCursor != NULL)
+    {
+        *segmentCursor = (low < totalSegmentCount) ? low : totalSegmentCount - 1;
+    }
+
+    return (low < totalSegmentCount) ? low : -1;
+}
+
+csmFloat32 EvaluateCurve(const CubismMotionData* motionData, const csmInt32 index, csmFloat32 time, const csmBool isCorrection, const csmFloat32 endTime, csmInt32* segmentCursor)
+{
+    // Find segment to evaluate.
+    const CubismMotionCurve& curve = motionData->Curves[index];
+
+    const csmInt32 target = FindSegment(motionData, curve, time, segmentCursor);
+    const csmInt32 totalSegmentCount = curve.BaseSegmentIndex + curve.SegmentCount;
 
     if (target == -1)
     {
+        // Get last point of the curve.
+        const csmInt32 pointPosition = (curve.SegmentCount > 0)
+            ? GetSegmentEndPointIndex(motionData, totalSegmentCount - 1)
+            : 0;
+
         if (isCorrection && time < endTime)
         {
             // 終点から始点への補正処理
@@ -272,6 +353,14 @@ CubismMotion::CubismMotion()
     , _motionBehavior(MotionBehavior_V2)
     , _lastWeight(0.0f)
     , _motionData(NULL)
+    , _parameterIndexModelId(0)
+    , _bakedOutput(NULL)
+    , _bakedStride(0)
+    , _bakedSampleCount(0)
+    , _bakedInverseStep(0.0f)
+    , _bakedDuration(0.0f)
+    , _bakedIsCorrection(false)
+    , _bakedMaxError(0.0f)
     , _modelCurveIdEyeBlink(NULL)
     , _modelCurveIdLipSync(NULL)
     , _modelCurveIdOpacity(NULL)
@@ -280,8 +369,18 @@ CubismMotion::CubismMotion()
 
 CubismMotion::~CubismMotion()
 {
-    if(_motionData != NULL)
+    if (_bakedOutput != NULL)
+    {
+        CSM_FREE_ALLIGNED(_bakedOutput);
+    }
+
+    // 共有しているデータは最後のモーションが解放する
+    if(_motionData != NULL && --_motionData->ReferenceCount == 0)
     {
+        if (_motionData->BakedValues != NULL)
+        {
+            CSM_FREE_ALLIGNED(_motionData->BakedValues);
+        }
         CSM_DELETE(_motionData);
     }
 }
@@ -290,7 +389,14 @@ CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, Finis
 {
     CubismMotion* ret = CSM_NEW CubismMotion();
 
-    ret->Parse(buffer, size, shouldCheckMotionConsistency);
+    if (Utils::CubismBinary::IsBinary(buffer, size))
+    {
+        ret->ParseBinary(buffer, size);
+    }
+    else
+    {
+        ret->Parse(buffer, size, shouldCheckMotionConsistency);
+    }
     if(ret->_motionData)
     {
         ret->_sourceFrameRate = ret->_motionData->Fps;
@@ -310,6 +416,51 @@ CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, Finis
     return ret;
 }
 
+CubismMotion* CubismMotion::CreateShared(const CubismMotion* source)
+{
+    CubismMotion* ret = CSM_NEW CubismMotion();
+
+    ret->_motionData = source->_motionData;
+    ++ret->_motionData->ReferenceCount;
+
+    ret->_fadeInSeconds = source->_fadeInSeconds;
+    ret->_fadeOutSeconds = source->_fadeOutSeconds;
+    ret->_weight = source->_weight;
+    ret->_offsetSeconds = source->_offsetSeconds;
+    ret->_isLoop = source->_isLoop;
+    ret->_isLoopFadeIn = source->_isLoopFadeIn;
+    ret->_previousLoopState = source->_previousLoopState;
+    ret->_onBeganMotion = source->_onBeganMotion;
+    ret->_onBeganMotionCustomData = source->_onBeganMotionCustomData;
+    ret->_onFinishedMotion = source->_onFinishedMotion;
+    ret->_onFinishedMotionCustomData = source->_onFinishedMotionCustomData;
+
+    ret->_sourceFrameRate = source->_sourceFrameRate;
+    ret->_loopDurationSeconds = source->_loopDurationSeconds;
+    ret->_motionBehavior = source->_motionBehavior;
+    ret->_eyeBlinkParameterIds = source->_eyeBlinkParameterIds;
+    ret->_lipSyncParameterIds = source->_lipSyncParameterIds;
+
+    // ベイクした行は共有し、補間結果の出力先だけ個別に持つ
+    if (source->_bakedSampleCount > 0)
+    {
+        ret->_bakedOutput = static_cast<csmFloat32*>(CSM_MALLOC_ALLIGNED(sizeof(csmFloat32) * source->_bakedStride, BakedRowAlignment));
+        ret->_bakedStride = source->_bakedStride;
+        ret->_bakedSampleCount = source->_bakedSampleCount;
+        ret->_bakedInverseStep = source->_bakedInverseStep;
+        ret->_bakedDuration = source->_bakedDuration;
+        ret->_bakedIsCorrection = source->_bakedIsCorrection;
+        ret->_bakedMaxError = source->_bakedMaxError;
+    }
+
+    return ret;
+}
+
+csmBool CubismMotion::IsDataShared() const
+{
+    return _motionData != NULL && _motionData->ReferenceCount > 1;
+}
+
 csmFloat32 CubismMotion::GetDuration()
 {
     return _isLoop ? -1.0f : _loopDurationSeconds;
@@ -397,11 +548,30 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
 
+    if (model->GetModelId() != _parameterIndexModelId)
+    {
+        ResolveParameterIndices(model);
+    }
+
+    // カーブごとのセグメントカーソルはキューエントリごとに持つ（同じモーションが複数のエントリで再生されうるため）
+    csmVector<csmInt32>& segmentCursors = motionQueueEntry->_segmentCursors;
+    if (segmentCursors.GetSize() != static_cast<csmUint32>(_motionData->CurveCount))
+    {
+        segmentCursors.Resize(_motionData->CurveCount, -1);
+    }
+
+    // ベイク時と同じ条件で再生している場合のみテーブルから補間する
+    const csmFloat32* bakedValues = NULL;
+    if (_bakedSampleCount > 0 && isCorrection == _bakedIsCorrection && duration == _bakedDuration)
+    {
+        bakedValues = SampleBakedCurves(time);
+    }
+
     // Evaluate model curves.
     for (c = 0; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_Model; ++c)
     {
         // Evaluate curve and call handler.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = (bakedValues != NULL) ? bakedValues[c] : EvaluateCurve(_motionData, c, time, isCorrection, duration, &segmentCursors[c]);
 
         if (curves[c].Id == _modelCurveIdEyeBlink)
         {
@@ -427,7 +597,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         parameterMotionCurveCount++;
 
         // Find parameter index.
-        parameterIndex = model->GetParameterIndex(curves[c].Id);
+        parameterIndex = _curveParameterIndices[c];
 
         // Skip curve evaluation if no value in sink.
         if (parameterIndex == -1)
@@ -438,7 +608,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         const csmFloat32 sourceValue = model->GetParameterValue(parameterIndex);
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = (bakedValues != NULL) ? bakedValues[c] : EvaluateCurve(_motionData, c, time, isCorrection, duration, &segmentCursors[c]);
 
         if (eyeBlinkValue != FLT_MAX)
         {
@@ -521,7 +691,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         {
             for (csmUint32 i = 0; i < _eyeBlinkParameterIds.GetSize() && i < MaxTargetSize; ++i)
             {
-                const csmFloat32 sourceValue = model->GetParameterValue(_eyeBlinkParameterIds[i]);
+                const csmFloat32 sourceValue = model->GetParameterValue(_eyeBlinkParameterIndices[i]);
                 //モーションでの上書きがあった時にはまばたきは適用しない
                 if ((eyeBlinkFlags >> i) & 0x01)
                 {
@@ -530,7 +700,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
                 const csmFloat32 v = sourceValue + (eyeBlinkValue - sourceValue) * fadeWeight;
 
-                model->SetParameterValue(_eyeBlinkParameterIds[i], v);
+                model->SetParameterValue(_eyeBlinkParameterIndices[i], v);
             }
         }
 
@@ -538,7 +708,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         {
             for (csmUint32 i = 0; i < _lipSyncParameterIds.GetSize() && i < MaxTargetSize; ++i)
             {
-                const csmFloat32 sourceValue = model->GetParameterValue(_lipSyncParameterIds[i]);
+                const csmFloat32 sourceValue = model->GetParameterValue(_lipSyncParameterIndices[i]);
                 //モーションでの上書きがあった時にはリップシンクは適用しない
                 if ((lipSyncFlags >> i) & 0x01)
                 {
@@ -547,7 +717,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
                 const csmFloat32 v = sourceValue + (lipSyncValue - sourceValue) * fadeWeight;
 
-                model->SetParameterValue(_lipSyncParameterIds[i], v);
+                model->SetParameterValue(_lipSyncParameterIndices[i], v);
             }
         }
     }
@@ -555,7 +725,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
     for (; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_PartOpacity; ++c)
     {
         // Find parameter index.
-        parameterIndex = model->GetParameterIndex(curves[c].Id);
+        parameterIndex = _curveParameterIndices[c];
 
         // Skip curve evaluation if no value in sink.
         if (parameterIndex == -1)
@@ -564,7 +734,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         }
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = (bakedValues != NULL) ? bakedValues[c] : EvaluateCurve(_motionData, c, time, isCorrection, duration, &segmentCursors[c]);
 
         model->SetParameterValue(parameterIndex, value);
     }
@@ -818,6 +988,203 @@ void CubismMotion::Parse(const csmByte* motionJson, const csmSizeInt size, csmBo
     CSM_DELETE(json);
 }
 
+void CubismMotion::ParseBinary(const csmByte* buffer, const csmSizeInt size)
+{
+    using Utils::CubismBinary;
+
+    const CubismBinary::Header* header = CubismBinary::GetHeader(buffer, size, CubismBinary::Kind_Motion);
+    const CubismMotionBinaryBody* body = (header != NULL) ? CubismBinary::GetBody<CubismMotionBinaryBody>(header) : NULL;
+    if (body == NULL)
+    {
+        CubismLogError("Invalid binary motion.");
+        return;
+    }
+
+    const CubismMotionBinaryCurve* curves = CubismBinary::GetArray<CubismMotionBinaryCurve>(header, body->CurveOffset, body->CurveCount);
+    const CubismMotionBinarySegment* segments = CubismBinary::GetArray<CubismMotionBinarySegment>(header, body->SegmentOffset, body->SegmentCount);
+    const CubismMotionPoint* points = CubismBinary::GetArray<CubismMotionPoint>(header, body->PointOffset, body->PointCount);
+    const CubismMotionBinaryEvent* events = CubismBinary::GetArray<CubismMotionBinaryEvent>(header, body->EventOffset, body->EventCount);
+
+    if (curves == NULL || segments == NULL || points == NULL || events == NULL
+        || body->CurveCount < 0 || body->CurveCount > 0x7FFF
+        || body->SegmentCount < 0 || body->PointCount < 0 || body->EventCount < 0)
+    {
+        CubismLogError("Invalid binary motion.");
+        return;
+    }
+
+    // 範囲外を参照するデータは読み込まない
+    for (csmInt32 i = 0; i < body->CurveCount; ++i)
+    {
+        if (curves[i].Type < CubismMotionCurveTarget_Model || curves[i].Type > CubismMotionCurveTarget_PartOpacity
+            || curves[i].BaseSegmentIndex < 0 || curves[i].SegmentCount < 0
+            || curves[i].SegmentCount > body->SegmentCount - curves[i].BaseSegmentIndex
+            || CubismBinary::GetString(header, curves[i].IdOffset) == NULL)
+        {
+            CubismLogError("Invalid binary motion curve.");
+            return;
+        }
+    }
+    for (csmInt32 i = 0; i < body->SegmentCount; ++i)
+    {
+        const csmInt32 pointCount = (segments[i].SegmentType == CubismMotionSegmentType_Bezier) ? 4 : 2;
+        if (segments[i].SegmentType < CubismMotionSegmentType_Linear || segments[i].SegmentType > CubismMotionSegmentType_InverseStepped
+            || segments[i].BasePointIndex < 0 || segments[i].BasePointIndex > body->PointCount - pointCount)
+        {
+            CubismLogError("Invalid binary motion segment.");
+            return;
+        }
+    }
+    for (csmInt32 i = 0; i < body->EventCount; ++i)
+    {
+        if (CubismBinary::GetString(header, events[i].ValueOffset) == NULL)
+        {
+            CubismLogError("Invalid binary motion event.");
+            return;
+        }
+    }
+
+    _motionData = CSM_NEW CubismMotionData;
+
+    _motionData->Duration = body->Duration;
+    _motionData->Loop = static_cast<csmInt16>(body->Loop);
+    _motionData->CurveCount = static_cast<csmInt16>(body->CurveCount);
+    _motionData->Fps = body->Fps;
+    _motionData->EventCount = body->EventCount;
+
+    _fadeInSeconds = body->FadeInTime;
+    _fadeOutSeconds = body->FadeOutTime;
+
+    _motionData->Curves.UpdateSize(body->CurveCount, CubismMotionCurve(), true);
+    _motionData->Segments.UpdateSize(body->SegmentCount, CubismMotionSegment(), true);
+    _motionData->Points.UpdateSize(body->PointCount, CubismMotionPoint(), true);
+    _motionData->Events.UpdateSize(body->EventCount, CubismMotionEvent(), true);
+
+    for (csmInt32 i = 0; i < body->CurveCount; ++i)
+    {
+        CubismMotionCurve& curve = _motionData->Curves[i];
+
+        curve.Type = static_cast<CubismMotionCurveTarget>(curves[i].Type);
+        curve.Id = CubismFramework::GetIdManager()->GetId(CubismBinary::GetString(header, curves[i].IdOffset));
+        curve.SegmentCount = curves[i].SegmentCount;
+        curve.BaseSegmentIndex = curves[i].BaseSegmentIndex;
+        curve.FadeInTime = curves[i].FadeInTime;
+        curve.FadeOutTime = curves[i].FadeOutTime;
+    }
+
+    for (csmInt32 i = 0; i < body->SegmentCount; ++i)
+    {
+        CubismMotionSegment& segment = _motionData->Segments[i];
+
+        segment.BasePointIndex = segments[i].BasePointIndex;
+        segment.SegmentType = segments[i].SegmentType;
+
+        switch (segment.SegmentType)
+        {
+        case CubismMotionSegmentType_Linear:
+            segment.Evaluate = LinearEvaluate;
+            break;
+        case CubismMotionSegmentType_Bezier:
+            segment.Evaluate = (body->AreBeziersRestricted || UseOldBeziersCurveMotion)
+                ? BezierEvaluate
+                : BezierEvaluateCardanoInterpretation;
+            break;
+        case CubismMotionSegmentType_Stepped:
+            segment.Evaluate = SteppedEvaluate;
+            break;
+        case CubismMotionSegmentType_InverseStepped:
+        default:
+            segment.Evaluate = InverseSteppedEvaluate;
+            break;
+        }
+    }
+
+    // 制御点は実行時と同じレイアウトなのでそのままコピーする
+    if (body->PointCount > 0)
+    {
+        memcpy(_motionData->Points.GetPtr(), points, sizeof(CubismMotionPoint) * body->PointCount);
+    }
+
+    for (csmInt32 i = 0; i < body->EventCount; ++i)
+    {
+        _motionData->Events[i].FireTime = events[i].FireTime;
+        _motionData->Events[i].Value = CubismBinary::GetString(header, events[i].ValueOffset);
+    }
+}
+
+void CubismMotion::ExportBinary(csmVector<csmByte>& buffer) const
+{
+    using Utils::CubismBinary;
+    using Utils::CubismBinaryWriter;
+
+    CubismMotionBinaryBody body;
+    memset(&body, 0, sizeof(body));
+
+    body.Duration = _motionData->Duration;
+    body.Fps = _motionData->Fps;
+    body.FadeInTime = _fadeInSeconds;
+    body.FadeOutTime = _fadeOutSeconds;
+    body.Loop = _motionData->Loop;
+    body.CurveCount = _motionData->CurveCount;
+    body.SegmentCount = _motionData->Segments.GetSize();
+    body.PointCount = _motionData->Points.GetSize();
+    body.EventCount = _motionData->EventCount;
+
+    CubismBinaryWriter writer(CubismBinary::Kind_Motion, sizeof(body));
+
+    csmVector<CubismMotionBinaryCurve> curves(body.CurveCount > 0 ? body.CurveCount : 1);
+    for (csmInt32 i = 0; i < body.CurveCount; ++i)
+    {
+        const CubismMotionCurve& curve = _motionData->Curves[i];
+        CubismMotionBinaryCurve item;
+
+        item.Type = curve.Type;
+        item.IdOffset = writer.AddString(curve.Id->GetString().GetRawString());
+        item.SegmentCount = curve.SegmentCount;
+        item.BaseSegmentIndex = curve.BaseSegmentIndex;
+        item.FadeInTime = curve.FadeInTime;
+        item.FadeOutTime = curve.FadeOutTime;
+
+        curves.PushBack(item);
+    }
+
+    csmVector<CubismMotionBinarySegment> segments(body.SegmentCount > 0 ? body.SegmentCount : 1);
+    for (csmInt32 i = 0; i < body.SegmentCount; ++i)
+    {
+        const CubismMotionSegment& segment = _motionData->Segments[i];
+        CubismMotionBinarySegment item;
+
+        item.BasePointIndex = segment.BasePointIndex;
+        item.SegmentType = segment.SegmentType;
+
+        // ベジェの評価方法はモーション単位で決まるため、評価関数から制限の有無を復元する
+        if (segment.SegmentType == CubismMotionSegmentType_Bezier && segment.Evaluate == BezierEvaluate)
+        {
+            body.AreBeziersRestricted = 1;
+        }
+
+        segments.PushBack(item);
+    }
+
+    csmVector<CubismMotionBinaryEvent> events(body.EventCount > 0 ? body.EventCount : 1);
+    for (csmInt32 i = 0; i < body.EventCount; ++i)
+    {
+        CubismMotionBinaryEvent item;
+
+        item.FireTime = _motionData->Events[i].FireTime;
+        item.ValueOffset = writer.AddString(_motionData->Events[i].Value.GetRawString());
+
+        events.PushBack(item);
+    }
+
+    body.CurveOffset = writer.AddArray(curves.GetPtr(), sizeof(CubismMotionBinaryCurve) * curves.GetSize());
+    body.SegmentOffset = writer.AddArray(segments.GetPtr(), sizeof(CubismMotionBinarySegment) * segments.GetSize());
+    body.PointOffset = writer.AddArray(_motionData->Points.GetPtr(), sizeof(CubismMotionPoint) * _motionData->Points.GetSize());
+    body.EventOffset = writer.AddArray(events.GetPtr(), sizeof(CubismMotionBinaryEvent) * events.GetSize());
+
+    writer.Finish(&body, buffer);
+}
+
 void CubismMotion::SetParameterFadeInTime(CubismIdHandle parameterId, csmFloat32 value)
 {
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
@@ -923,6 +1290,36 @@ void CubismMotion::SetEffectIds(const csmVector<CubismIdHandle>& eyeBlinkParamet
 {
     _eyeBlinkParameterIds = eyeBlinkParameterIds;
     _lipSyncParameterIds = lipSyncParameterIds;
+
+    // 次回の更新時にインデックスを引き直す
+    _parameterIndexModelId = 0;
+}
+
+void CubismMotion::ResolveParameterIndices(CubismModel* model)
+{
+    const csmVector<CubismMotionCurve>& curves = _motionData->Curves;
+
+    _curveParameterIndices.Resize(_motionData->CurveCount, -1);
+    for (csmInt32 c = 0; c < _motionData->CurveCount; ++c)
+    {
+        _curveParameterIndices[c] = (curves[c].Type == CubismMotionCurveTarget_Model)
+            ? -1
+            : model->GetParameterIndex(curves[c].Id);
+    }
+
+    _eyeBlinkParameterIndices.Resize(_eyeBlinkParameterIds.GetSize(), -1);
+    for (csmUint32 i = 0; i < _eyeBlinkParameterIds.GetSize(); ++i)
+    {
+        _eyeBlinkParameterIndices[i] = model->GetParameterIndex(_eyeBlinkParameterIds[i]);
+    }
+
+    _lipSyncParameterIndices.Resize(_lipSyncParameterIds.GetSize(), -1);
+    for (csmUint32 i = 0; i < _lipSyncParameterIds.GetSize(); ++i)
+    {
+        _lipSyncParameterIndices[i] = model->GetParameterIndex(_lipSyncParameterIds[i]);
+    }
+
+    _parameterIndexModelId = model->GetModelId();
 }
 
 const csmVector<const csmString*>& CubismMotion::GetFiredEvent(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
@@ -1007,4 +1404,180 @@ csmFloat32 CubismMotion::GetModelOpacityValue() const
     return _modelOpacity;
 }
 
+void CubismMotion::Bake(csmFloat32 sampleRate)
+{
+    // 他のモーションが再生中の行を差し替えないよう、共有中はベイクし直さない
+    if (IsDataShared())
+    {
+        CubismLogWarning("Cannot bake a motion whose data is shared.");
+        return;
+    }
+
+    ReleaseBakedCurves();
+
+    if (sampleRate <= 0.0f || _motionData == NULL || _motionData->CurveCount <= 0)
+    {
+        return;
+    }
+
+    // DoUpdateParameters と同じ条件で時間の範囲と補正の有無を決める
+    csmFloat32 duration = _motionData->Duration;
+    const csmBool isCorrection = _motionBehavior == MotionBehavior_V2 && _isLoop;
+    if (_isLoop && _motionBehavior == MotionBehavior_V2)
+    {
+        duration += 1.0f / _motionData->Fps;
+    }
+
+    const csmInt32 curveCount = _motionData->CurveCount;
+    const csmInt32 stride = (curveCount + 3) & ~3;
+    const csmInt32 sampleCount = static_cast<csmInt32>(ceilf(duration * sampleRate)) + 1;
+    const csmFloat32 step = (sampleCount > 1) ? duration / (sampleCount - 1) : 0.0f;
+
+    const csmSizeType bytes = sizeof(csmFloat32) * stride * sampleCount;
+    csmFloat32* values = static_cast<csmFloat32*>(CSM_MALLOC_ALLIGNED(bytes, BakedRowAlignment));
+    memset(values, 0, bytes);
+
+    csmFloat32 maxError = 0.0f;
+
+    for (csmInt32 c = 0; c < curveCount; ++c)
+    {
+        csmInt32 segmentCursor = -1;
+        csmFloat32 previous = 0.0f;
+
+        for (csmInt32 k = 0; k < sampleCount; ++k)
+        {
+            const csmFloat32 time = (k == sampleCount - 1) ? duration : step * k;
+
+            // 区間の中点で線形補間との誤差を測る
+            if (k > 0)
+            {
+                const csmFloat32 middle = EvaluateCurve(_motionData, c, time - step * 0.5f, isCorrection, duration, &segmentCursor);
+                const csmFloat32 next = EvaluateCurve(_motionData, c, time, isCorrection, duration, &segmentCursor);
+                const csmFloat32 error = CubismMath::AbsF(middle - (previous + next) * 0.5f);
+
+                if (error > maxError)
+                {
+                    maxError = error;
+                }
+
+                previous = next;
+            }
+            else
+            {
+                previous = EvaluateCurve(_motionData, c, time, isCorrection, duration, &segmentCursor);
+            }
+
+            values[stride * k + c] = previous;
+        }
+    }
+
+    _motionData->BakedValues = values;
+    _bakedOutput = static_cast<csmFloat32*>(CSM_MALLOC_ALLIGNED(sizeof(csmFloat32) * stride, BakedRowAlignment));
+    _bakedStride = stride;
+    _bakedSampleCount = sampleCount;
+    _bakedInverseStep = (step > 0.0f) ? 1.0f / step : 0.0f;
+    _bakedDuration = duration;
+    _bakedIsCorrection = isCorrection;
+    _bakedMaxError = maxError;
+}
+
+csmBool CubismMotion::IsBaked() const
+{
+    return _bakedSampleCount > 0;
+}
+
+csmFloat32 CubismMotion::GetBakedMaxError() const
+{
+    return _bakedMaxError;
+}
+
+csmSizeInt CubismMotion::GetMemoryBytes() const
+{
+    csmSizeInt bytes = sizeof(CubismMotion);
+
+    if (_motionData != NULL)
+    {
+        bytes += sizeof(CubismMotionData);
+        bytes += _motionData->Curves.GetSize() * sizeof(CubismMotionCurve);
+        bytes += _motionData->Segments.GetSize() * sizeof(CubismMotionSegment);
+        bytes += _motionData->Points.GetSize() * sizeof(CubismMotionPoint);
+        bytes += _motionData->Events.GetSize() * sizeof(CubismMotionEvent);
+    }
+
+    bytes += (_eyeBlinkParameterIds.GetSize() + _lipSyncParameterIds.GetSize()) * sizeof(CubismIdHandle);
+    bytes += (_curveParameterIndices.GetSize() + _eyeBlinkParameterIndices.GetSize() + _lipSyncParameterIndices.GetSize()) * sizeof(csmInt32);
+
+    if (_bakedSampleCount > 0)
+    {
+        // 出力先の 1 行を含む
+        bytes += sizeof(csmFloat32) * _bakedStride * (_bakedSampleCount + 1);
+    }
+
+    return bytes;
+}
+
+const csmFloat32* CubismMotion::SampleBakedCurves(csmFloat32 time)
+{
+    const csmFloat32* bakedValues = _motionData->BakedValues;
+    csmFloat32* output = _bakedOutput;
+
+    const csmFloat32 position = time * _bakedInverseStep;
+    csmInt32 row = static_cast<csmInt32>(position);
+
+    // 範囲外は端の行をそのまま使う
+    if (position <= 0.0f || _bakedSampleCount == 1)
+    {
+        memcpy(output, bakedValues, sizeof(csmFloat32) * _bakedStride);
+        return output;
+    }
+    if (row >= _bakedSampleCount - 1)
+    {
+        memcpy(output, bakedValues + _bakedStride * (_bakedSampleCount - 1), sizeof(csmFloat32) * _bakedStride);
+        return output;
+    }
+
+    const csmFloat32 weight = position - static_cast<csmFloat32>(row);
+    const csmFloat32* from = bakedValues + _bakedStride * row;
+    const csmFloat32* to = from + _bakedStride;
+
+#ifdef CSM_MOTION_BAKE_SSE
+    const __m128 w = _mm_set1_ps(weight);
+    for (csmInt32 i = 0; i < _bakedStride; i += 4)
+    {
+        const __m128 a = _mm_load_ps(from + i);
+        const __m128 b = _mm_load_ps(to + i);
+        _mm_store_ps(output + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), w)));
+    }
+#else
+    for (csmInt32 i = 0; i < _bakedStride; ++i)
+    {
+        output[i] = from[i] + (to[i] - from[i]) * weight;
+    }
+#endif
+
+    return output;
+}
+
+void CubismMotion::ReleaseBakedCurves()
+{
+    // 共有中の行は他のモーションが使っているので、このモーションからの参照だけやめる
+    if (_motionData != NULL && _motionData->BakedValues != NULL && !IsDataShared())
+    {
+        CSM_FREE_ALLIGNED(_motionData->BakedValues);
+        _motionData->BakedValues = NULL;
+    }
+    if (_bakedOutput != NULL)
+    {
+        CSM_FREE_ALLIGNED(_bakedOutput);
+        _bakedOutput = NULL;
+    }
+
+    _bakedStride = 0;
+    _bakedSampleCount = 0;
+    _bakedInverseStep = 0.0f;
+    _bakedDuration = 0.0f;
+    _bakedIsCorrection = false;
+    _bakedMaxError = 0.0f;
+}
+
 }}}
@@ -36,6 +36,9 @@ public:
     /**
      * Makes an instance.
      *
+     * The buffer may hold either a motion3.json or the CubismBinary form written by ExportBinary;
+     * the format is detected from the first bytes.
+     *
      * @param buf buffer containing the loaded motion file
      * @param size size of the buffer in bytes
      * @param onFinishedMotionHandler callback function for when motion playback ends
@@ -46,6 +49,35 @@ public:
      */
     static CubismMotion* Create(const csmByte* buffer, csmSizeInt size, FinishedMotionCallback onFinishedMotionHandler = NULL, BeganMotionCallback onBeganMotionHandler = NULL, csmBool shouldCheckMotionConsistency = false);
 
+    /**
+     * Makes an instance that shares the curves and baked tables of another motion.
+     *
+     * The fade, loop and effect settings and the callbacks are copied. Playback state
+     * (parameter indices, the interpolated row, the last weight) is kept per instance,
+     * so the motions can be updated on different models and threads at the same time.
+     * The shared data is reference-counted and released with the last motion using it.
+     * Bake cannot be called on a motion whose data is shared.
+     *
+     * @param source motion to share the data with
+     *
+     * @return created instance
+     */
+    static CubismMotion* CreateShared(const CubismMotion* source);
+
+    /**
+     * Checks whether the curves are used by other motions made with CreateShared.
+     *
+     * @return true if another motion shares the data; otherwise false.
+     */
+    csmBool IsDataShared() const;
+
+    /**
+     * Writes the motion in the CubismBinary format.
+     *
+     * @param buffer receives the file contents
+     */
+    void ExportBinary(csmVector<csmByte>& buffer) const;
+
     /**
      * Updates the model parameters.
      *
@@ -204,6 +236,43 @@ public:
      */
     CubismIdHandle GetModelOpacityId(csmInt32 index);
 
+    /**
+     * Bakes all curves into tables sampled at a fixed rate.
+     *
+     * While the tables exist, a frame is evaluated by linearly interpolating between two
+     * sample rows for all curves at once, instead of evaluating each curve's segments.
+     * The tables are built for the current loop and motion behavior settings; if these
+     * are changed afterwards, evaluation falls back to the curves until Bake is called again.
+     * Ignored while the data is shared with other motions.
+     *
+     * @param sampleRate samples per second. 0 or less releases the tables.
+     */
+    void Bake(csmFloat32 sampleRate);
+
+    /**
+     * Checks whether the motion is evaluated from baked tables.
+     *
+     * @return true if the tables exist; otherwise false.
+     */
+    csmBool IsBaked() const;
+
+    /**
+     * Returns the largest difference between the baked and the analytic value,
+     * measured at the midpoint of every sample interval of every curve when baking.
+     *
+     * @return maximum absolute error, or 0 when not baked
+     */
+    csmFloat32 GetBakedMaxError() const;
+
+    /**
+     * Returns the approximate heap size of the motion: the curve, segment, point and
+     * event arrays, the parameter index tables and the baked tables.
+     * Data shared with other motions is included.
+     *
+     * @return size in bytes
+     */
+    csmSizeInt GetMemoryBytes() const;
+
 protected:
     csmFloat32 GetModelOpacityValue() const;
 
@@ -219,6 +288,41 @@ private:
 
     void Parse(const csmByte* motionJson, const csmSizeInt size, csmBool shouldCheckMotionConsistency);
 
+    /**
+     * Reads a motion in the CubismBinary format.
+     *
+     * Leaves _motionData NULL when the data is invalid.
+     *
+     * @param buffer file contents
+     * @param size size of the buffer in bytes
+     */
+    void ParseBinary(const csmByte* buffer, const csmSizeInt size);
+
+    /**
+     * Resolves the parameter indices of the curves and effect targets for the model.
+     *
+     * A motion can be shared by several models, so the indices are kept for the last model
+     * the motion was applied to and resolved again when it changes.
+     *
+     * @param model target model
+     */
+    void ResolveParameterIndices(CubismModel* model);
+
+    /**
+     * Interpolates the baked rows around the time into the output row.
+     *
+     * @param time playback time in seconds
+     *
+     * @return value of each curve, indexed by curve
+     */
+    const csmFloat32* SampleBakedCurves(csmFloat32 time);
+
+    /**
+     * Releases the baked tables.
+     * Tables shared with other motions are kept for them; only this motion stops using them.
+     */
+    void ReleaseBakedCurves();
+
     csmFloat32      _sourceFrameRate;
     csmFloat32      _loopDurationSeconds;
     MotionBehavior  _motionBehavior;
@@ -229,6 +333,19 @@ private:
     csmVector<CubismIdHandle>  _eyeBlinkParameterIds;
     csmVector<CubismIdHandle>  _lipSyncParameterIds;
 
+    csmUint32                  _parameterIndexModelId; ///< Model (GetModelId) the indices below were resolved for, 0 if unresolved
+    csmVector<csmInt32>        _curveParameterIndices;        ///< Parameter index of each curve (-1 for model curves)
+    csmVector<csmInt32>        _eyeBlinkParameterIndices;     ///< Parameter indices of _eyeBlinkParameterIds
+    csmVector<csmInt32>        _lipSyncParameterIndices;      ///< Parameter indices of _lipSyncParameterIds
+
+    csmFloat32*     _bakedOutput;           ///< Interpolated row written by SampleBakedCurves (the rows are in _motionData)
+    csmInt32        _bakedStride;           ///< Floats per row, a multiple of 4
+    csmInt32        _bakedSampleCount;      ///< Number of baked rows, 0 if not baked
+    csmFloat32      _bakedInverseStep;      ///< Rows per second
+    csmFloat32      _bakedDuration;         ///< Duration the rows cover [seconds]
+    csmBool         _bakedIsCorrection;     ///< Whether the end-to-start correction was applied when baking
+    csmFloat32      _bakedMaxError;         ///< See GetBakedMaxError
+
     CubismIdHandle _modelCurveIdEyeBlink;
     CubismIdHandle _modelCurveIdLipSync;
     CubismIdHandle _modelCurveIdOpacity;
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "CubismFramework.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
@@ -130,6 +131,8 @@ struct CubismMotionData
         , CurveCount(0)
         , EventCount(0)
         , Fps(0.0f)
+        , BakedValues(NULL)
+        , ReferenceCount(1)
     { }
 
     csmFloat32 Duration;                            ///< Motion length [seconds]
@@ -141,6 +144,62 @@ struct CubismMotionData
     csmVector<CubismMotionSegment> Segments;        ///< Segment collection
     csmVector<CubismMotionPoint> Points;            ///< Control point collection
     csmVector<CubismMotionEvent> Events;            ///< User data event collection
+    csmFloat32* BakedValues;                        ///< Baked rows (one value per curve, padded to the stride), NULL if not baked
+    std::atomic<csmInt32> ReferenceCount;           ///< Number of motions using this data (see CubismMotion::CreateShared)
+};
+
+/**
+ * Body of a motion in the CubismBinary format
+ *
+ * Points are stored as an array of CubismMotionPoint.
+ */
+struct CubismMotionBinaryBody
+{
+    csmFloat32 Duration;                ///< Motion length [seconds]
+    csmFloat32 Fps;                     ///< Motion frame rate
+    csmFloat32 FadeInTime;              ///< Fade-in time of the motion [seconds]
+    csmFloat32 FadeOutTime;             ///< Fade-out time of the motion [seconds]
+    csmInt32 Loop;                      ///< Whether to loop
+    csmInt32 AreBeziersRestricted;      ///< Whether Bezier handles are restricted to the segment
+    csmInt32 CurveCount;                ///< Number of curves
+    csmInt32 SegmentCount;              ///< Number of segments
+    csmInt32 PointCount;                ///< Number of control points
+    csmInt32 EventCount;                ///< Number of user data events
+    csmUint32 CurveOffset;              ///< Offset of the CubismMotionBinaryCurve array
+    csmUint32 SegmentOffset;            ///< Offset of the CubismMotionBinarySegment array
+    csmUint32 PointOffset;              ///< Offset of the CubismMotionPoint array
+    csmUint32 EventOffset;              ///< Offset of the CubismMotionBinaryEvent array
+};
+
+/**
+ * Curve in the CubismBinary format
+ */
+struct CubismMotionBinaryCurve
+{
+    csmInt32 Type;                      ///< CubismMotionCurveTarget
+    csmUint32 IdOffset;                 ///< String table offset of the ID
+    csmInt32 SegmentCount;              ///< Number of segments
+    csmInt32 BaseSegmentIndex;          ///< Index of the first segment
+    csmFloat32 FadeInTime;              ///< Fade-in time, -1 if not set
+    csmFloat32 FadeOutTime;             ///< Fade-out time, -1 if not set
+};
+
+/**
+ * Segment in the CubismBinary format
+ */
+struct CubismMotionBinarySegment
+{
+    csmInt32 BasePointIndex;            ///< Index of the first control point
+    csmInt32 SegmentType;               ///< CubismMotionSegmentType
+};
+
+/**
+ * User data event in the CubismBinary format
+ */
+struct CubismMotionBinaryEvent
+{
+    csmFloat32 FireTime;                ///< Seconds in motion when the event fires
+    csmUint32 ValueOffset;              ///< String table offset of the value
 };
 
 }}}
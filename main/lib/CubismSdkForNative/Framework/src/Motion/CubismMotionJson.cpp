@@ -64,7 +64,7 @@ csmBool CubismMotionJson::HasConsistency() const
         return false;
     }
 
-    const csmInt32 actualCurveListSize = static_cast<csmInt32>(_json->GetRoot()[Curves].GetVector()->GetSize());
+    const csmInt32 actualCurveListSize = static_cast<csmInt32>(_json->GetRoot()[Curves].GetSize());
     csmInt32 actualTotalSegmentCount = 0;
     csmInt32 actualTotalPointCount = 0;
 
@@ -210,7 +210,7 @@ csmFloat32 CubismMotionJson::GetMotionCurveFadeOutTime(csmInt32 curveIndex) cons
 
 csmInt32 CubismMotionJson::GetMotionCurveSegmentCount(csmInt32 curveIndex) const
 {
-    return static_cast<csmInt32>(_json->GetRoot()[Curves][curveIndex][Segments].GetVector()->GetSize());
+    return static_cast<csmInt32>(_json->GetRoot()[Curves][curveIndex][Segments].GetSize());
 }
 
 csmFloat32 CubismMotionJson::GetMotionCurveSegment(csmInt32 curveIndex, csmInt32 segmentIndex) const
@@ -7,9 +7,35 @@
 
 #include "CubismMotionQueueEntry.hpp"
 #include "CubismFramework.hpp"
+#include <atomic>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
+namespace {
+
+/**
+ * @brief   エントリのハンドルを発行する
+ *
+ * エントリはCubismMotionQueueManagerで再利用されるため、アドレスをハンドルにすると
+ * 終了したモーションのハンドルが同じエントリで再生中の別のモーションを指してしまう。
+ * 再生のたびにプロセス内で一意な値を発行し、古いハンドルが一致しないようにする。
+ * NULLとInvalidMotionQueueEntryHandleValueは発行しない。
+ */
+CubismMotionQueueEntryHandle IssueHandle()
+{
+    static std::atomic<csmSizeType> nextHandle(1);
+
+    csmSizeType value;
+    do
+    {
+        value = nextHandle.fetch_add(1, std::memory_order_relaxed);
+    } while (value == 0 || value == static_cast<csmSizeType>(-1));
+
+    return reinterpret_cast<CubismMotionQueueEntryHandle>(value);
+}
+
+}
+
 CubismMotionQueueEntry::CubismMotionQueueEntry()
     : _autoDelete(false)
     , _motion(NULL)
@@ -26,7 +52,7 @@ CubismMotionQueueEntry::CubismMotionQueueEntry()
     , _fadeOutSeconds(0.0f)
     , _IsTriggeredFadeOut(false)
 {
-    this->_motionQueueEntryHandle = this;
+    this->_motionQueueEntryHandle = IssueHandle();
 }
 
 CubismMotionQueueEntry::~CubismMotionQueueEntry()
@@ -37,6 +63,30 @@ CubismMotionQueueEntry::~CubismMotionQueueEntry()
     }
 }
 
+void CubismMotionQueueEntry::Reset()
+{
+    if (_autoDelete && _motion)
+    {
+        ACubismMotion::Delete(_motion);
+    }
+
+    _autoDelete = false;
+    _motion = NULL;
+    _available = true;
+    _finished = false;
+    _started = false;
+    _startTimeSeconds = -1.0f;
+    _fadeInStartTimeSeconds = 0.0f;
+    _endTimeSeconds = -1.0f;
+    _stateTimeSeconds = 0.0f;
+    _stateWeight = 0.0f;
+    _lastEventCheckSeconds = 0.0f;
+    _fadeOutSeconds = 0.0f;
+    _IsTriggeredFadeOut = false;
+    _segmentCursors.Resize(0);
+    _motionQueueEntryHandle = IssueHandle(); // 返却前のハンドルでは見つからなくなる
+}
+
 void CubismMotionQueueEntry::SetFadeout(csmFloat32 fadeOutSeconds)
 {
     _fadeOutSeconds = fadeOutSeconds;
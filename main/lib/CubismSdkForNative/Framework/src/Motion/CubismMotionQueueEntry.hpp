@@ -187,6 +187,13 @@ public:
     ACubismMotion* GetCubismMotion();
 
 private:
+    /**
+     * Returns the entry to its initial state so that CubismMotionQueueManager can reuse it.<br>
+     * The motion is deleted if it was started with autoDelete. The capacity of the segment cursors is kept.<br>
+     * A new handle is issued, so handles returned for the previous motion no longer match this entry.
+     */
+    void            Reset();
+
     csmBool         _autoDelete;
     ACubismMotion*  _motion;
 
@@ -202,7 +209,9 @@ private:
     csmFloat32      _fadeOutSeconds;
     csmBool         _IsTriggeredFadeOut;
 
-    CubismMotionQueueEntryHandle  _motionQueueEntryHandle;
+    csmVector<csmInt32> _segmentCursors;    ///< Last evaluated segment of each curve, used by CubismMotion
+
+    CubismMotionQueueEntryHandle  _motionQueueEntryHandle;    ///< Process-unique value reissued on every reuse (not the entry address)
 };
 
 }}}
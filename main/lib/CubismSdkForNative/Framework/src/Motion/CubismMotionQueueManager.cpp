@@ -14,6 +14,15 @@ namespace Live2D { namespace Cubism { namespace Framework {
 
 const CubismMotionQueueEntryHandle InvalidMotionQueueEntryHandleValue = reinterpret_cast<CubismMotionQueueEntryHandle*>(-1);
 
+namespace {
+
+/**
+ * @brief   再利用のために保持する終了済みエントリの最大数
+ */
+const csmUint32 EntryPoolLimit = 8;
+
+}
+
 CubismMotionQueueManager::CubismMotionQueueManager()
     : _userTimeSeconds(0.0f)
     , _eventCallback(NULL)
@@ -29,6 +38,11 @@ CubismMotionQueueManager::~CubismMotionQueueManager()
             CSM_DELETE(_motions[i]);
         }
     }
+
+    for (csmUint32 i = 0; i < _entryPool.GetSize(); ++i)
+    {
+        CSM_DELETE(_entryPool[i]);
+    }
 }
 
 CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion* motion, csmBool autoDelete)
@@ -52,7 +66,7 @@ CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion
         motionQueueEntry->SetFadeout(motionQueueEntry->_motion->GetFadeOutTime());
     }
 
-    motionQueueEntry = CSM_NEW CubismMotionQueueEntry(); // 終了時に破棄する
+    motionQueueEntry = AcquireEntry(); // 終了時に ReleaseEntry で返却する
     motionQueueEntry->_autoDelete = autoDelete;
     motionQueueEntry->_motion = motion;
 
@@ -84,7 +98,7 @@ CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion
         motionQueueEntry->SetFadeout(motionQueueEntry->_motion->GetFadeOutTime());
     }
 
-    motionQueueEntry = CSM_NEW CubismMotionQueueEntry(); // 終了時に破棄する
+    motionQueueEntry = AcquireEntry(); // 終了時に ReleaseEntry で返却する
     motionQueueEntry->_autoDelete = autoDelete;
     motionQueueEntry->_motion = motion;
 
@@ -114,7 +128,7 @@ csmBool CubismMotionQueueManager::DoUpdateMotion(CubismModel* model, csmFloat32
 
         if (motion == NULL)
         {
-            CSM_DELETE(motionQueueEntry);
+            ReleaseEntry(motionQueueEntry);
             ite = _motions.Erase(ite);          // 削除
 
             continue;
@@ -140,7 +154,7 @@ csmBool CubismMotionQueueManager::DoUpdateMotion(CubismModel* model, csmFloat32
         // ----- 終了済みの処理があれば削除する ------
         if (motionQueueEntry->IsFinished())
         {
-            CSM_DELETE(motionQueueEntry);
+            ReleaseEntry(motionQueueEntry);
             ite = _motions.Erase(ite);          // 削除
         }
         else
@@ -204,7 +218,7 @@ csmBool CubismMotionQueueManager::IsFinished()
 
         if (motion == NULL)
         {
-            CSM_DELETE(motionQueueEntry);
+            ReleaseEntry(motionQueueEntry);
             ite = _motions.Erase(ite);          // 削除
             continue;
         }
@@ -262,11 +276,37 @@ void CubismMotionQueueManager::StopAllMotions()
         }
 
         // ----- 終了済みの処理があれば削除する ------
-        CSM_DELETE(motionQueueEntry);
+        ReleaseEntry(motionQueueEntry);
         ite = _motions.Erase(ite); //削除
     }
 }
 
+CubismMotionQueueEntry* CubismMotionQueueManager::AcquireEntry()
+{
+    if (_entryPool.GetSize() == 0)
+    {
+        return CSM_NEW CubismMotionQueueEntry();
+    }
+
+    CubismMotionQueueEntry* motionQueueEntry = _entryPool[_entryPool.GetSize() - 1];
+    _entryPool.Remove(_entryPool.GetSize() - 1);
+
+    return motionQueueEntry;
+}
+
+void CubismMotionQueueManager::ReleaseEntry(CubismMotionQueueEntry* motionQueueEntry)
+{
+    if (_entryPool.GetSize() >= EntryPoolLimit)
+    {
+        CSM_DELETE(motionQueueEntry);
+        return;
+    }
+
+    // 返却時に初期状態へ戻す（autoDelete のモーションはここで破棄される）
+    motionQueueEntry->Reset();
+    _entryPool.PushBack(motionQueueEntry, false);
+}
+
 void CubismMotionQueueManager::SetEventCallback(CubismMotionEventFunction callback, void* customData)
 {
     _eventCallback   = callback;
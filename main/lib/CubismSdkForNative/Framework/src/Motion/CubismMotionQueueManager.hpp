@@ -125,11 +125,27 @@ public:
 protected:
     virtual csmBool     DoUpdateMotion(CubismModel* model, csmFloat32 userTimeSeconds);
 
+    /**
+     * Takes a queue entry from the pool of finished entries, or creates one if the pool is empty.
+     *
+     * @return queue entry in its initial state
+     */
+    CubismMotionQueueEntry* AcquireEntry();
+
+    /**
+     * Finishes a queue entry and keeps it for reuse by AcquireEntry().<br>
+     * The motion is deleted if it was started with autoDelete.
+     *
+     * @param motionQueueEntry queue entry removed from the queue
+     */
+    void                    ReleaseEntry(CubismMotionQueueEntry* motionQueueEntry);
+
 
     csmFloat32 _userTimeSeconds;
 
 private:
     csmVector<CubismMotionQueueEntry*>      _motions;
+    csmVector<CubismMotionQueueEntry*>      _entryPool;     ///< Finished entries kept so that restarting a motion does not allocate
 
     CubismMotionEventFunction         _eventCallback;
     void*                             _eventCustomData;
@@ -12,6 +12,13 @@
 #include "Utils/CubismString.hpp"
 #include "Math/CubismMath.hpp"
 #include "Math/CubismVector2.hpp"
+#include "Utils/CubismBinary.hpp"
+#include "Id/CubismIdManager.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CSM_PHYSICS_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -264,80 +271,161 @@ csmFloat32 GetOutputScaleAngle(CubismVector2 translationScale, csmFloat32 angleS
     return angleScale;
 }
 
-/// Updates particles.
+#ifdef CSM_PHYSICS_SSE
+/// Selects lanes of a where mask is set, otherwise lanes of b.
+inline __m128 SelectLanes(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+/// Updates particles of a batch.
+///
+/// Each lane is one strand, and the lanes are updated together particle by particle.
+/// The result is the same as updating the strands one by one, except that the direction is
+/// normalized with a square root instead of powf(x, 0.5f) (they differ by at most 1 ulp).
+/// The gravity and the rotation caused by its change are shared by all particles of a strand,
+/// so the caller computes them once per lane and sets them to the batch.
 ///
-/// @param  strand            Target array of particle.
-/// @param  strandCount       Count of particle.
-/// @param  totalTranslation  Total translation value.
-/// @param  totalAngle        Total angle.
-/// @param  windDirection              Direction of wind.
-/// @param  thresholdValue    Threshold of movement.
+/// @param  lanes             Particles of the batch.
+/// @param  batch             Target batch.
+/// @param  windDirection     Direction of wind.
 /// @param  deltaTimeSeconds  Delta time.
-/// @param  airResistance     Air resistance.
-void UpdateParticles(CubismPhysicsParticle* strand, csmInt32 strandCount, CubismVector2 totalTranslation, csmFloat32 totalAngle,
-    CubismVector2 windDirection, csmFloat32 thresholdValue, csmFloat32 deltaTimeSeconds, csmFloat32 airResistance)
+void UpdateParticleLanes(CubismPhysicsParticleLanes* lanes, CubismPhysicsParticleBatch* batch,
+    CubismVector2 windDirection, csmFloat32 deltaTimeSeconds)
 {
-    csmInt32 i;
-    csmFloat32 totalRadian;
-    csmFloat32 delay;
-    csmFloat32 radian;
-    CubismVector2 currentGravity;
-    CubismVector2 direction;
-    CubismVector2 velocity;
-    CubismVector2 force;
-    CubismVector2 newDirection;
-
-    strand[0].Position = totalTranslation;
-
-    totalRadian = CubismMath::DegreesToRadian(totalAngle);
-    currentGravity = CubismMath::RadianToDirection(totalRadian);
-    currentGravity.Normalize();
-
-    for (i = 1; i < strandCount; ++i)
+    csmInt32 i, lane;
+
+#ifdef CSM_PHYSICS_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 windX = _mm_set1_ps(windDirection.X);
+    const __m128 windY = _mm_set1_ps(windDirection.Y);
+    const __m128 delayTime = _mm_set1_ps(deltaTimeSeconds);
+    const __m128 delayScale = _mm_set1_ps(30.0f);
+    const __m128 gravityX = _mm_loadu_ps(batch->GravityX);
+    const __m128 gravityY = _mm_loadu_ps(batch->GravityY);
+    const __m128 rotationCos = _mm_loadu_ps(batch->RotationCos);
+    const __m128 rotationSin = _mm_loadu_ps(batch->RotationSin);
+    const __m128 threshold = _mm_loadu_ps(batch->Threshold);
+
+    for (i = 1; i < batch->ParticleCount; ++i)
     {
-        strand[i].Force = (currentGravity * strand[i].Acceleration) + windDirection;
-
-        strand[i].LastPosition = strand[i].Position;
-
-        delay = strand[i].Delay * deltaTimeSeconds * 30.0f;
+        CubismPhysicsParticleLanes* particle = &lanes[i];
+        const CubismPhysicsParticleLanes* parent = &lanes[i - 1];
+
+        const __m128 active = _mm_cmpneq_ps(_mm_loadu_ps(particle->Active), zero);
+        const __m128 parentX = _mm_loadu_ps(parent->PositionX);
+        const __m128 parentY = _mm_loadu_ps(parent->PositionY);
+        const __m128 lastX = _mm_loadu_ps(particle->PositionX);
+        const __m128 lastY = _mm_loadu_ps(particle->PositionY);
+        const __m128 lastVelocityX = _mm_loadu_ps(particle->VelocityX);
+        const __m128 lastVelocityY = _mm_loadu_ps(particle->VelocityY);
+        const __m128 acceleration = _mm_loadu_ps(particle->Acceleration);
+        const __m128 delay = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(particle->Delay), delayTime), delayScale);
+
+        const __m128 forceX = _mm_add_ps(_mm_mul_ps(gravityX, acceleration), windX);
+        const __m128 forceY = _mm_add_ps(_mm_mul_ps(gravityY, acceleration), windY);
+
+        __m128 directionX = _mm_sub_ps(lastX, parentX);
+        __m128 directionY = _mm_sub_ps(lastY, parentY);
+        directionX = _mm_sub_ps(_mm_mul_ps(rotationCos, directionX), _mm_mul_ps(directionY, rotationSin));
+        directionY = _mm_add_ps(_mm_mul_ps(rotationSin, directionX), _mm_mul_ps(directionY, rotationCos));
+
+        __m128 positionX = _mm_add_ps(parentX, directionX);
+        __m128 positionY = _mm_add_ps(parentY, directionY);
+        positionX = _mm_add_ps(_mm_add_ps(positionX, _mm_mul_ps(lastVelocityX, delay)), _mm_mul_ps(_mm_mul_ps(forceX, delay), delay));
+        positionY = _mm_add_ps(_mm_add_ps(positionY, _mm_mul_ps(lastVelocityY, delay)), _mm_mul_ps(_mm_mul_ps(forceY, delay), delay));
+
+        __m128 newDirectionX = _mm_sub_ps(positionX, parentX);
+        __m128 newDirectionY = _mm_sub_ps(positionY, parentY);
+        const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(newDirectionX, newDirectionX), _mm_mul_ps(newDirectionY, newDirectionY)));
+        newDirectionX = _mm_div_ps(newDirectionX, length);
+        newDirectionY = _mm_div_ps(newDirectionY, length);
+
+        const __m128 radius = _mm_loadu_ps(particle->Radius);
+        positionX = _mm_add_ps(parentX, _mm_mul_ps(newDirectionX, radius));
+        positionY = _mm_add_ps(parentY, _mm_mul_ps(newDirectionY, radius));
+
+        positionX = _mm_andnot_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, positionX), threshold), positionX);
+
+        const __m128 mobility = _mm_loadu_ps(particle->Mobility);
+        const __m128 hasDelay = _mm_and_ps(active, _mm_cmpneq_ps(delay, zero));
+        const __m128 velocityX = _mm_mul_ps(_mm_div_ps(_mm_sub_ps(positionX, lastX), delay), mobility);
+        const __m128 velocityY = _mm_mul_ps(_mm_div_ps(_mm_sub_ps(positionY, lastY), delay), mobility);
+
+        // Lanes without this particle keep their values.
+        _mm_storeu_ps(particle->LastPositionX, SelectLanes(active, lastX, _mm_loadu_ps(particle->LastPositionX)));
+        _mm_storeu_ps(particle->LastPositionY, SelectLanes(active, lastY, _mm_loadu_ps(particle->LastPositionY)));
+        _mm_storeu_ps(particle->PositionX, SelectLanes(active, positionX, lastX));
+        _mm_storeu_ps(particle->PositionY, SelectLanes(active, positionY, lastY));
+        _mm_storeu_ps(particle->VelocityX, SelectLanes(hasDelay, velocityX, lastVelocityX));
+        _mm_storeu_ps(particle->VelocityY, SelectLanes(hasDelay, velocityY, lastVelocityY));
+    }
+#else
+    for (i = 1; i < batch->ParticleCount; ++i)
+    {
+        CubismPhysicsParticleLanes* particle = &lanes[i];
+        const CubismPhysicsParticleLanes* parent = &lanes[i - 1];
 
-        direction.X = strand[i].Position.X - strand[i - 1].Position.X;
-        direction.Y = strand[i].Position.Y - strand[i - 1].Position.Y;
+        for (lane = 0; lane < CubismPhysicsLaneCount; ++lane)
+        {
+            if (particle->Active[lane] == 0.0f)
+            {
+                continue;
+            }
 
-        radian = CubismMath::DirectionToRadian(strand[i].LastGravity, currentGravity) / airResistance;
+            const csmFloat32 parentX = parent->PositionX[lane];
+            const csmFloat32 parentY = parent->PositionY[lane];
+            const csmFloat32 lastX = particle->PositionX[lane];
+            const csmFloat32 lastY = particle->PositionY[lane];
+            const csmFloat32 delay = particle->Delay[lane] * deltaTimeSeconds * 30.0f;
 
-        direction.X = ((CubismMath::CosF(radian) * direction.X) - (direction.Y * CubismMath::SinF(radian)));
-        direction.Y = ((CubismMath::SinF(radian) * direction.X) + (direction.Y * CubismMath::CosF(radian)));
+            const csmFloat32 forceX = (batch->GravityX[lane] * particle->Acceleration[lane]) + windDirection.X;
+            const csmFloat32 forceY = (batch->GravityY[lane] * particle->Acceleration[lane]) + windDirection.Y;
 
-        strand[i].Position = strand[i - 1].Position + direction;
+            csmFloat32 directionX = lastX - parentX;
+            csmFloat32 directionY = lastY - parentY;
+            directionX = (batch->RotationCos[lane] * directionX) - (directionY * batch->RotationSin[lane]);
+            directionY = (batch->RotationSin[lane] * directionX) + (directionY * batch->RotationCos[lane]);
 
-        velocity.X = strand[i].Velocity.X * delay;
-        velocity.Y = strand[i].Velocity.Y * delay;
-        force = strand[i].Force * delay * delay;
+            csmFloat32 positionX = parentX + directionX;
+            csmFloat32 positionY = parentY + directionY;
+            positionX = positionX + (particle->VelocityX[lane] * delay) + (forceX * delay * delay);
+            positionY = positionY + (particle->VelocityY[lane] * delay) + (forceY * delay * delay);
 
-        strand[i].Position = strand[i].Position + velocity + force;
+            csmFloat32 newDirectionX = positionX - parentX;
+            csmFloat32 newDirectionY = positionY - parentY;
+            const csmFloat32 length = CubismMath::SqrtF((newDirectionX * newDirectionX) + (newDirectionY * newDirectionY));
+            newDirectionX = newDirectionX / length;
+            newDirectionY = newDirectionY / length;
 
-        newDirection = strand[i].Position - strand[i - 1].Position;
+            positionX = parentX + (newDirectionX * particle->Radius[lane]);
+            positionY = parentY + (newDirectionY * particle->Radius[lane]);
 
-        newDirection.Normalize();
+            if (CubismMath::AbsF(positionX) < batch->Threshold[lane])
+            {
+                positionX = 0.0f;
+            }
 
-        strand[i].Position = strand[i - 1].Position + (newDirection * strand[i].Radius);
+            if (delay != 0.0f)
+            {
+                particle->VelocityX[lane] = ((positionX - lastX) / delay) * particle->Mobility[lane];
+                particle->VelocityY[lane] = ((positionY - lastY) / delay) * particle->Mobility[lane];
+            }
 
-        if (CubismMath::AbsF(strand[i].Position.X) < thresholdValue)
-        {
-            strand[i].Position.X = 0.0f;
-        }
-
-        if (delay != 0.0f)
-        {
-            strand[i].Velocity.X = strand[i].Position.X - strand[i].LastPosition.X;
-            strand[i].Velocity.Y = strand[i].Position.Y - strand[i].LastPosition.Y;
-            strand[i].Velocity /= delay;
-            strand[i].Velocity *= strand[i].Mobility;
+            particle->LastPositionX[lane] = lastX;
+            particle->LastPositionY[lane] = lastY;
+            particle->PositionX[lane] = positionX;
+            particle->PositionY[lane] = positionY;
         }
+    }
+#endif
 
-        strand[i].Force = CubismVector2(0.0f, 0.0f);
-        strand[i].LastGravity = currentGravity;
+    for (lane = 0; lane < CubismPhysicsLaneCount; ++lane)
+    {
+        batch->LastGravityX[lane] = batch->GravityX[lane];
+        batch->LastGravityY[lane] = batch->GravityY[lane];
     }
 }
 
@@ -396,7 +484,7 @@ void UpdateParticlesForStabilization(CubismPhysicsParticle* strand, csmInt32 str
 /// @param  parameterValueMaximum  Maximum of parameter value.
 /// @param  translation            Translation value.
 void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameterValueMinimum, csmFloat32 parameterValueMaximum,
-    csmFloat32 translation, CubismPhysicsOutput* output)
+    csmFloat32 translation, const CubismPhysicsOutput* output, CubismPhysicsOutputState* outputState)
 {
     csmFloat32 outputScale;
     csmFloat32 value;
@@ -408,18 +496,18 @@ void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameter
 
     if (value < parameterValueMinimum)
     {
-        if (value < output->ValueBelowMinimum)
+        if (value < outputState->ValueBelowMinimum)
         {
-            output->ValueBelowMinimum = value;
+            outputState->ValueBelowMinimum = value;
         }
 
         value = parameterValueMinimum;
     }
     else if (value > parameterValueMaximum)
     {
-        if (value > output->ValueExceededMaximum)
+        if (value > outputState->ValueExceededMaximum)
         {
-            output->ValueExceededMaximum = value;
+            outputState->ValueExceededMaximum = value;
         }
 
         value = parameterValueMaximum;
@@ -442,6 +530,7 @@ void UpdateOutputParameterValue(csmFloat32* parameterValue, csmFloat32 parameter
 
 CubismPhysics::CubismPhysics()
     : _physicsRig(NULL)
+    , _particleLanesDirty(true)
 {
     // set default options.
     _options.Gravity.Y = -1.0f;
@@ -453,7 +542,11 @@ CubismPhysics::CubismPhysics()
 
 CubismPhysics::~CubismPhysics()
 {
-    CSM_DELETE(_physicsRig);
+    // 共有している設定は最後のインスタンスが解放する
+    if (_physicsRig != NULL && --_physicsRig->ReferenceCount == 0)
+    {
+        CSM_DELETE(_physicsRig);
+    }
     _parameterCaches.Clear();
     _parameterInputCaches.Clear();
 }
@@ -471,7 +564,7 @@ void CubismPhysics::Initialize()
     for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
     {
         currentSetting = &_physicsRig->Settings[settingIndex];
-        strand = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
+        strand = &_particles[currentSetting->BaseParticleIndex];
 
         // Initialize the top of particle.
         strand[0].InitialPosition = CubismVector2(0.0f, 0.0f);
@@ -495,6 +588,8 @@ void CubismPhysics::Initialize()
             strand[i].Force = CubismVector2(0.0f, 0.0f);
         }
     }
+
+    _particleLanesDirty = true;
 }
 
 /// Reset the physics states.
@@ -506,11 +601,7 @@ void CubismPhysics::Reset()
     _options.Wind.X = 0.0f;
     _options.Wind.Y = 0.0f;
 
-    _physicsRig->Gravity.X = 0.0f;
-    _physicsRig->Gravity.Y = 0.0f;
-    _physicsRig->Wind.X = 0.0f;
-    _physicsRig->Wind.Y = 0.0f;
-
+    // 設定の重力と風は演算に使わず、インスタンス間で共有しているので書き換えない
     Initialize();
 }
 
@@ -518,7 +609,14 @@ CubismPhysics* CubismPhysics::Create(const csmByte* buffer, csmSizeInt size)
 {
     CubismPhysics* ret = CSM_NEW CubismPhysics();
 
-    ret->Parse(buffer, size);
+    if (Utils::CubismBinary::IsBinary(buffer, size))
+    {
+        ret->ParseBinary(buffer, size);
+    }
+    else
+    {
+        ret->Parse(buffer, size);
+    }
 
     if (!ret->_isJsonValid)
     {
@@ -530,6 +628,23 @@ CubismPhysics* CubismPhysics::Create(const csmByte* buffer, csmSizeInt size)
     return ret;
 }
 
+CubismPhysics* CubismPhysics::CreateShared(const CubismPhysics* source)
+{
+    CubismPhysics* ret = CSM_NEW CubismPhysics();
+
+    ret->_physicsRig = source->_physicsRig;
+    ++ret->_physicsRig->ReferenceCount;
+
+    ret->_options = source->_options;
+    ret->_isJsonValid = true;
+
+    // 演算の状態は共有元によらず初期状態から始める
+    ret->PrepareInstanceState();
+    ret->Initialize();
+
+    return ret;
+}
+
 void CubismPhysics::Delete(CubismPhysics* physics)
 {
     CSM_DELETE_SELF(CubismPhysics, physics);
@@ -560,9 +675,6 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
     _physicsRig->Outputs.UpdateSize(json->GetTotalOutputCount(), CubismPhysicsOutput(), true);
     _physicsRig->Particles.UpdateSize(json->GetVertexCount(), CubismPhysicsParticle(), true);
 
-    _currentRigOutputs.Clear();
-    _previousRigOutputs.Clear();
-
     csmInt32 inputIndex = 0, outputIndex = 0, particleIndex = 0;
     for (csmUint32 i = 0; i < _physicsRig->Settings.GetSize(); ++i)
     {
@@ -579,7 +691,6 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
         _physicsRig->Settings[i].BaseInputIndex = inputIndex;
         for (csmInt32 j = 0; j < _physicsRig->Settings[i].InputCount; ++j)
         {
-            _physicsRig->Inputs[inputIndex + j].SourceParameterIndex = -1;
             _physicsRig->Inputs[inputIndex + j].Weight = json->GetInputWeight(i, j);
             _physicsRig->Inputs[inputIndex + j].Reflect = json->GetInputReflect(i, j);
 
@@ -608,17 +719,8 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
         _physicsRig->Settings[i].OutputCount = json->GetOutputCount(i);
         _physicsRig->Settings[i].BaseOutputIndex = outputIndex;
 
-        PhysicsOutput currentRigOutput;
-        currentRigOutput.outputs.Resize(_physicsRig->Settings[i].OutputCount);
-        _currentRigOutputs.PushBack(currentRigOutput);
-
-        PhysicsOutput previousRigOutput;
-        previousRigOutput.outputs.Resize(_physicsRig->Settings[i].OutputCount);
-        _previousRigOutputs.PushBack(previousRigOutput);
-
         for (csmInt32 j = 0; j < _physicsRig->Settings[i].OutputCount; ++j)
         {
-            _physicsRig->Outputs[outputIndex + j].DestinationParameterIndex = -1;
             _physicsRig->Outputs[outputIndex + j].VertexIndex = json->GetOutputVertexIndex(i, j);
             _physicsRig->Outputs[outputIndex + j].AngleScale = json->GetOutputAngleScale(i, j);
             _physicsRig->Outputs[outputIndex + j].Weight = json->GetOutputWeight(i, j);
@@ -663,11 +765,306 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
         particleIndex += _physicsRig->Settings[i].ParticleCount;
     }
 
+    PrepareInstanceState();
+
     Initialize();
 
     CSM_DELETE(json);
 }
 
+void CubismPhysics::ParseBinary(const csmByte* buffer, csmSizeInt size)
+{
+    using Utils::CubismBinary;
+
+    _isJsonValid = false;
+    _physicsRig = CSM_NEW CubismPhysicsRig;
+
+    const CubismBinary::Header* header = CubismBinary::GetHeader(buffer, size, CubismBinary::Kind_Physics);
+    const CubismPhysicsBinaryBody* body = (header != NULL) ? CubismBinary::GetBody<CubismPhysicsBinaryBody>(header) : NULL;
+    if (body == NULL
+        || body->SubRigCount < 0 || body->InputCount < 0 || body->OutputCount < 0 || body->ParticleCount < 0)
+    {
+        CubismLogError("Invalid binary physics.");
+        return;
+    }
+
+    const CubismPhysicsBinarySubRig* subRigs = CubismBinary::GetArray<CubismPhysicsBinarySubRig>(header, body->SubRigOffset, body->SubRigCount);
+    const CubismPhysicsBinaryInput* inputs = CubismBinary::GetArray<CubismPhysicsBinaryInput>(header, body->InputOffset, body->InputCount);
+    const CubismPhysicsBinaryOutput* outputs = CubismBinary::GetArray<CubismPhysicsBinaryOutput>(header, body->OutputOffset, body->OutputCount);
+    const CubismPhysicsBinaryParticle* particles = CubismBinary::GetArray<CubismPhysicsBinaryParticle>(header, body->ParticleOffset, body->ParticleCount);
+    if (subRigs == NULL || inputs == NULL || outputs == NULL || particles == NULL)
+    {
+        CubismLogError("Invalid binary physics.");
+        return;
+    }
+
+    // 各物理点の管理の個数の合計が総数と一致すること
+    csmInt32 inputTotal = 0, outputTotal = 0, particleTotal = 0;
+    for (csmInt32 i = 0; i < body->SubRigCount; ++i)
+    {
+        if (subRigs[i].InputCount < 0 || subRigs[i].OutputCount < 0 || subRigs[i].ParticleCount < 1
+            || subRigs[i].InputCount > body->InputCount - inputTotal
+            || subRigs[i].OutputCount > body->OutputCount - outputTotal
+            || subRigs[i].ParticleCount > body->ParticleCount - particleTotal)
+        {
+            CubismLogError("Invalid binary physics setting.");
+            return;
+        }
+        inputTotal += subRigs[i].InputCount;
+        outputTotal += subRigs[i].OutputCount;
+        particleTotal += subRigs[i].ParticleCount;
+    }
+    if (inputTotal != body->InputCount || outputTotal != body->OutputCount || particleTotal != body->ParticleCount)
+    {
+        CubismLogError("Invalid binary physics setting.");
+        return;
+    }
+    for (csmInt32 i = 0; i < body->InputCount; ++i)
+    {
+        if (inputs[i].Type < CubismPhysicsSource_X || inputs[i].Type > CubismPhysicsSource_Angle
+            || CubismBinary::GetString(header, inputs[i].SourceIdOffset) == NULL)
+        {
+            CubismLogError("Invalid binary physics input.");
+            return;
+        }
+    }
+    for (csmInt32 i = 0; i < body->OutputCount; ++i)
+    {
+        if (outputs[i].Type < CubismPhysicsSource_X || outputs[i].Type > CubismPhysicsSource_Angle
+            || CubismBinary::GetString(header, outputs[i].DestinationIdOffset) == NULL)
+        {
+            CubismLogError("Invalid binary physics output.");
+            return;
+        }
+    }
+
+    _physicsRig->Gravity = CubismVector2(body->GravityX, body->GravityY);
+    _physicsRig->Wind = CubismVector2(body->WindX, body->WindY);
+    _physicsRig->SubRigCount = body->SubRigCount;
+    _physicsRig->Fps = body->Fps;
+
+    _physicsRig->Settings.UpdateSize(body->SubRigCount, CubismPhysicsSubRig(), true);
+    _physicsRig->Inputs.UpdateSize(body->InputCount, CubismPhysicsInput(), true);
+    _physicsRig->Outputs.UpdateSize(body->OutputCount, CubismPhysicsOutput(), true);
+    _physicsRig->Particles.UpdateSize(body->ParticleCount, CubismPhysicsParticle(), true);
+
+    csmInt32 inputIndex = 0, outputIndex = 0, particleIndex = 0;
+    for (csmInt32 i = 0; i < body->SubRigCount; ++i)
+    {
+        CubismPhysicsSubRig& setting = _physicsRig->Settings[i];
+
+        setting.NormalizationPosition = subRigs[i].NormalizationPosition;
+        setting.NormalizationAngle = subRigs[i].NormalizationAngle;
+        setting.InputCount = subRigs[i].InputCount;
+        setting.OutputCount = subRigs[i].OutputCount;
+        setting.ParticleCount = subRigs[i].ParticleCount;
+        setting.BaseInputIndex = inputIndex;
+        setting.BaseOutputIndex = outputIndex;
+        setting.BaseParticleIndex = particleIndex;
+
+        inputIndex += setting.InputCount;
+        outputIndex += setting.OutputCount;
+        particleIndex += setting.ParticleCount;
+    }
+
+    // Input
+    for (csmInt32 i = 0; i < body->InputCount; ++i)
+    {
+        CubismPhysicsInput& input = _physicsRig->Inputs[i];
+
+        input.Weight = inputs[i].Weight;
+        input.Reflect = inputs[i].Reflect;
+        input.Type = inputs[i].Type;
+
+        switch (input.Type)
+        {
+        case CubismPhysicsSource_X:
+            input.GetNormalizedParameterValue = GetInputTranslationXFromNormalizedParameterValue;
+            break;
+        case CubismPhysicsSource_Y:
+            input.GetNormalizedParameterValue = GetInputTranslationYFromNormalizedParameterValue;
+            break;
+        case CubismPhysicsSource_Angle:
+        default:
+            input.GetNormalizedParameterValue = GetInputAngleFromNormalizedParameterValue;
+            break;
+        }
+
+        input.Source.TargetType = CubismPhysicsTargetType_Parameter;
+        input.Source.Id = CubismFramework::GetIdManager()->GetId(CubismBinary::GetString(header, inputs[i].SourceIdOffset));
+    }
+
+    // Output
+    for (csmInt32 i = 0; i < body->OutputCount; ++i)
+    {
+        CubismPhysicsOutput& output = _physicsRig->Outputs[i];
+
+        output.VertexIndex = outputs[i].VertexIndex;
+        output.AngleScale = outputs[i].AngleScale;
+        output.Weight = outputs[i].Weight;
+        output.Destination.TargetType = CubismPhysicsTargetType_Parameter;
+        output.Destination.Id = CubismFramework::GetIdManager()->GetId(CubismBinary::GetString(header, outputs[i].DestinationIdOffset));
+        output.Type = static_cast<CubismPhysicsSource>(outputs[i].Type);
+
+        switch (output.Type)
+        {
+        case CubismPhysicsSource_X:
+            output.GetValue = GetOutputTranslationX;
+            output.GetScale = GetOutputScaleTranslationX;
+            break;
+        case CubismPhysicsSource_Y:
+            output.GetValue = GetOutputTranslationY;
+            output.GetScale = GetOutputScaleTranslationY;
+            break;
+        case CubismPhysicsSource_Angle:
+        default:
+            output.GetValue = GetOutputAngle;
+            output.GetScale = GetOutputScaleAngle;
+            break;
+        }
+
+        output.Reflect = outputs[i].Reflect;
+    }
+
+    // Particle
+    for (csmInt32 i = 0; i < body->ParticleCount; ++i)
+    {
+        CubismPhysicsParticle& particle = _physicsRig->Particles[i];
+
+        particle.Mobility = particles[i].Mobility;
+        particle.Delay = particles[i].Delay;
+        particle.Acceleration = particles[i].Acceleration;
+        particle.Radius = particles[i].Radius;
+        particle.Position = CubismVector2(particles[i].PositionX, particles[i].PositionY);
+    }
+
+    PrepareInstanceState();
+
+    Initialize();
+
+    _isJsonValid = true;
+}
+
+void CubismPhysics::PrepareInstanceState()
+{
+    CubismPhysicsOutputState outputState;
+    outputState.DestinationParameterIndex = -1;
+    outputState.ValueBelowMinimum = 0.0f;
+    outputState.ValueExceededMaximum = 0.0f;
+
+    _particles = _physicsRig->Particles;
+    _inputParameterIndices.Clear();
+    _inputParameterIndices.UpdateSize(_physicsRig->Inputs.GetSize(), -1, true);
+    _outputStates.Clear();
+    _outputStates.UpdateSize(_physicsRig->Outputs.GetSize(), outputState, true);
+
+    _currentRigOutputs.Clear();
+    _previousRigOutputs.Clear();
+
+    for (csmInt32 i = 0; i < _physicsRig->SubRigCount; ++i)
+    {
+        PhysicsOutput currentRigOutput;
+        currentRigOutput.outputs.Resize(_physicsRig->Settings[i].OutputCount);
+        _currentRigOutputs.PushBack(currentRigOutput);
+
+        PhysicsOutput previousRigOutput;
+        previousRigOutput.outputs.Resize(_physicsRig->Settings[i].OutputCount);
+        _previousRigOutputs.PushBack(previousRigOutput);
+    }
+}
+
+void CubismPhysics::ExportBinary(csmVector<csmByte>& buffer) const
+{
+    using Utils::CubismBinary;
+    using Utils::CubismBinaryWriter;
+
+    CubismPhysicsBinaryBody body;
+    memset(&body, 0, sizeof(body));
+
+    // Create で重力の Y を 0 に書き換えているため、出力の重力・風は JSON の値とは限らない。
+    // 実行時は SetOptions の値で上書きされるので読み込み結果には影響しない。
+    body.GravityX = _physicsRig->Gravity.X;
+    body.GravityY = _physicsRig->Gravity.Y;
+    body.WindX = _physicsRig->Wind.X;
+    body.WindY = _physicsRig->Wind.Y;
+    body.Fps = _physicsRig->Fps;
+    body.SubRigCount = _physicsRig->SubRigCount;
+    body.InputCount = _physicsRig->Inputs.GetSize();
+    body.OutputCount = _physicsRig->Outputs.GetSize();
+    body.ParticleCount = _physicsRig->Particles.GetSize();
+
+    CubismBinaryWriter writer(CubismBinary::Kind_Physics, sizeof(body));
+
+    csmVector<CubismPhysicsBinarySubRig> subRigs(body.SubRigCount > 0 ? body.SubRigCount : 1);
+    for (csmInt32 i = 0; i < body.SubRigCount; ++i)
+    {
+        const CubismPhysicsSubRig& setting = _physicsRig->Settings[i];
+        CubismPhysicsBinarySubRig item;
+
+        item.InputCount = setting.InputCount;
+        item.OutputCount = setting.OutputCount;
+        item.ParticleCount = setting.ParticleCount;
+        item.NormalizationPosition = setting.NormalizationPosition;
+        item.NormalizationAngle = setting.NormalizationAngle;
+
+        subRigs.PushBack(item);
+    }
+
+    csmVector<CubismPhysicsBinaryInput> inputs(body.InputCount > 0 ? body.InputCount : 1);
+    for (csmInt32 i = 0; i < body.InputCount; ++i)
+    {
+        const CubismPhysicsInput& input = _physicsRig->Inputs[i];
+        CubismPhysicsBinaryInput item;
+
+        item.SourceIdOffset = writer.AddString(input.Source.Id->GetString().GetRawString());
+        item.Weight = input.Weight;
+        item.Type = input.Type;
+        item.Reflect = input.Reflect;
+
+        inputs.PushBack(item);
+    }
+
+    csmVector<CubismPhysicsBinaryOutput> outputs(body.OutputCount > 0 ? body.OutputCount : 1);
+    for (csmInt32 i = 0; i < body.OutputCount; ++i)
+    {
+        const CubismPhysicsOutput& output = _physicsRig->Outputs[i];
+        CubismPhysicsBinaryOutput item;
+
+        item.DestinationIdOffset = writer.AddString(output.Destination.Id->GetString().GetRawString());
+        item.VertexIndex = output.VertexIndex;
+        item.AngleScale = output.AngleScale;
+        item.Weight = output.Weight;
+        item.Type = static_cast<csmInt16>(output.Type);
+        item.Reflect = output.Reflect;
+
+        outputs.PushBack(item);
+    }
+
+    // Initialize で書き換わらない先頭の物理点の位置だけが JSON 由来の値として意味を持つ
+    csmVector<CubismPhysicsBinaryParticle> particles(body.ParticleCount > 0 ? body.ParticleCount : 1);
+    for (csmInt32 i = 0; i < body.ParticleCount; ++i)
+    {
+        const CubismPhysicsParticle& particle = _physicsRig->Particles[i];
+        CubismPhysicsBinaryParticle item;
+
+        item.Mobility = particle.Mobility;
+        item.Delay = particle.Delay;
+        item.Acceleration = particle.Acceleration;
+        item.Radius = particle.Radius;
+        item.PositionX = particle.Position.X;
+        item.PositionY = particle.Position.Y;
+
+        particles.PushBack(item);
+    }
+
+    body.SubRigOffset = writer.AddArray(subRigs.GetPtr(), sizeof(CubismPhysicsBinarySubRig) * subRigs.GetSize());
+    body.InputOffset = writer.AddArray(inputs.GetPtr(), sizeof(CubismPhysicsBinaryInput) * inputs.GetSize());
+    body.OutputOffset = writer.AddArray(outputs.GetPtr(), sizeof(CubismPhysicsBinaryOutput) * outputs.GetSize());
+    body.ParticleOffset = writer.AddArray(particles.GetPtr(), sizeof(CubismPhysicsBinaryParticle) * particles.GetSize());
+
+    writer.Finish(&body, buffer);
+}
+
 
 void CubismPhysics::Stabilization(CubismModel* model)
 {
@@ -678,8 +1075,10 @@ void CubismPhysics::Stabilization(CubismModel* model)
     CubismVector2 totalTranslation;
     csmInt32 i, settingIndex, particleIndex;
     CubismPhysicsSubRig* currentSetting;
-    CubismPhysicsInput* currentInputs;
-    CubismPhysicsOutput* currentOutputs;
+    const CubismPhysicsInput* currentInputs;
+    csmInt32* inputParameterIndices;
+    const CubismPhysicsOutput* currentOutputs;
+    CubismPhysicsOutputState* outputStates;
     CubismPhysicsParticle* currentParticles;
 
     csmFloat32* parameterValues;
@@ -714,34 +1113,36 @@ void CubismPhysics::Stabilization(CubismModel* model)
         totalTranslation.Y = 0.0f;
         currentSetting = &_physicsRig->Settings[settingIndex];
         currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
+        inputParameterIndices = &_inputParameterIndices[currentSetting->BaseInputIndex];
         currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
-        currentParticles = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
+        outputStates = &_outputStates[currentSetting->BaseOutputIndex];
+        currentParticles = &_particles[currentSetting->BaseParticleIndex];
 
         // Load input parameters
         for (i = 0; i < currentSetting->InputCount; ++i)
         {
             weight = currentInputs[i].Weight / MaximumWeight;
 
-            if (currentInputs[i].SourceParameterIndex == -1)
+            if (inputParameterIndices[i] == -1)
             {
-                currentInputs[i].SourceParameterIndex = model->GetParameterIndex(currentInputs[i].Source.Id);
+                inputParameterIndices[i] = model->GetParameterIndex(currentInputs[i].Source.Id);
             }
 
             currentInputs[i].GetNormalizedParameterValue(
                 &totalTranslation,
                 &totalAngle,
-                parameterValues[currentInputs[i].SourceParameterIndex],
-                parameterMinimumValues[currentInputs[i].SourceParameterIndex],
-                parameterMaximumValues[currentInputs[i].SourceParameterIndex],
-                parameterDefaultValues[currentInputs[i].SourceParameterIndex],
+                parameterValues[inputParameterIndices[i]],
+                parameterMinimumValues[inputParameterIndices[i]],
+                parameterMaximumValues[inputParameterIndices[i]],
+                parameterDefaultValues[inputParameterIndices[i]],
                 &currentSetting->NormalizationPosition,
                 &currentSetting->NormalizationAngle,
                 currentInputs[i].Reflect,
                 weight
             );
 
-            _parameterCaches[currentInputs[i].SourceParameterIndex] =
-                parameterValues[currentInputs[i].SourceParameterIndex];
+            _parameterCaches[inputParameterIndices[i]] =
+                parameterValues[inputParameterIndices[i]];
         }
 
         radAngle = CubismMath::DegreesToRadian(-totalAngle);
@@ -764,9 +1165,9 @@ void CubismPhysics::Stabilization(CubismModel* model)
         {
             particleIndex = currentOutputs[i].VertexIndex;
 
-            if (currentOutputs[i].DestinationParameterIndex == -1)
+            if (outputStates[i].DestinationParameterIndex == -1)
             {
-                currentOutputs[i].DestinationParameterIndex = model->GetParameterIndex(
+                outputStates[i].DestinationParameterIndex = model->GetParameterIndex(
                     currentOutputs[i].Destination.Id);
             }
 
@@ -791,15 +1192,18 @@ void CubismPhysics::Stabilization(CubismModel* model)
             _previousRigOutputs[settingIndex].outputs[i] = outputValue;
 
             UpdateOutputParameterValue(
-                &parameterValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMinimumValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMaximumValues[currentOutputs[i].DestinationParameterIndex],
+                &parameterValues[outputStates[i].DestinationParameterIndex],
+                parameterMinimumValues[outputStates[i].DestinationParameterIndex],
+                parameterMaximumValues[outputStates[i].DestinationParameterIndex],
                 outputValue,
-                &currentOutputs[i]);
+                &currentOutputs[i],
+                &outputStates[i]);
 
-            _parameterCaches[currentOutputs[i].DestinationParameterIndex] = parameterValues[currentOutputs[i].DestinationParameterIndex];
+            _parameterCaches[outputStates[i].DestinationParameterIndex] = parameterValues[outputStates[i].DestinationParameterIndex];
         }
     }
+
+    _particleLanesDirty = true;
 }
 
 /// Pendulum interpolation weights
@@ -845,13 +1249,20 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
     csmFloat32 totalAngle;
     csmFloat32 weight;
     csmFloat32 radAngle;
+    csmFloat32 radian;
     csmFloat32 outputValue;
     CubismVector2 totalTranslation;
-    csmInt32 i, settingIndex, particleIndex;
+    CubismVector2 currentGravity;
+    csmInt32 i, lane, settingIndex, particleIndex;
+    csmUint32 batchIndex;
     CubismPhysicsSubRig* currentSetting;
-    CubismPhysicsInput* currentInputs;
-    CubismPhysicsOutput* currentOutputs;
+    const CubismPhysicsInput* currentInputs;
+    csmInt32* inputParameterIndices;
+    const CubismPhysicsOutput* currentOutputs;
+    CubismPhysicsOutputState* outputStates;
     CubismPhysicsParticle* currentParticles;
+    CubismPhysicsParticleBatch* currentBatch;
+    CubismPhysicsParticleLanes* currentLanes;
 
     if (0.0f >= deltaTimeSeconds)
     {
@@ -887,6 +1298,15 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
         }
     }
 
+    if (_particleBatches.GetSize() == 0)
+    {
+        PrepareParticleBatches(model);
+    }
+    if (_particleLanesDirty)
+    {
+        LoadParticleLanes();
+    }
+
     if (_physicsRig->Fps > 0.0f)
     {
         physicsDeltaTime = 1.0f / _physicsRig->Fps;
@@ -896,6 +1316,8 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
         physicsDeltaTime = deltaTimeSeconds;
     }
 
+    csmBool isUpdated = false;
+
     while (_currentRemainTime >= physicsDeltaTime)
     {
         // copyRigOutputs _currentRigOutputs to _previousRigOutputs
@@ -913,103 +1335,140 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
         // Calculate the input at the timing to UpdateParticles by linear interpolation with the _parameterInputCaches and parameterValues.
         // _parameterCachesはグループ間での値の伝搬の役割があるので_parameterInputCachesとの分離が必要。
         // _parameterCaches needs to be separated from _parameterInputCaches because of its role in propagating values between groups.
+        // 物理演算が読み書きするパラメータ（入力元と出力先）のみを補間する。
+        // Only the parameters read or written by physics (sources and destinations) are interpolated.
         float inputWeight =  physicsDeltaTime / _currentRemainTime;
-        for (csmInt32 j = 0; j < model->GetParameterCount(); ++j)
+        for (csmUint32 k = 0; k < _interpolatedParameterIndices.GetSize(); ++k)
         {
+            const csmInt32 j = _interpolatedParameterIndices[k];
             _parameterCaches[j] = _parameterInputCaches[j] * (1.0f - inputWeight) + parameterValues[j] * inputWeight;
             _parameterInputCaches[j] = _parameterCaches[j];
         }
 
-        for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
+        for (batchIndex = 0; batchIndex < _particleBatches.GetSize(); ++batchIndex)
         {
-            totalAngle = 0.0f;
-            totalTranslation.X = 0.0f;
-            totalTranslation.Y = 0.0f;
-            currentSetting = &_physicsRig->Settings[settingIndex];
-            currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
-            currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
-            currentParticles = &_physicsRig->Particles[currentSetting->BaseParticleIndex];
+            currentBatch = &_particleBatches[batchIndex];
+            currentLanes = &_particleLanes[currentBatch->BaseLaneIndex];
 
-            // Load input parameters.
-            for (i = 0; i < currentSetting->InputCount; ++i)
+            for (lane = 0; lane < currentBatch->LaneCount; ++lane)
             {
-                weight = currentInputs[i].Weight / MaximumWeight;
-
-                if (currentInputs[i].SourceParameterIndex == -1)
+                totalAngle = 0.0f;
+                totalTranslation.X = 0.0f;
+                totalTranslation.Y = 0.0f;
+                settingIndex = currentBatch->SubRigIndices[lane];
+                currentSetting = &_physicsRig->Settings[settingIndex];
+                currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
+                inputParameterIndices = &_inputParameterIndices[currentSetting->BaseInputIndex];
+
+                // Load input parameters.
+                for (i = 0; i < currentSetting->InputCount; ++i)
                 {
-                    currentInputs[i].SourceParameterIndex = model->GetParameterIndex(currentInputs[i].Source.Id);
+                    weight = currentInputs[i].Weight / MaximumWeight;
+
+                    currentInputs[i].GetNormalizedParameterValue(
+                        &totalTranslation,
+                        &totalAngle,
+                        _parameterCaches[inputParameterIndices[i]],
+                        parameterMinimumValues[inputParameterIndices[i]],
+                        parameterMaximumValues[inputParameterIndices[i]],
+                        parameterDefaultValues[inputParameterIndices[i]],
+                        &currentSetting->NormalizationPosition,
+                        &currentSetting->NormalizationAngle,
+                        currentInputs[i].Reflect,
+                        weight
+                    );
                 }
 
-                currentInputs[i].GetNormalizedParameterValue(
-                    &totalTranslation,
-                    &totalAngle,
-                    _parameterCaches[currentInputs[i].SourceParameterIndex],
-                    parameterMinimumValues[currentInputs[i].SourceParameterIndex],
-                    parameterMaximumValues[currentInputs[i].SourceParameterIndex],
-                    parameterDefaultValues[currentInputs[i].SourceParameterIndex],
-                    &currentSetting->NormalizationPosition,
-                    &currentSetting->NormalizationAngle,
-                    currentInputs[i].Reflect,
-                    weight
-                );
-            }
+                // 入力の回転と重力の向きは同じ角度の sin と cos から求める（-totalAngle の sin は符号の反転）。
+                // The rotation of the input and the direction of gravity share the sin and cos of the total angle.
+                radAngle = CubismMath::DegreesToRadian(totalAngle);
+                const csmFloat32 cosAngle = CubismMath::CosF(radAngle);
+                const csmFloat32 sinAngle = -CubismMath::SinF(radAngle);
 
-            radAngle = CubismMath::DegreesToRadian(-totalAngle);
+                totalTranslation.X = (totalTranslation.X * cosAngle - totalTranslation.Y * sinAngle);
+                totalTranslation.Y = (totalTranslation.X * sinAngle + totalTranslation.Y * cosAngle);
 
-            totalTranslation.X = (totalTranslation.X * CubismMath::CosF(radAngle) - totalTranslation.Y * CubismMath::SinF(radAngle));
-            totalTranslation.Y = (totalTranslation.X * CubismMath::SinF(radAngle) + totalTranslation.Y * CubismMath::CosF(radAngle));
+                // 重力と、その変化による回転は振り子内の物理点で共通なので、ここで一度だけ求める。
+                // The gravity and the rotation by its change are shared by the particles of a strand, so compute them once here.
+                currentGravity.X = -sinAngle;
+                currentGravity.Y = cosAngle;
+                currentGravity.Normalize();
 
-            // Calculate particles position.
-            UpdateParticles(
-                currentParticles,
-                currentSetting->ParticleCount,
-                totalTranslation,
-                totalAngle,
-                _options.Wind,
-                MovementThreshold * currentSetting->NormalizationPosition.Maximum,
-                physicsDeltaTime,
-                AirResistance
-            );
+                radian = CubismMath::DirectionToRadian(
+                    CubismVector2(currentBatch->LastGravityX[lane], currentBatch->LastGravityY[lane]),
+                    currentGravity) / AirResistance;
 
-            // Update output parameters.
-            for (i = 0; i < currentSetting->OutputCount; ++i)
-            {
-                particleIndex = currentOutputs[i].VertexIndex;
+                currentBatch->GravityX[lane] = currentGravity.X;
+                currentBatch->GravityY[lane] = currentGravity.Y;
+                currentBatch->RotationCos[lane] = CubismMath::CosF(radian);
+                currentBatch->RotationSin[lane] = CubismMath::SinF(radian);
 
-                if (currentOutputs[i].DestinationParameterIndex == -1)
+                if (currentSetting->ParticleCount > 0)
                 {
-                    currentOutputs[i].DestinationParameterIndex = model->GetParameterIndex(currentOutputs[i].Destination.Id);
+                    currentLanes[0].PositionX[lane] = totalTranslation.X;
+                    currentLanes[0].PositionY[lane] = totalTranslation.Y;
                 }
+            }
+
+            // Calculate particles position.
+            UpdateParticleLanes(currentLanes, currentBatch, _options.Wind, physicsDeltaTime);
+            StoreParticleLanes(*currentBatch, true);
 
-                if (particleIndex < 1 || particleIndex >= currentSetting->ParticleCount)
+            // Update output parameters.
+            for (lane = 0; lane < currentBatch->LaneCount; ++lane)
+            {
+                settingIndex = currentBatch->SubRigIndices[lane];
+                currentSetting = &_physicsRig->Settings[settingIndex];
+                currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
+                outputStates = &_outputStates[currentSetting->BaseOutputIndex];
+                currentParticles = &_particles[currentSetting->BaseParticleIndex];
+
+                for (i = 0; i < currentSetting->OutputCount; ++i)
                 {
-                    continue;
+                    particleIndex = currentOutputs[i].VertexIndex;
+
+                    if (particleIndex < 1 || particleIndex >= currentSetting->ParticleCount)
+                    {
+                        continue;
+                    }
+
+                    CubismVector2 translation;
+                    translation.X = currentParticles[particleIndex].Position.X - currentParticles[particleIndex - 1].Position.X;
+                    translation.Y = currentParticles[particleIndex].Position.Y - currentParticles[particleIndex - 1].Position.Y;
+
+                    outputValue = currentOutputs[i].GetValue(
+                        translation,
+                        currentParticles,
+                        particleIndex,
+                        currentOutputs[i].Reflect,
+                        _options.Gravity
+                    );
+
+                    _currentRigOutputs[settingIndex].outputs[i] = outputValue;
+
+                    UpdateOutputParameterValue(
+                            &_parameterCaches[outputStates[i].DestinationParameterIndex],
+                            parameterMinimumValues[outputStates[i].DestinationParameterIndex],
+                            parameterMaximumValues[outputStates[i].DestinationParameterIndex],
+                            outputValue,
+                            &currentOutputs[i],
+                            &outputStates[i]);
                 }
-
-                CubismVector2 translation;
-                translation.X = currentParticles[particleIndex].Position.X - currentParticles[particleIndex - 1].Position.X;
-                translation.Y = currentParticles[particleIndex].Position.Y - currentParticles[particleIndex - 1].Position.Y;
-
-                outputValue = currentOutputs[i].GetValue(
-                    translation,
-                    currentParticles,
-                    particleIndex,
-                    currentOutputs[i].Reflect,
-                    _options.Gravity
-                );
-
-                _currentRigOutputs[settingIndex].outputs[i] = outputValue;
-
-                UpdateOutputParameterValue(
-                        &_parameterCaches[currentOutputs[i].DestinationParameterIndex],
-                        parameterMinimumValues[currentOutputs[i].DestinationParameterIndex],
-                        parameterMaximumValues[currentOutputs[i].DestinationParameterIndex],
-                        outputValue,
-                        &currentOutputs[i]);
             }
         }
 
         _currentRemainTime -= physicsDeltaTime;
+        isUpdated = true;
+    }
+
+    // 速度などは振り子の計算の間は一括演算用の物理点だけで持ち、最後にまとめて書き戻す。
+    // Velocities and others are kept only in the lanes during the loop and written back once at the end.
+    if (isUpdated)
+    {
+        for (batchIndex = 0; batchIndex < _particleBatches.GetSize(); ++batchIndex)
+        {
+            StoreParticleLanes(_particleBatches[batchIndex], false);
+        }
     }
 
     const float alpha = _currentRemainTime / physicsDeltaTime;
@@ -1019,7 +1478,8 @@ void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
 void CubismPhysics::Interpolate(CubismModel* model, csmFloat32 weight)
 {
     csmInt32 i, settingIndex;
-    CubismPhysicsOutput* currentOutputs;
+    const CubismPhysicsOutput* currentOutputs;
+    CubismPhysicsOutputState* outputStates;
     CubismPhysicsSubRig* currentSetting;
     csmFloat32* parameterValues;
     const csmFloat32* parameterMaximumValues;
@@ -1033,26 +1493,222 @@ void CubismPhysics::Interpolate(CubismModel* model, csmFloat32 weight)
     {
         currentSetting = &_physicsRig->Settings[settingIndex];
         currentOutputs = &_physicsRig->Outputs[currentSetting->BaseOutputIndex];
+        outputStates = &_outputStates[currentSetting->BaseOutputIndex];
 
         // Load input parameters.
         for (i = 0; i < currentSetting->OutputCount; ++i)
         {
-            if (currentOutputs[i].DestinationParameterIndex == -1)
+            if (outputStates[i].DestinationParameterIndex == -1)
             {
                 continue;
             }
 
             UpdateOutputParameterValue(
-                &parameterValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMinimumValues[currentOutputs[i].DestinationParameterIndex],
-                parameterMaximumValues[currentOutputs[i].DestinationParameterIndex],
+                &parameterValues[outputStates[i].DestinationParameterIndex],
+                parameterMinimumValues[outputStates[i].DestinationParameterIndex],
+                parameterMaximumValues[outputStates[i].DestinationParameterIndex],
                 _previousRigOutputs[settingIndex].outputs[i] * (1 - weight) + _currentRigOutputs[settingIndex].outputs[i] * weight,
-                &currentOutputs[i]
+                &currentOutputs[i],
+                &outputStates[i]
             );
         }
     }
 }
 
+void CubismPhysics::PrepareParticleBatches(CubismModel* model)
+{
+    csmInt32 i, j, lane, settingIndex;
+    CubismPhysicsSubRig* currentSetting;
+    const CubismPhysicsInput* currentInputs;
+    csmInt32* inputParameterIndices;
+    const CubismPhysicsOutput* currentOutputs;
+    CubismPhysicsOutputState* outputStates;
+
+    const csmInt32 parameterCount = model->GetParameterCount();
+    csmVector<csmBool> isInterpolated;
+    isInterpolated.UpdateSize(parameterCount, false, true);
+
+    // 入力元と出力先のパラメータのインデックスを解決する
+    for (csmUint32 inputIndex = 0; inputIndex < _physicsRig->Inputs.GetSize(); ++inputIndex)
+    {
+        csmInt32& sourceParameterIndex = _inputParameterIndices[inputIndex];
+
+        if (sourceParameterIndex == -1)
+        {
+            sourceParameterIndex = model->GetParameterIndex(_physicsRig->Inputs[inputIndex].Source.Id);
+        }
+        if (0 <= sourceParameterIndex && sourceParameterIndex < parameterCount)
+        {
+            isInterpolated[sourceParameterIndex] = true;
+        }
+    }
+
+    for (csmUint32 outputIndex = 0; outputIndex < _physicsRig->Outputs.GetSize(); ++outputIndex)
+    {
+        csmInt32& destinationParameterIndex = _outputStates[outputIndex].DestinationParameterIndex;
+
+        if (destinationParameterIndex == -1)
+        {
+            destinationParameterIndex = model->GetParameterIndex(_physicsRig->Outputs[outputIndex].Destination.Id);
+        }
+        if (0 <= destinationParameterIndex && destinationParameterIndex < parameterCount)
+        {
+            isInterpolated[destinationParameterIndex] = true;
+        }
+    }
+
+    _interpolatedParameterIndices.Clear();
+    for (i = 0; i < parameterCount; ++i)
+    {
+        if (isInterpolated[i])
+        {
+            _interpolatedParameterIndices.PushBack(i);
+        }
+    }
+
+    // 連続した物理点の管理をバッチにまとめる
+    _particleBatches.Clear();
+    for (settingIndex = 0; settingIndex < _physicsRig->SubRigCount; ++settingIndex)
+    {
+        currentSetting = &_physicsRig->Settings[settingIndex];
+        currentInputs = &_physicsRig->Inputs[currentSetting->BaseInputIndex];
+        inputParameterIndices = &_inputParameterIndices[currentSetting->BaseInputIndex];
+
+        csmBool isNewBatch = (_particleBatches.GetSize() == 0
+            || _particleBatches[_particleBatches.GetSize() - 1].LaneCount == CubismPhysicsLaneCount);
+
+        // 同じバッチの前のレーンの出力を入力に使う場合は、そのレーンの結果を待つ必要があるので分ける
+        if (!isNewBatch)
+        {
+            const CubismPhysicsParticleBatch& batch = _particleBatches[_particleBatches.GetSize() - 1];
+
+            for (lane = 0; lane < batch.LaneCount && !isNewBatch; ++lane)
+            {
+                const CubismPhysicsSubRig& laneSetting = _physicsRig->Settings[batch.SubRigIndices[lane]];
+                currentOutputs = &_physicsRig->Outputs[laneSetting.BaseOutputIndex];
+                outputStates = &_outputStates[laneSetting.BaseOutputIndex];
+
+                for (i = 0; i < laneSetting.OutputCount && !isNewBatch; ++i)
+                {
+                    for (j = 0; j < currentSetting->InputCount; ++j)
+                    {
+                        if (inputParameterIndices[j] == outputStates[i].DestinationParameterIndex)
+                        {
+                            isNewBatch = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (isNewBatch)
+        {
+            CubismPhysicsParticleBatch batch;
+            memset(&batch, 0, sizeof(batch));
+            for (lane = 0; lane < CubismPhysicsLaneCount; ++lane)
+            {
+                batch.SubRigIndices[lane] = -1;
+            }
+            _particleBatches.PushBack(batch);
+        }
+
+        CubismPhysicsParticleBatch& batch = _particleBatches[_particleBatches.GetSize() - 1];
+        lane = batch.LaneCount++;
+        batch.SubRigIndices[lane] = settingIndex;
+        batch.Threshold[lane] = MovementThreshold * currentSetting->NormalizationPosition.Maximum;
+        if (currentSetting->ParticleCount > batch.ParticleCount)
+        {
+            batch.ParticleCount = currentSetting->ParticleCount;
+        }
+    }
+
+    csmInt32 laneIndex = 0;
+    for (i = 0; i < static_cast<csmInt32>(_particleBatches.GetSize()); ++i)
+    {
+        _particleBatches[i].BaseLaneIndex = laneIndex;
+        laneIndex += _particleBatches[i].ParticleCount;
+    }
+
+    CubismPhysicsParticleLanes emptyLanes;
+    memset(&emptyLanes, 0, sizeof(emptyLanes));
+    _particleLanes.Clear();
+    _particleLanes.UpdateSize(laneIndex, emptyLanes, true);
+
+    _particleLanesDirty = true;
+}
+
+void CubismPhysics::LoadParticleLanes()
+{
+    csmInt32 i, lane;
+
+    for (csmUint32 batchIndex = 0; batchIndex < _particleBatches.GetSize(); ++batchIndex)
+    {
+        CubismPhysicsParticleBatch& batch = _particleBatches[batchIndex];
+        CubismPhysicsParticleLanes* lanes = &_particleLanes[batch.BaseLaneIndex];
+
+        for (lane = 0; lane < batch.LaneCount; ++lane)
+        {
+            const CubismPhysicsSubRig& setting = _physicsRig->Settings[batch.SubRigIndices[lane]];
+            const CubismPhysicsParticle* strand = &_particles[setting.BaseParticleIndex];
+
+            for (i = 0; i < setting.ParticleCount; ++i)
+            {
+                lanes[i].PositionX[lane] = strand[i].Position.X;
+                lanes[i].PositionY[lane] = strand[i].Position.Y;
+                lanes[i].LastPositionX[lane] = strand[i].LastPosition.X;
+                lanes[i].LastPositionY[lane] = strand[i].LastPosition.Y;
+                lanes[i].VelocityX[lane] = strand[i].Velocity.X;
+                lanes[i].VelocityY[lane] = strand[i].Velocity.Y;
+                lanes[i].Mobility[lane] = strand[i].Mobility;
+                lanes[i].Delay[lane] = strand[i].Delay;
+                lanes[i].Acceleration[lane] = strand[i].Acceleration;
+                lanes[i].Radius[lane] = strand[i].Radius;
+                lanes[i].Active[lane] = 1.0f;
+            }
+
+            // 最後の重力は先頭以外の物理点で共通
+            if (setting.ParticleCount > 1)
+            {
+                batch.LastGravityX[lane] = strand[1].LastGravity.X;
+                batch.LastGravityY[lane] = strand[1].LastGravity.Y;
+            }
+        }
+    }
+
+    _particleLanesDirty = false;
+}
+
+void CubismPhysics::StoreParticleLanes(const CubismPhysicsParticleBatch& batch, csmBool positionOnly)
+{
+    csmInt32 i, lane;
+    const CubismPhysicsParticleLanes* lanes = &_particleLanes[batch.BaseLaneIndex];
+
+    for (lane = 0; lane < batch.LaneCount; ++lane)
+    {
+        const CubismPhysicsSubRig& setting = _physicsRig->Settings[batch.SubRigIndices[lane]];
+        CubismPhysicsParticle* strand = &_particles[setting.BaseParticleIndex];
+
+        for (i = 0; i < setting.ParticleCount; ++i)
+        {
+            strand[i].Position.X = lanes[i].PositionX[lane];
+            strand[i].Position.Y = lanes[i].PositionY[lane];
+
+            if (positionOnly || i == 0)
+            {
+                continue;
+            }
+
+            strand[i].LastPosition.X = lanes[i].LastPositionX[lane];
+            strand[i].LastPosition.Y = lanes[i].LastPositionY[lane];
+            strand[i].Velocity.X = lanes[i].VelocityX[lane];
+            strand[i].Velocity.Y = lanes[i].VelocityY[lane];
+            strand[i].LastGravity.X = batch.LastGravityX[lane];
+            strand[i].LastGravity.Y = batch.LastGravityY[lane];
+        }
+    }
+}
+
 void CubismPhysics::SetOptions(const Options& options)
 {
     _options = options;
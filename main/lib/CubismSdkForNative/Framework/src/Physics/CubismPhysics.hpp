@@ -49,12 +49,35 @@ public:
      *
      * インスタンスを作成する。
      *
+     * バッファの内容が ExportBinary で書き出したバイナリ形式の場合はそちらとして読み込む。
+     *
      * @param[in]   buffer      physics3.jsonが読み込まれいるバッファ
      * @param[in]   size        バッファのサイズ
      * @return  作成されたインスタンス
      */
     static CubismPhysics* Create(const csmByte* buffer, csmSizeInt size);
 
+    /**
+     * @brief 設定を共有するインスタンスの作成
+     *
+     * 物理演算の設定（物理点の管理・入力・出力・物理点の配置）を共有し、オプションを複製したインスタンスを作成する。
+     * 物理点の状態・パラメータのインデックス・出力結果はインスタンスごとに持ち、初期化した状態から始める。
+     * 共有する設定は参照カウントで管理し、最後に使っていたインスタンスと一緒に破棄する。
+     *
+     * @param[in]   source      設定を共有するインスタンス
+     * @return  作成されたインスタンス
+     */
+    static CubismPhysics* CreateShared(const CubismPhysics* source);
+
+    /**
+     * @brief バイナリ形式の書き出し
+     *
+     * 物理演算設定を Utils::CubismBinary の形式で書き出す。
+     *
+     * @param[out]  buffer      ファイルの内容
+     */
+    void ExportBinary(csmVector<csmByte>& buffer) const;
+
     /**
      * @brief インスタンスの破棄
      *
@@ -134,6 +157,25 @@ private:
      */
     void Parse(const csmByte* physicsJson, csmSizeInt size);
 
+    /**
+     * @brief バイナリ形式のパース
+     *
+     * ExportBinary で書き出したバイナリ形式を読み込む。
+     * 不正なデータの場合は _isJsonValid を false にする。
+     *
+     * @param[in]   buffer      ファイルの内容
+     * @param[in]   size        バッファのサイズ
+     */
+    void ParseBinary(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * @brief インスタンスごとの状態の確保
+     *
+     * 共有する設定から物理点を複製し、パラメータのインデックスと出力の状態、
+     * 物理点の管理ごとの出力結果のバッファを確保する。
+     */
+    void PrepareInstanceState();
+
     /**
      * @brief 初期化
      *
@@ -151,9 +193,40 @@ private:
      */
     void Interpolate(CubismModel* model, csmFloat32 weight);
 
-    CubismPhysicsRig* _physicsRig; ///< 物理演算のデータ
+    /**
+     * @brief 物理点の一括演算の準備
+     *
+     * 入力・出力のパラメータのインデックスを解決し、振り子の計算ごとに補間するパラメータを列挙する。
+     * 連続した物理点の管理をバッチにまとめ、一括演算用の物理点を確保する。
+     *
+     * @param model 物理演算の対象のモデル
+     */
+    void PrepareParticleBatches(CubismModel* model);
+
+    /**
+     * @brief 一括演算用の物理点の読み込み
+     *
+     * 物理点の現在の状態を一括演算用の物理点に読み込む。
+     */
+    void LoadParticleLanes();
+
+    /**
+     * @brief 一括演算用の物理点の書き戻し
+     *
+     * 一括演算の結果を物理点に書き戻す。
+     *
+     * @param batch         書き戻すバッチ
+     * @param positionOnly  trueなら位置のみ（出力の計算用）、falseなら速度と最後の位置・重力も書き戻す
+     */
+    void StoreParticleLanes(const CubismPhysicsParticleBatch& batch, csmBool positionOnly);
+
+    CubismPhysicsRig* _physicsRig; ///< 物理演算のデータ（インスタンス間で共有し、読み込み後は変更しない）
     Options _options; ///< オプション
 
+    csmVector<CubismPhysicsParticle> _particles;            ///< 物理点（_physicsRig->Particles の複製で、演算の状態を持つ）
+    csmVector<csmInt32> _inputParameterIndices;             ///< 入力ごとの入力元のパラメータのインデックス
+    csmVector<CubismPhysicsOutputState> _outputStates;      ///< 出力ごとの状態
+
     csmVector<PhysicsOutput> _currentRigOutputs; ///< 最新の振り子計算の結果
     csmVector<PhysicsOutput> _previousRigOutputs; ///< 一つ前の振り子計算の結果
 
@@ -161,6 +234,11 @@ private:
 
     csmVector<csmFloat32> _parameterCaches;      ///< Evaluateで利用するパラメータのキャッシュ
     csmVector<csmFloat32> _parameterInputCaches; ///< UpdateParticlesが動くときの入力をキャッシュ
+    csmVector<csmInt32> _interpolatedParameterIndices; ///< 振り子の計算ごとに補間するパラメータ（入力元と出力先）のインデックス
+
+    csmVector<CubismPhysicsParticleBatch> _particleBatches; ///< 物理点の一括演算のバッチ
+    csmVector<CubismPhysicsParticleLanes> _particleLanes;   ///< 一括演算用の物理点
+    csmBool _particleLanesDirty;                            ///< 物理点が初期化・安定化され、一括演算用の物理点の読み込みが必要か
 
     csmBool _isJsonValid; ///< 正しくJsonデータが取得出来たか
 };
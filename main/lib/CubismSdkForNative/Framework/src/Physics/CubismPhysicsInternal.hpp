@@ -11,6 +11,7 @@
 #include "Model/CubismModel.hpp"
 #include "Math/CubismVector2.hpp"
 #include "Id/CubismId.hpp"
+#include <atomic>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -173,7 +174,6 @@ typedef csmFloat32 (*PhysicsScaleGetter)(CubismVector2 translationScale, csmFloa
 struct CubismPhysicsInput
 {
     CubismPhysicsParameter Source;                  ///< 入力元のパラメータ
-    csmInt32 SourceParameterIndex;                  ///< 入力元のパラメータのインデックス
     csmFloat32 Weight;                              ///< 重み
     csmInt16 Type;                                  ///< 入力の種類
     csmInt16 Reflect;                               ///< 値が反転されているかどうか
@@ -188,34 +188,179 @@ struct CubismPhysicsInput
 struct CubismPhysicsOutput
 {
     CubismPhysicsParameter Destination;         ///< 出力先のパラメータ
-    csmInt32 DestinationParameterIndex;         ///< 出力先のパラメータのインデックス
     csmInt32 VertexIndex;                       ///< 振り子のインデックス
     CubismVector2 TranslationScale;             ///< 移動値のスケール
     csmFloat32 AngleScale;                      ///< 角度のスケール
     csmFloat32 Weight;                          /// 重み
     CubismPhysicsSource Type;                   ///< 出力の種類
     csmInt16 Reflect;                           ///< 値が反転されているかどうか
-    csmFloat32 ValueBelowMinimum;               ///< 最小値を下回った時の値
-    csmFloat32 ValueExceededMaximum;            ///< 最大値をこえた時の値
     PhysicsValueGetter GetValue;                ///< 物理演算の値の取得関数
     PhysicsScaleGetter GetScale;                ///< 物理演算のスケール値の取得関数
 };
 
+/**
+ * @brief 物理演算の出力の状態
+ *
+ * 物理演算の出力のうち、モデルごと・インスタンスごとに持つ値。
+ */
+struct CubismPhysicsOutputState
+{
+    csmInt32 DestinationParameterIndex;         ///< 出力先のパラメータのインデックス
+    csmFloat32 ValueBelowMinimum;               ///< 最小値を下回った時の値
+    csmFloat32 ValueExceededMaximum;            ///< 最大値をこえた時の値
+};
+
 /**
  * @brief 物理演算のデータ
  *
  * 物理演算のデータ。
+ * 読み込み後は変更せず、CubismPhysics::CreateShared で作ったインスタンス間で共有する。
+ * 物理点の状態とパラメータのインデックスは各インスタンスが持つ。
  */
 struct CubismPhysicsRig
 {
+    /**
+     * @brief コンストラクタ
+     */
+    CubismPhysicsRig()
+        : SubRigCount(0)
+        , Fps(0.0f)
+        , ReferenceCount(1)
+    { }
+
     csmInt32 SubRigCount;                           ///< 物理演算の物理点の個数
     csmVector<CubismPhysicsSubRig> Settings;        ///< 物理演算の物理点の管理のリスト
     csmVector<CubismPhysicsInput> Inputs;           ///< 物理演算の入力のリスト
     csmVector<CubismPhysicsOutput> Outputs;         ///< 物理演算の出力のリスト
-    csmVector<CubismPhysicsParticle> Particles;     ///< 物理演算の物理点のリスト
+    csmVector<CubismPhysicsParticle> Particles;     ///< 物理演算の物理点のリスト（各インスタンスの物理点の初期値）
     CubismVector2 Gravity;                          ///< 重力
     CubismVector2 Wind;                             ///< 風
     csmFloat32 Fps;                                 ///< 物理演算動作FPS
+    std::atomic<csmInt32> ReferenceCount;           ///< このデータを使うインスタンスの数（CubismPhysics::CreateShared を参照）
+};
+
+/**
+ * @brief 物理点をまとめて演算するときのレーン数
+ *
+ * 物理点の管理をこの数ずつバッチにまとめ、各物理点の管理を 1 レーンとして同時に演算する。
+ */
+const csmInt32 CubismPhysicsLaneCount = 4;
+
+/**
+ * @brief 一括演算用の物理点（SoA）
+ *
+ * バッチ内の各物理点の管理から同じ番号の物理点を集め、項目ごとにレーン順に並べたもの。
+ * 物理点の管理の物理点が足りないレーンは Active が 0 で、演算結果を書き込まない。
+ */
+struct CubismPhysicsParticleLanes
+{
+    csmFloat32 PositionX[CubismPhysicsLaneCount];       ///< 現在の位置 X
+    csmFloat32 PositionY[CubismPhysicsLaneCount];       ///< 現在の位置 Y
+    csmFloat32 LastPositionX[CubismPhysicsLaneCount];   ///< 最後の位置 X
+    csmFloat32 LastPositionY[CubismPhysicsLaneCount];   ///< 最後の位置 Y
+    csmFloat32 VelocityX[CubismPhysicsLaneCount];       ///< 現在の速度 X
+    csmFloat32 VelocityY[CubismPhysicsLaneCount];       ///< 現在の速度 Y
+    csmFloat32 Mobility[CubismPhysicsLaneCount];        ///< 動きやすさ
+    csmFloat32 Delay[CubismPhysicsLaneCount];           ///< 遅れ
+    csmFloat32 Acceleration[CubismPhysicsLaneCount];    ///< 加速度
+    csmFloat32 Radius[CubismPhysicsLaneCount];          ///< 距離
+    csmFloat32 Active[CubismPhysicsLaneCount];          ///< レーンにこの物理点があれば 1、なければ 0
+};
+
+/**
+ * @brief 物理点の一括演算のバッチ
+ *
+ * 連続した物理点の管理を最大 CubismPhysicsLaneCount 個まとめたもの。
+ * 後ろのレーンの入力が前のレーンの出力先のパラメータを参照する場合は、同じバッチに入れない。
+ * 重力と回転は振り子の計算ごとにレーン単位で求めて設定する。
+ */
+struct CubismPhysicsParticleBatch
+{
+    csmInt32 SubRigIndices[CubismPhysicsLaneCount];     ///< レーンに割り当てた物理点の管理のインデックス（空きは -1）
+    csmInt32 LaneCount;                                 ///< 使用しているレーン数
+    csmInt32 ParticleCount;                             ///< レーン中で最大の物理点の個数
+    csmInt32 BaseLaneIndex;                             ///< CubismPhysicsParticleLanes の配列内の先頭のインデックス
+    csmFloat32 Threshold[CubismPhysicsLaneCount];       ///< 移動の閾値
+    csmFloat32 GravityX[CubismPhysicsLaneCount];        ///< 今回の重力 X
+    csmFloat32 GravityY[CubismPhysicsLaneCount];        ///< 今回の重力 Y
+    csmFloat32 LastGravityX[CubismPhysicsLaneCount];    ///< 最後の重力 X（物理点の管理内の物理点で共通）
+    csmFloat32 LastGravityY[CubismPhysicsLaneCount];    ///< 最後の重力 Y（物理点の管理内の物理点で共通）
+    csmFloat32 RotationCos[CubismPhysicsLaneCount];     ///< 重力の変化による回転の cos
+    csmFloat32 RotationSin[CubismPhysicsLaneCount];     ///< 重力の変化による回転の sin
+};
+
+/**
+ * @brief 物理演算設定のバイナリ形式の本体
+ *
+ * 物理演算設定のバイナリ形式（Utils::CubismBinary）の本体。
+ * 各配列はファイル先頭からのオフセットで参照する。
+ */
+struct CubismPhysicsBinaryBody
+{
+    csmFloat32 GravityX;                ///< 重力 X
+    csmFloat32 GravityY;                ///< 重力 Y
+    csmFloat32 WindX;                   ///< 風 X
+    csmFloat32 WindY;                   ///< 風 Y
+    csmFloat32 Fps;                     ///< 物理演算動作FPS
+    csmInt32 SubRigCount;               ///< 物理点の管理の個数
+    csmInt32 InputCount;                ///< 入力の総数
+    csmInt32 OutputCount;               ///< 出力の総数
+    csmInt32 ParticleCount;             ///< 物理点の総数
+    csmUint32 SubRigOffset;             ///< CubismPhysicsBinarySubRig の配列の位置
+    csmUint32 InputOffset;              ///< CubismPhysicsBinaryInput の配列の位置
+    csmUint32 OutputOffset;             ///< CubismPhysicsBinaryOutput の配列の位置
+    csmUint32 ParticleOffset;           ///< CubismPhysicsBinaryParticle の配列の位置
+};
+
+/**
+ * @brief 物理演算設定のバイナリ形式の物理点の管理
+ *
+ * 入力・出力・物理点は先頭から順に割り当てる。
+ */
+struct CubismPhysicsBinarySubRig
+{
+    csmInt32 InputCount;                                ///< 入力の個数
+    csmInt32 OutputCount;                               ///< 出力の個数
+    csmInt32 ParticleCount;                             ///< 物理点の個数
+    CubismPhysicsNormalization NormalizationPosition;   ///< 正規化された位置
+    CubismPhysicsNormalization NormalizationAngle;      ///< 正規化された角度
+};
+
+/**
+ * @brief 物理演算設定のバイナリ形式の入力
+ */
+struct CubismPhysicsBinaryInput
+{
+    csmUint32 SourceIdOffset;           ///< 入力元のパラメータIDの文字列テーブル内の位置
+    csmFloat32 Weight;                  ///< 重み
+    csmInt16 Type;                      ///< 入力の種類（CubismPhysicsSource）
+    csmInt16 Reflect;                   ///< 値が反転されているかどうか
+};
+
+/**
+ * @brief 物理演算設定のバイナリ形式の出力
+ */
+struct CubismPhysicsBinaryOutput
+{
+    csmUint32 DestinationIdOffset;      ///< 出力先のパラメータIDの文字列テーブル内の位置
+    csmInt32 VertexIndex;               ///< 振り子のインデックス
+    csmFloat32 AngleScale;              ///< 角度のスケール
+    csmFloat32 Weight;                  ///< 重み
+    csmInt16 Type;                      ///< 出力の種類（CubismPhysicsSource）
+    csmInt16 Reflect;                   ///< 値が反転されているかどうか
+};
+
+/**
+ * @brief 物理演算設定のバイナリ形式の物理点
+ */
+struct CubismPhysicsBinaryParticle
+{
+    csmFloat32 Mobility;                ///< 動きやすさ
+    csmFloat32 Delay;                   ///< 遅れ
+    csmFloat32 Acceleration;            ///< 加速度
+    csmFloat32 Radius;                  ///< 距離
+    csmFloat32 PositionX;               ///< 位置 X
+    csmFloat32 PositionY;               ///< 位置 Y
 };
 
 }}}
@@ -270,6 +270,149 @@ void CubismRendererProfile_OpenGLES2::Restore()
     glBlendFuncSeparate(_lastBlending[0], _lastBlending[1], _lastBlending[2], _lastBlending[3]);
 }
 
+/*********************************************************************************************************************
+ *                                      CubismGpuTimer_OpenGLES2
+ ********************************************************************************************************************/
+CubismGpuTimer_OpenGLES2::CubismGpuTimer_OpenGLES2()
+    : _nextQuery(0)
+    , _activeQuery(-1)
+    , _isCreated(false)
+    , _isSupported(false)
+    , _milliseconds(0.0f)
+    , _hasResult(false)
+{
+    for (csmInt32 i = 0; i < BufferCount; ++i)
+    {
+        _queries[i] = 0;
+        _isPending[i] = false;
+    }
+}
+
+CubismGpuTimer_OpenGLES2::~CubismGpuTimer_OpenGLES2()
+{
+    Release();
+}
+
+csmBool CubismGpuTimer_OpenGLES2::IsSupported()
+{
+#ifdef CSM_GPU_TIMER_QUERY
+    // Mesa (llvmpipe / softpipe) も ARB_timer_query を公開している
+    return (GLEW_VERSION_3_3 || GLEW_ARB_timer_query) ? true : false;
+#else
+    return false;
+#endif
+}
+
+void CubismGpuTimer_OpenGLES2::Begin()
+{
+#ifdef CSM_GPU_TIMER_QUERY
+    if (!_isCreated)
+    {
+        _isCreated = true;
+        _isSupported = IsSupported();
+        if (!_isSupported)
+        {
+            CubismLogWarning("GL_TIME_ELAPSED queries are not supported. GPU timing is disabled.");
+            return;
+        }
+        glGenQueries(BufferCount, _queries);
+    }
+
+    if (!_isSupported || _activeQuery >= 0)
+    {
+        return;
+    }
+
+    CollectResults();
+
+    // 結果がまだ出ていないクエリは再利用しない（再利用すると完了待ちが発生しうる）
+    if (_isPending[_nextQuery])
+    {
+        return;
+    }
+
+    _activeQuery = _nextQuery;
+    _nextQuery = (_nextQuery + 1) % BufferCount;
+    glBeginQuery(GL_TIME_ELAPSED, _queries[_activeQuery]);
+#endif
+}
+
+void CubismGpuTimer_OpenGLES2::End()
+{
+#ifdef CSM_GPU_TIMER_QUERY
+    if (_activeQuery < 0)
+    {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+    _isPending[_activeQuery] = true;
+    _activeQuery = -1;
+#endif
+}
+
+void CubismGpuTimer_OpenGLES2::CollectResults()
+{
+#ifdef CSM_GPU_TIMER_QUERY
+    // 古い順に確認し、最新の完了結果を残す
+    for (csmInt32 i = 0; i < BufferCount; ++i)
+    {
+        const csmInt32 index = (_nextQuery + i) % BufferCount;
+        if (!_isPending[index])
+        {
+            continue;
+        }
+
+        GLint available = 0;
+        glGetQueryObjectiv(_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            continue;
+        }
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(_queries[index], GL_QUERY_RESULT, &elapsed);
+        _milliseconds = static_cast<csmFloat32>(static_cast<double>(elapsed) / 1000000.0);
+        _hasResult = true;
+        _isPending[index] = false;
+    }
+#endif
+}
+
+csmFloat32 CubismGpuTimer_OpenGLES2::GetMilliseconds() const
+{
+    return _milliseconds;
+}
+
+csmBool CubismGpuTimer_OpenGLES2::HasResult() const
+{
+    return _hasResult;
+}
+
+void CubismGpuTimer_OpenGLES2::Release()
+{
+#ifdef CSM_GPU_TIMER_QUERY
+    if (_isCreated && _isSupported)
+    {
+        if (_activeQuery >= 0)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+        }
+        glDeleteQueries(BufferCount, _queries);
+    }
+#endif
+
+    for (csmInt32 i = 0; i < BufferCount; ++i)
+    {
+        _queries[i] = 0;
+        _isPending[i] = false;
+    }
+    _nextQuery = 0;
+    _activeQuery = -1;
+    _isCreated = false;
+    _isSupported = false;
+}
+
 /*********************************************************************************************************************
  *                                      CubismRenderer_OpenGLES2
  ********************************************************************************************************************/
@@ -432,6 +575,7 @@ void CubismRenderer::StaticRelease()
 CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2() : _clippingManager(NULL)
                                                      , _clippingContextBufferForMask(NULL)
                                                      , _clippingContextBufferForDraw(NULL)
+                                                     , _isGpuTimerEnabled(false)
 {
     // テクスチャ対応マップの容量を確保しておく.
     _textures.PrepareCapacity(32, true);
@@ -535,6 +679,11 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
     //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
     if (_clippingManager != NULL)
     {
+        if (_isGpuTimerEnabled)
+        {
+            _maskGpuTimer.Begin();
+        }
+
         PreDraw();
 
         // サイズが違う場合はここで作成しなおし
@@ -556,6 +705,16 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
         {
            _clippingManager->SetupClippingContext(*GetModel(), this, _rendererProfile._lastFBO, _rendererProfile._lastViewport);
         }
+
+        if (_isGpuTimerEnabled)
+        {
+            _maskGpuTimer.End();
+        }
+    }
+
+    if (_isGpuTimerEnabled)
+    {
+        _drawGpuTimer.Begin();
     }
 
     // 上記クリッピング処理内でも一度PreDrawを呼ぶので注意!!
@@ -646,6 +805,11 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
         DrawMeshOpenGL(*GetModel(), drawableIndex);
     }
 
+    if (_isGpuTimerEnabled)
+    {
+        _drawGpuTimer.End();
+    }
+
     PostDraw();
 
 }
@@ -755,6 +919,26 @@ CubismOffscreenSurface_OpenGLES2* CubismRenderer_OpenGLES2::GetMaskBuffer(csmInt
     return &_offscreenSurfaces[index];
 }
 
+void CubismRenderer_OpenGLES2::SetGpuTimerEnabled(csmBool enabled)
+{
+    if (!enabled)
+    {
+        _maskGpuTimer.Release();
+        _drawGpuTimer.Release();
+    }
+    _isGpuTimerEnabled = enabled;
+}
+
+CubismRendererGpuStats CubismRenderer_OpenGLES2::GetGpuStats() const
+{
+    CubismRendererGpuStats stats;
+    stats.MaskMilliseconds = _maskGpuTimer.GetMilliseconds();
+    stats.DrawMilliseconds = _drawGpuTimer.GetMilliseconds();
+    stats.OverlayMilliseconds = 0.0f;
+    stats.IsAvailable = _maskGpuTimer.HasResult() || _drawGpuTimer.HasResult();
+    return stats;
+}
+
 void CubismRenderer_OpenGLES2::SetClippingContextBufferForMask(CubismClippingContext_OpenGLES2* clip)
 {
     _clippingContextBufferForMask = clip;
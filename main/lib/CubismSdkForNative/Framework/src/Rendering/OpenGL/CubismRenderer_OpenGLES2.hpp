@@ -46,6 +46,11 @@
 #include <GLES2/gl2ext.h>
 #endif
 
+// GL_TIME_ELAPSED クエリはデスクトップOpenGL（3.3 / ARB_timer_query）でのみ使用する
+#if defined(CSM_TARGET_WIN_GL) || defined(CSM_TARGET_LINUX_GL) || (defined(CSM_TARGET_MAC_GL) && !defined(CSM_TARGET_COCOS))
+#define CSM_GPU_TIMER_QUERY
+#endif
+
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
 
@@ -168,6 +173,101 @@ private:
     GLint _lastViewport[4];                 ///< モデル描画直前のビューポート
 };
 
+/**
+ * @brief   描画パスごとのGPU時間
+ *
+ * 値は数フレーム前に完了したパスのもの。計測できていないパスは0。
+ * レンダラーが計測するのはマスクと描画のパスで、モデルの上に重ねるUIなどアプリ側のパスは
+ * アプリが自身の CubismGpuTimer_OpenGLES2 で計測して OverlayMilliseconds に設定する。
+ */
+struct CubismRendererGpuStats
+{
+    csmFloat32 MaskMilliseconds;    ///< クリッピングマスク生成パス（高精細マスク時は描画パスに含まれる）
+    csmFloat32 DrawMilliseconds;    ///< 描画パス
+    csmFloat32 OverlayMilliseconds; ///< アプリ側のオーバーレイ描画パス（レンダラーは0を返す）
+    csmBool IsAvailable;            ///< 計測値が1度でも得られていればtrue
+};
+
+/**
+ * @brief   GL_TIME_ELAPSED クエリによる区間GPU時間の計測クラス
+ *
+ * クエリオブジェクトを BufferCount 個循環させ、結果は GL_QUERY_RESULT_AVAILABLE を
+ * 確認してから読むため、CPUがGPUの完了を待つことはない。
+ * 結果が間に合わなかったフレームは計測をスキップする。
+ * GL_TIME_ELAPSED は入れ子にできないため、計測区間を重ねてはならない。
+ * クエリオブジェクトはコンテキスト間で共有されないので、生成したコンテキストでのみ使用する。
+ */
+class CubismGpuTimer_OpenGLES2
+{
+public:
+    static const csmInt32 BufferCount = 2;      ///< 循環させるクエリの数（ダブルバッファ）
+
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismGpuTimer_OpenGLES2();
+
+    /**
+     * @brief   デストラクタ（クエリを生成したコンテキストがカレントである必要がある）
+     */
+    virtual ~CubismGpuTimer_OpenGLES2();
+
+    /**
+     * @brief   現在のコンテキストでタイマークエリが使えるかを判定する
+     *
+     * @return  使えるならtrue
+     */
+    static csmBool IsSupported();
+
+    /**
+     * @brief   計測区間の開始
+     *
+     * 完了済みのクエリがあれば結果を取り込み、空いているクエリで計測を始める。
+     */
+    void Begin();
+
+    /**
+     * @brief   計測区間の終了
+     */
+    void End();
+
+    /**
+     * @brief   最後に完了した区間のGPU時間を取得する
+     *
+     * @return  GPU時間[ミリ秒]。まだ結果が無ければ0
+     */
+    csmFloat32 GetMilliseconds() const;
+
+    /**
+     * @brief   結果が1度でも得られたかを取得する
+     */
+    csmBool HasResult() const;
+
+    /**
+     * @brief   クエリオブジェクトを破棄する
+     */
+    void Release();
+
+private:
+    // Prevention of copy Constructor
+    CubismGpuTimer_OpenGLES2(const CubismGpuTimer_OpenGLES2&);
+    CubismGpuTimer_OpenGLES2& operator=(const CubismGpuTimer_OpenGLES2&);
+
+    /**
+     * @brief   結果が出ているクエリを読み取る（待たない）
+     */
+    void CollectResults();
+
+    GLuint _queries[BufferCount];       ///< クエリオブジェクト
+    csmBool _isPending[BufferCount];    ///< 結果が未読のクエリ
+    csmInt32 _nextQuery;                ///< 次に使うクエリ
+    csmInt32 _activeQuery;              ///< 計測中のクエリ（計測していなければ-1）
+    csmBool _isCreated;                 ///< クエリ生成済みか
+    csmBool _isSupported;               ///< 生成時に判定したサポート状況
+    csmFloat32 _milliseconds;           ///< 最後に完了した区間の時間
+    csmBool _hasResult;                 ///< 結果が得られたか
+};
+
 /**
  * @brief   OpenGLES2用の描画命令を実装したクラス
  *
@@ -239,6 +339,23 @@ public:
      */
     CubismOffscreenSurface_OpenGLES2* GetMaskBuffer(csmInt32 index);
 
+    /**
+     * @brief  描画パスごとのGPU時間計測の有効・無効を設定する
+     *
+     * 有効にするとクリッピングマスク生成パスと描画パスを GL_TIME_ELAPSED クエリで計測する。
+     * タイマークエリが使えない環境では何もしない。
+     *
+     * @param[in]  enabled -> trueなら計測する
+     */
+    void SetGpuTimerEnabled(csmBool enabled);
+
+    /**
+     * @brief  描画パスごとのGPU時間を取得する
+     *
+     * @return 直近で完了したフレームの計測値
+     */
+    CubismRendererGpuStats GetGpuStats() const;
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -378,6 +495,10 @@ private:
     CubismClippingContext_OpenGLES2* _clippingContextBufferForDraw;  ///< 画面上描画するためのクリッピングコンテキスト
 
     csmVector<CubismOffscreenSurface_OpenGLES2>   _offscreenSurfaces;          ///< マスク描画用のフレームバッファ
+
+    csmBool _isGpuTimerEnabled;                 ///< GPU時間を計測するか
+    CubismGpuTimer_OpenGLES2 _maskGpuTimer;     ///< クリッピングマスク生成パスの計測
+    CubismGpuTimer_OpenGLES2 _drawGpuTimer;     ///< 描画パスの計測
 };
 
 }}}}
@@ -61,9 +61,56 @@ public:
     _ValT Second;   ///< Valueとして用いる変数
 };
 
+/**
+ * @brief   64ビット値を撹拌して32ビットのハッシュ値にする
+ */
+inline csmUint32 csmHashMix(csmUint64 x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<csmUint32>(x);
+}
+
+/**
+ * @brief   csmMapのキーからハッシュ値を求める関数オブジェクト<br>
+ *          整数・列挙型は値、ポインタはアドレス、csmStringは保持しているハッシュコードから求める。
+ */
+template<class T>
+struct csmHash
+{
+    csmUint32 operator()(const T& key) const
+    {
+        return csmHashMix(static_cast<csmUint64>(key));
+    }
+};
+
+template<class T>
+struct csmHash<T*>
+{
+    csmUint32 operator()(T* key) const
+    {
+        return csmHashMix(static_cast<csmUint64>(reinterpret_cast<csmSizeType>(key)));
+    }
+};
+
+template<>
+struct csmHash<csmString>
+{
+    csmUint32 operator()(const csmString& key) const
+    {
+        // ハッシュコードは初回の取得時に算出され、以降はキャッシュされる
+        return csmHashMix(static_cast<csmUint32>(key.GetHashcode()));
+    }
+};
+
 /**
  *@brief    マップ型<br>
- *           コンシューマゲーム機等でSTLの組み込みを避けるための実装。std::map の簡易版
+ *           コンシューマゲーム機等でSTLの組み込みを避けるための実装。std::map の簡易版<br>
+ *           要素は追加順に配列へ格納し（イテレータは追加順に巡回する）、
+ *           キーの検索はオープンアドレス法のハッシュ表（線形探索）で行う。
  */
 template<class _KeyT, class _ValT>
 class csmMap
@@ -102,31 +149,16 @@ public:
      */
     void AppendKey(_KeyT& key)
     {
-        csmInt32 findIndex = -1;
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                findIndex = i;
-                break;
-            }
-        }
+        const csmUint32 hash = csmHash<_KeyT>()(key);
 
         // 同じkeyが既に作られている場合は何もしない
-        if (findIndex != -1)
+        if (FindIndex(key, hash) != -1)
         {
             CubismLogWarning("The key is already append.");
             return;
         }
 
-        // 新しくKey/Valueのペアを作る
-        PrepareCapacity(_size + 1, false); //１つ以上入る隙間を作る
-        // 新しいkey/valueのインデックスは _size
-
-        void* addr = &_keyValues[_size];
-        CSM_PLACEMENT_NEW(addr) csmPair<_KeyT, _ValT>(key); //placement new
-
-        _size += 1;
+        AppendNewKey(key, hash);
     }
 
     /**
@@ -150,24 +182,17 @@ public:
      *
      * @return  添字から特定されるValue値
      */
-    _ValT& operator[](_KeyT key)
+    _ValT& operator[](const _KeyT& key)
     {
-        csmInt32 found = -1;
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                found = i;
-                break;
-            }
-        }
+        const csmUint32 hash = csmHash<_KeyT>()(key);
+        const csmInt32 found = FindIndex(key, hash);
         if (found >= 0)
         {
             return _keyValues[found].Second;
         }
         else
         {
-            AppendKey(key); // 新規キーを追加
+            AppendNewKey(key, hash); // 新規キーを追加
             return _keyValues[_size - 1].Second;
         }
     }
@@ -177,17 +202,9 @@ public:
      *
      * @return  添字から特定されるValue値
      */
-    const _ValT& operator[](_KeyT key) const
+    const _ValT& operator[](const _KeyT& key) const
     {
-        csmInt32 found = -1;
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                found = i;
-                break;
-            }
-        }
+        const csmInt32 found = FindIndex(key, csmHash<_KeyT>()(key));
         if (found >= 0)
         {
             return _keyValues[found].Second;
@@ -205,16 +222,33 @@ public:
      * @retval  true    ->  引数で渡したKeyを持つ要素が存在する
      * @retval  false   ->  引数で渡したKeyを持つ要素が存在しない
      */
-    csmBool IsExist(_KeyT key) const
+    csmBool IsExist(const _KeyT& key) const
     {
-        for (csmInt32 i = 0; i < _size; i++)
-        {
-            if (_keyValues[i].First == key)
-            {
-                return true;
-            }
-        }
-        return false;
+        return FindIndex(key, csmHash<_KeyT>()(key)) >= 0;
+    }
+
+    /**
+     * @brief   引数で渡したKeyを持つ要素のValueを取得する
+     *
+     * IsExist()と添字演算子を続けて呼ぶと検索が2回になるため、存在確認と取得を1回の検索で行う。
+     *
+     * @return  Valueへのポインタ。Keyを持つ要素が存在しない場合はNULL
+     */
+    _ValT* Find(const _KeyT& key)
+    {
+        const csmInt32 found = FindIndex(key, csmHash<_KeyT>()(key));
+        return (found >= 0) ? &_keyValues[found].Second : NULL;
+    }
+
+    /**
+     * @brief   引数で渡したKeyを持つ要素のValueを取得する(const)
+     *
+     * @return  Valueへのポインタ。Keyを持つ要素が存在しない場合はNULL
+     */
+    const _ValT* Find(const _KeyT& key) const
+    {
+        const csmInt32 found = FindIndex(key, csmHash<_KeyT>()(key));
+        return (found >= 0) ? &_keyValues[found].Second : NULL;
     }
 
     /**
@@ -506,6 +540,9 @@ public:
             memmove(&(_keyValues[index]), &(_keyValues[index + 1]), sizeof(csmPair<_KeyT, _ValT>) * (_size - index - 1));
         --_size;
 
+        // 以降の要素のインデックスがずれるため、ハッシュ表を作り直す
+        RebuildIndex();
+
         iterator ite2(this, index); // 終了
         return ite2;
     }
@@ -526,6 +563,9 @@ public:
             memmove(&(_keyValues[index]), &(_keyValues[index + 1]), sizeof(csmPair<_KeyT, _ValT>) * (_size - index - 1));
         --_size;
 
+        // 以降の要素のインデックスがずれるため、ハッシュ表を作り直す
+        RebuildIndex();
+
         const_iterator ite2(this, index); // 終了
         return ite2;
     }
@@ -538,6 +578,8 @@ public:
     void Copy(const csmMap& c)
     {
         _dummyValuePtr = NULL;
+        _indexSlots = NULL;
+        _indexCapacity = 0;
         _size = c._size;
         _capacity = c._capacity;
 
@@ -554,6 +596,15 @@ public:
             CSM_PLACEMENT_NEW(&_keyValues[i]) csmPair<_KeyT, _ValT>(c._keyValues[i].First,
                                                                     c._keyValues[i].Second);
         }
+
+        // 要素の並びが同じなのでハッシュ表はそのまま複製する
+        if (c._indexSlots != NULL)
+        {
+            _indexSlots = static_cast<IndexSlot*>(CSM_MALLOC(sizeof(IndexSlot) * c._indexCapacity));
+            CSM_ASSERT(_indexSlots != NULL);
+            memcpy(_indexSlots, c._indexSlots, sizeof(IndexSlot) * c._indexCapacity);
+            _indexCapacity = c._indexCapacity;
+        }
     }
 
     /**
@@ -567,12 +618,157 @@ public:
     }
 
 private:
-    static const csmInt32 DefaultSize = 10;  ///< コンテナ初期化のデフォルトサイズ
+    static const csmInt32 DefaultSize = 10;         ///< コンテナ初期化のデフォルトサイズ
+    static const csmInt32 DefaultIndexSize = 16;    ///< ハッシュ表の最小スロット数（2のべき乗）
+
+    /**
+     * @brief   ハッシュ表のスロット
+     */
+    struct IndexSlot
+    {
+        csmInt32 Index;     ///< _keyValuesのインデックス。空きスロットは-1
+        csmUint32 Hash;     ///< キーのハッシュ値
+    };
+
+    /**
+     * @brief   キーに対応する要素のインデックスを検索する
+     *
+     * ハッシュ表は要素を変更する操作の中でだけ作成・更新するため、検索はメンバを書き換えない
+     * （複数のスレッドから同じマップを同時に検索できる）。
+     *
+     * @param[in]   key     ->  検索するキー
+     * @param[in]   hash    ->  キーのハッシュ値
+     * @return  要素のインデックス。見つからなければ-1
+     */
+    csmInt32 FindIndex(const _KeyT& key, csmUint32 hash) const
+    {
+        if (_size == 0)
+        {
+            return -1;
+        }
+
+        // サイズ指定のコンストラクタで作られた要素にはハッシュ表が無いので線形に探す
+        if (_indexSlots == NULL)
+        {
+            for (csmInt32 i = 0; i < _size; i++)
+            {
+                if (_keyValues[i].First == key)
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        const csmUint32 mask = static_cast<csmUint32>(_indexCapacity - 1);
+        for (csmUint32 slot = hash & mask; ; slot = (slot + 1) & mask)
+        {
+            const csmInt32 index = _indexSlots[slot].Index;
+            if (index < 0)
+            {
+                return -1;
+            }
+            if (_indexSlots[slot].Hash == hash && _keyValues[index].First == key)
+            {
+                return index;
+            }
+        }
+    }
+
+    /**
+     * @brief   重複が無いことを確認済みのキーを末尾に追加する
+     *
+     * @param[in]   key     ->  追加するキー
+     * @param[in]   hash    ->  キーのハッシュ値
+     */
+    void AppendNewKey(const _KeyT& key, csmUint32 hash)
+    {
+        // 新しくKey/Valueのペアを作る
+        PrepareCapacity(_size + 1, false); //１つ以上入る隙間を作る
+        // 新しいkey/valueのインデックスは _size
+
+        void* addr = &_keyValues[_size];
+        CSM_PLACEMENT_NEW(addr) csmPair<_KeyT, _ValT>(key); //placement new
+
+        _size += 1;
+
+        if (_indexSlots == NULL || _size * 2 > _indexCapacity)
+        {
+            RebuildIndex();  // 未作成なら作り、負荷率を1/2以下に保つ
+        }
+        else
+        {
+            InsertIndex(_size - 1, hash);
+        }
+    }
+
+    /**
+     * @brief   ハッシュ表に要素のインデックスを登録する
+     */
+    void InsertIndex(csmInt32 index, csmUint32 hash)
+    {
+        const csmUint32 mask = static_cast<csmUint32>(_indexCapacity - 1);
+        csmUint32 slot = hash & mask;
+        while (_indexSlots[slot].Index >= 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        _indexSlots[slot].Index = index;
+        _indexSlots[slot].Hash = hash;
+    }
+
+    /**
+     * @brief   現在の要素からハッシュ表を作り直す
+     */
+    void RebuildIndex()
+    {
+        ReleaseIndex();
+
+        if (_size == 0)
+        {
+            return;
+        }
+
+        csmInt32 capacity = DefaultIndexSize;
+        while (capacity < _size * 2)
+        {
+            capacity *= 2;
+        }
+
+        _indexSlots = static_cast<IndexSlot*>(CSM_MALLOC(sizeof(IndexSlot) * capacity));
+        CSM_ASSERT(_indexSlots != NULL);
+        _indexCapacity = capacity;
+
+        for (csmInt32 i = 0; i < capacity; i++)
+        {
+            _indexSlots[i].Index = -1;
+        }
+
+        for (csmInt32 i = 0; i < _size; i++)
+        {
+            InsertIndex(i, csmHash<_KeyT>()(_keyValues[i].First));
+        }
+    }
+
+    /**
+     * @brief   ハッシュ表を解放する
+     */
+    void ReleaseIndex()
+    {
+        if (_indexSlots != NULL)
+        {
+            CSM_FREE(_indexSlots);
+        }
+        _indexSlots = NULL;
+        _indexCapacity = 0;
+    }
 
     csmPair<_KeyT, _ValT>* _keyValues;      ///< Key-Valueペアの配列
-    _ValT* _dummyValuePtr;                  ///< 空の値を返すためのダミー(staticのtemplteを回避するためメンバとする）
+    mutable _ValT* _dummyValuePtr;          ///< 空の値を返すためのダミー(staticのtemplteを回避するためメンバとする）
     csmInt32 _size;                         ///< コンテナの要素数（サイズ）
     csmInt32 _capacity;                     ///< コンテナのキャパシティ
+    IndexSlot* _indexSlots;                 ///< キー検索用のハッシュ表（要素が無い間はNULL。変更操作の中でのみ更新する）
+    csmInt32 _indexCapacity;                ///< ハッシュ表のスロット数
 };
 
 
@@ -584,11 +780,15 @@ csmMap<_KeyT, _ValT>::csmMap()
     , _dummyValuePtr(NULL)
     , _size(0)
     , _capacity(0)
+    , _indexSlots(NULL)
+    , _indexCapacity(0)
 { }
 
 template<class _KeyT, class _ValT>
 csmMap<_KeyT, _ValT>::csmMap(csmInt32 size)
     : _dummyValuePtr(NULL)
+    , _indexSlots(NULL)
+    , _indexCapacity(0)
 {
     if (size < 1)
     {
@@ -673,6 +873,8 @@ void csmMap<_KeyT, _ValT>::Clear()
 
     _size = 0;
     _capacity = 0;
+
+    ReleaseIndex();
 }
 }}}
 
@@ -12,111 +12,61 @@
 
 //--------- LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework {
-csmInt32 csmString::s_totalInstanceNo = 0;
-
-namespace {
-const csmChar* s_emptyString = "";
-
-csmChar* GetEmptyString()
-{
-    return const_cast<csmChar*>(s_emptyString);
-}
-}
 
 csmString::csmString()
-    : _ptr(NULL)
-    , _length(0)
+    : _length(0)
     , _hashcode(-1)
 {
     this->_small[0] = '\0';
-    _hashcode = CalcHashcode(WritePointer(), this->_length);
-    _instanceNo = s_totalInstanceNo++;
 }
 
 csmString::csmString(const csmChar* c)
 {
-    const csmInt32 count = static_cast<csmInt32>(strlen(c));
-
-    if (count)
-    {
-        Copy(c, count);
-        this->_hashcode = CalcHashcode(WritePointer(), _length);
-    }
-    else
-    {
-        SetEmpty();
-    }
-
-    _instanceNo = s_totalInstanceNo++;
+    Initialize(c, static_cast<csmInt32>(strlen(c)), false);
 }
 
 csmString::csmString(const csmString& s)
 {
-    if (!s.IsEmpty())
-    {
-        Copy(s.GetRawString(), s._length);
-        this->_hashcode = s._hashcode;
-    }
-    else
-    {
-        SetEmpty();
-    }
-
-    _instanceNo = s_totalInstanceNo++;
+    Copy(s.GetRawString(), s._length);
+    this->_hashcode.store(s._hashcode.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 csmString::csmString(const csmChar* s, csmInt32 length)
 {
-    if (length)
-    {
-        Copy(s, length);
-        this->_hashcode = CalcHashcode(WritePointer(), _length);
-    }
-    else
-    {
-        SetEmpty();
-    }
-
-    _instanceNo = s_totalInstanceNo++;
+    Initialize(s, length, false);
 }
 
 csmString::csmString(const csmChar* c, csmInt32 length, csmBool useptr)
 {
     Initialize(c, length, useptr);
-    _instanceNo = s_totalInstanceNo++;
 }
 
 void csmString::Initialize(const csmChar* c, csmInt32 length, csmBool usePtr)
 {
-    if (!length)
-    {
-        SetEmpty();
-
-        return;
-    }
-
-    if (!usePtr)
-    {
-        Copy(c, length);
-    }
-    else
+    if (usePtr && length >= SmallLength)
     {
         this->_ptr = const_cast<csmChar*>(c);
         this->_length = length;
         this->_ptr[length] = 0x0;
     }
+    else
+    {
+        Copy(c, length);
+
+        // 内部バッファに収まる場合は、引き取ったポインタをここで解放する
+        if (usePtr)
+        {
+            CSM_FREE(const_cast<csmChar*>(c));
+        }
+    }
 
-    this->_hashcode = CalcHashcode(this->GetRawString(), this->_length);
+    // ハッシュコードは必要になった時点で算出する
+    this->_hashcode.store(-1, std::memory_order_relaxed);
 }
 
 csmString::~csmString()
 {
-    if (IsEmpty())
-    {
-        return;
-    }
-
-    if (this->_ptr)
+    if (!IsSmall())
     {
         CSM_FREE(this->_ptr);
     }
@@ -124,13 +74,11 @@ csmString::~csmString()
 
 void csmString::Clear()
 {
-    if (IsEmpty())
+    if (!IsSmall())
     {
-        return;
+        CSM_FREE(this->_ptr);
     }
 
-    CSM_FREE(this->_ptr);
-
     SetEmpty();
 }
 
@@ -139,16 +87,20 @@ csmString& csmString::operator=(const csmChar* c)
     Clear(); //現在のポインタを開放してから処理する
 
     Copy(c, static_cast<csmInt32>(strlen(c)));
-    this->_hashcode = CalcHashcode(this->GetRawString(), this->_length);
     return *this;
 }
 
 csmString& csmString::operator=(const csmString& s)
 {
+    if (this == &s)
+    {
+        return *this;
+    }
+
     Clear(); //現在のポインタを開放してから処理する
 
     Copy(s.GetRawString(), s._length);
-    this->_hashcode = s._hashcode;
+    this->_hashcode.store(s._hashcode.load(std::memory_order_relaxed), std::memory_order_relaxed);
     return *this;
 }
 
@@ -163,7 +115,7 @@ csmString csmString::operator+(const csmString& s) const
         return ret;
     }
 
-    if (len1 + len2 < SmallLength - 1)
+    if (len1 + len2 < SmallLength)
     {
         csmChar buffer[SmallLength];
         csmChar* newptr = buffer;
@@ -200,7 +152,7 @@ csmString csmString::operator+(const csmChar* c) const
     csmSizeType len1 = static_cast<csmSizeType>(this->_length);
     csmSizeType len2 = strlen(c);
 
-    if (len1 + len2 < SmallLength - 1)
+    if (len1 + len2 < SmallLength)
     {
         csmChar buffer[SmallLength];
         csmChar* newptr = buffer;
@@ -236,7 +188,7 @@ csmString& csmString::operator+=(const csmString& s)
     csmChar* newptr = NULL;
     csmInt32 len1 = this->_length;
 
-    if (this->_length + s._length < SmallLength - 1)
+    if (this->_length + s._length < SmallLength)
     {
         csmChar buffer[SmallLength];
         newptr = buffer;
@@ -267,7 +219,7 @@ csmString& csmString::operator+=(const csmChar* c)
 
     csmChar* newptr = NULL;
 
-    if (len1 + len2 < SmallLength - 1)
+    if (len1 + len2 < SmallLength)
     {
         csmChar buffer[SmallLength];
         newptr = buffer;
@@ -296,8 +248,10 @@ csmBool csmString::operator==(const csmString& s) const
     //サイズ違い
     if (s._length != this->_length) return false;
 
-    //hashcode比較
-    if (this->_hashcode != s._hashcode) return false;
+    //hashcode比較（両方とも算出済みの場合のみ。比較のためだけに算出はしない）
+    const csmInt32 hashcode1 = this->_hashcode.load(std::memory_order_relaxed);
+    const csmInt32 hashcode2 = s._hashcode.load(std::memory_order_relaxed);
+    if (hashcode1 != -1 && hashcode2 != -1 && hashcode1 != hashcode2) return false;
 
     const csmChar* c1 = this->GetRawString();
     const csmChar* c2 = s.GetRawString();
@@ -351,7 +305,7 @@ csmString& csmString::Append(const csmChar* c, csmInt32 len2)
 
     csmChar* newptr = NULL;
 
-    if (len1 + len2 < SmallLength - 1)
+    if (len1 + len2 < SmallLength)
     {
         csmChar buffer[SmallLength];
         newptr = buffer;
@@ -381,7 +335,7 @@ csmString& csmString::Append(csmInt32 len2, const csmChar c)
 
     csmChar* newptr = NULL;
 
-    if(len1 + len2< SmallLength -1)
+    if (len1 + len2 < SmallLength)
     {
         csmChar buffer[SmallLength];
         newptr = buffer;
@@ -408,17 +362,10 @@ csmString& csmString::Append(csmInt32 len2, const csmChar c)
 
 void csmString::Copy(const csmChar* c, csmInt32 length)
 {
-    if (!length)
-    {
-        return;
-    }
-
     this->_length = length;
 
-    if (this->_length < SmallLength -1)
+    if (IsSmall())
     {
-        this->_ptr = NULL;
-
         memcpy(this->_small, c, length);
         this->_small[length] = 0x0;
     }
@@ -433,78 +380,54 @@ void csmString::Copy(const csmChar* c, csmInt32 length)
 
 csmInt32 csmString::CalcHashcode(const csmChar* c, csmInt32 length)
 {
-    csmInt32 hash = 0;
-    for (csmInt32 i = length; i >= 0; --i)
+    // 符号付き整数のオーバーフローを避けるため符号なしで計算する
+    csmUint32 hash = 0;
+    for (csmInt32 i = length - 1; i >= 0; --i)
     {
-        hash = hash * 31 + c[i];
+        hash = hash * 31 + static_cast<csmUint32>(c[i]);
     }
-    if ((hash == -1) || (c == GetEmptyString()))
+    if (static_cast<csmInt32>(hash) == -1)
     {
-        hash = -2; //-1だけ特別な意味をもたせる
+        hash = static_cast<csmUint32>(-2); //-1だけ特別な意味をもたせる（未算出）
     }
-    return hash;
+    return static_cast<csmInt32>(hash);
 }
 
 const csmChar* csmString::GetRawString() const
 {
-    if (this->_length < SmallLength -1)
-    {
-        return &_small[0];
-    }
-    else
-    {
-        return _ptr;
-    }
+    return IsSmall() ? _small : _ptr;
 }
 
-csmInt32 csmString::GetHashcode()
+csmInt32 csmString::GetHashcode() const
 {
-    if (_hashcode == -1) _hashcode = CalcHashcode(WritePointer(), this->_length);
-    return _hashcode;
+    // 同時に算出した場合も同じ値を書き込むだけなので、比較交換は不要
+    csmInt32 hashcode = _hashcode.load(std::memory_order_relaxed);
+    if (hashcode == -1)
+    {
+        hashcode = CalcHashcode(GetRawString(), this->_length);
+        _hashcode.store(hashcode, std::memory_order_relaxed);
+    }
+    return hashcode;
 }
 
 csmBool csmString::IsEmpty() const
 {
-#ifdef CSM_DEBUG
-
-    csmBool isEmpty = (_ptr == NULL && _small[0]=='\0');
-
-    if (isEmpty)
-    {
-        CSM_ASSERT(_length == 0);
-    }
-
-    return isEmpty;
-
-#else
-
-    //return (_ptr == GetEmptyString());
-
-    return (_ptr == NULL && _small[0] == '\0');
-
-#endif
+    return _length == 0;
 }
 
 void csmString::SetEmpty()
 {
-    //_ptr = GetEmptyString();
-    _ptr = NULL;
     _small[0] = '\0';
     _length = 0;
-    _hashcode = -1;
-    _hashcode = CalcHashcode(WritePointer(), this->_length);
+    _hashcode.store(-1, std::memory_order_relaxed);
 }
 
 csmChar* csmString::WritePointer()
 {
-    if(this->_length< SmallLength -1)
-    {
-        return _small;
-    }
-    else
-    {
-        return _ptr;
-    }
+    // 書き換えられる可能性があるためキャッシュを破棄する
+    _hashcode.store(-1, std::memory_order_relaxed);
+
+    return IsSmall() ? _small : _ptr;
 }
 
 }}}
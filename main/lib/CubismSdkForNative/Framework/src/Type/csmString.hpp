@@ -9,6 +9,7 @@
 
 #include "CubismFramework.hpp"
 #include <string.h>
+#include <atomic>
 
 //--------- LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework {
@@ -164,9 +165,11 @@ public:
     /**
      * @brief   ハッシュコードを取得する
      *
+     * 初回の呼び出し時に算出し、文字列が変更されるまでキャッシュする。
+     *
      * @return  ハッシュコード
      */
-    csmInt32 GetHashcode();
+    csmInt32 GetHashcode() const;
 
 
 protected:
@@ -180,7 +183,7 @@ protected:
     void Copy(const csmChar* c, csmInt32 length);
 
     /**
-     * @brief   csmStringインスタンスの初期化関数。文字列のセットとハッシュコードの算出を行う。
+     * @brief   csmStringインスタンスの初期化関数。文字列をセットし、ハッシュコードを未算出にする。
      *
      * @param[in]   c       ->  文字列のポインタ
      * @param[in]   length  ->  文字列の長さ
@@ -195,18 +198,28 @@ protected:
      * @param[in]   length  ->  ハッシュ値の長さ
      * @return      文字列から生成したハッシュ値
      */
-    csmInt32 CalcHashcode(const csmChar* c, csmInt32 length);
+    static csmInt32 CalcHashcode(const csmChar* c, csmInt32 length);
 
 private:
-    static const csmInt32 SmallLength = 64; ///< この長さ-1未満の文字列は内部バッファを使用
+    static const csmInt32 SmallLength = 48; ///< 内部バッファの長さ。終端を含めて収まる文字列（47文字以下）は内部バッファを使用
     static const csmInt32 DefaultSize = 10; ///< デフォルトの文字数
-    static csmInt32 s_totalInstanceNo;      ///< 通算のインスタンス番号
-    csmChar* _ptr;                          ///< 文字型配列のポインタ
     csmInt32 _length;                       ///< 半角文字数（メモリ確保は最後に0が入るため_length+1）
-    csmInt32 _hashcode;                     ///< インスタンスに当てられたハッシュ値
-    csmInt32 _instanceNo;                   ///< インスタンスに割り当てられた番号
+    mutable std::atomic<csmInt32> _hashcode; ///< インスタンスに当てられたハッシュ値。-1は未算出（const関数から複数スレッドで算出されるためatomic、relaxedで読み書きする）
+
+    // 内部バッファとヒープのポインタは同時に使わないため領域を共有する（sizeof(csmString)は64バイト）
+    union
+    {
+        csmChar* _ptr;                      ///< 文字型配列のポインタ（_lengthがSmallLength以上の場合）
+        csmChar _small[SmallLength];        ///< 文字列の長さがSmallLength未満の場合はこちらを使用
+    };
 
-    csmChar _small[SmallLength];            ///< 文字列の長さがSmallLength-1未満の場合はこちらを使用
+    /**
+     * @brief 内部バッファを使っているか？
+     *
+     * @retval  true    内部バッファを使用
+     * @retval  false   ヒープに確保した_ptrを使用
+     */
+    csmBool IsSmall() const { return _length < SmallLength; }
 
     /**
      * @brief 文字列が空かどうか？
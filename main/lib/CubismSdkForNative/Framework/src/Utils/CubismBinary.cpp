@@ -0,0 +1,219 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismBinary.hpp"
+#include <string.h>
+#include "Utils/CubismDebug.hpp"
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+namespace {
+
+/**
+ * @brief   バイナリ形式に対応する JSON の拡張子
+ */
+const csmChar* const SupportedExtensions[] =
+{
+    ".motion3.json",
+    ".exp3.json",
+    ".physics3.json",
+};
+
+csmUint32 AlignSize(csmUint32 size)
+{
+    return (size + CubismBinary::Alignment - 1) & ~(CubismBinary::Alignment - 1);
+}
+
+csmBool IsLittleEndian()
+{
+    const csmUint16 probe = 1;
+    return *reinterpret_cast<const csmUint8*>(&probe) == 1;
+}
+
+}
+
+csmBool CubismBinary::IsBinary(const csmByte* buffer, csmSizeInt size)
+{
+    if (buffer == NULL || size < sizeof(Header))
+    {
+        return false;
+    }
+
+    csmUint32 magic;
+    memcpy(&magic, buffer, sizeof(magic));
+
+    return magic == Magic;
+}
+
+const CubismBinary::Header* CubismBinary::GetHeader(const csmByte* buffer, csmSizeInt size, Kind kind)
+{
+    if (!IsBinary(buffer, size))
+    {
+        return NULL;
+    }
+
+    if (!IsLittleEndian())
+    {
+        CubismLogError("[CubismBinary] Binary assets are not supported on big-endian platforms.");
+        return NULL;
+    }
+
+    if ((reinterpret_cast<csmSizeType>(buffer) & (Alignment - 1)) != 0)
+    {
+        CubismLogError("[CubismBinary] Buffer is not aligned.");
+        return NULL;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(buffer);
+
+    if (header->Version != Version)
+    {
+        CubismLogError("[CubismBinary] Unsupported version %d (expected %d).", header->Version, Version);
+        return NULL;
+    }
+
+    if (header->Kind != kind)
+    {
+        CubismLogError("[CubismBinary] Unexpected kind %d (expected %d).", header->Kind, kind);
+        return NULL;
+    }
+
+    if (header->FileSize != size
+        || header->BodySize > size - sizeof(Header)
+        || header->StringTableOffset > size
+        || header->StringTableSize > size - header->StringTableOffset
+        || (header->StringTableOffset & (Alignment - 1)) != 0)
+    {
+        CubismLogError("[CubismBinary] Corrupted header.");
+        return NULL;
+    }
+
+    return header;
+}
+
+const csmChar* CubismBinary::GetString(const Header* header, csmUint32 offset)
+{
+    if (offset >= header->StringTableSize)
+    {
+        return NULL;
+    }
+
+    const csmChar* table = reinterpret_cast<const csmChar*>(header) + header->StringTableOffset;
+
+    // 文字列テーブル内で終端されていることを確認する
+    if (memchr(table + offset, '\0', header->StringTableSize - offset) == NULL)
+    {
+        return NULL;
+    }
+
+    return table + offset;
+}
+
+csmString CubismBinary::GetBinaryFileName(const csmChar* jsonFileName)
+{
+    const csmSizeInt length = static_cast<csmSizeInt>(strlen(jsonFileName));
+
+    for (csmUint32 i = 0; i < sizeof(SupportedExtensions) / sizeof(SupportedExtensions[0]); ++i)
+    {
+        const csmSizeInt extensionLength = static_cast<csmSizeInt>(strlen(SupportedExtensions[i]));
+
+        if (length > extensionLength && strcmp(jsonFileName + length - extensionLength, SupportedExtensions[i]) == 0)
+        {
+            // ".json" -> ".bin"
+            return csmString(jsonFileName, static_cast<csmInt32>(length) - 5) + ".bin";
+        }
+    }
+
+    return csmString("");
+}
+
+csmBool CubismBinary::IsRangeValid(const Header* header, csmUint32 offset, csmUint32 count, csmUint32 elementSize)
+{
+    if ((offset & (Alignment - 1)) != 0 || offset < sizeof(Header) || offset > header->FileSize)
+    {
+        return false;
+    }
+
+    // count * elementSize のオーバーフローを避けて比較する
+    const csmUint32 available = header->FileSize - offset;
+
+    return count <= available / elementSize;
+}
+
+CubismBinaryWriter::CubismBinaryWriter(CubismBinary::Kind kind, csmUint32 bodySize)
+    : _kind(kind)
+    , _bodySize(bodySize)
+{ }
+
+csmUint32 CubismBinaryWriter::AddArray(const void* data, csmUint32 bytes)
+{
+    const csmUint32 offset = sizeof(CubismBinary::Header) + AlignSize(_bodySize) + _arrays.GetSize();
+
+    if (bytes > 0)
+    {
+        const csmUint32 position = _arrays.GetSize();
+        _arrays.Resize(position + AlignSize(bytes), 0);
+        memcpy(_arrays.GetPtr() + position, data, bytes);
+    }
+
+    return offset;
+}
+
+csmUint32 CubismBinaryWriter::AddString(const csmChar* string)
+{
+    const csmString key(string);
+
+    if (_stringOffsets.IsExist(key))
+    {
+        return _stringOffsets[key];
+    }
+
+    const csmUint32 offset = _strings.GetSize();
+    const csmUint32 bytes = static_cast<csmUint32>(strlen(string)) + 1;
+    _strings.Resize(offset + bytes, 0);
+    memcpy(_strings.GetPtr() + offset, string, bytes);
+
+    _stringOffsets[key] = offset;
+
+    return offset;
+}
+
+void CubismBinaryWriter::Finish(const void* body, csmVector<csmByte>& output)
+{
+    const csmUint32 arraysOffset = sizeof(CubismBinary::Header) + AlignSize(_bodySize);
+    const csmUint32 stringTableOffset = arraysOffset + _arrays.GetSize();
+    const csmUint32 fileSize = stringTableOffset + AlignSize(_strings.GetSize());
+
+    CubismBinary::Header header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = CubismBinary::Magic;
+    header.Version = CubismBinary::Version;
+    header.Kind = static_cast<csmUint16>(_kind);
+    header.FileSize = fileSize;
+    header.BodySize = _bodySize;
+    header.StringTableOffset = stringTableOffset;
+    header.StringTableSize = _strings.GetSize();
+
+    output.Clear();
+    output.Resize(fileSize, 0);
+
+    csmByte* destination = output.GetPtr();
+    memcpy(destination, &header, sizeof(header));
+    memcpy(destination + sizeof(header), body, _bodySize);
+    if (_arrays.GetSize() > 0)
+    {
+        memcpy(destination + arraysOffset, _arrays.GetPtr(), _arrays.GetSize());
+    }
+    if (_strings.GetSize() > 0)
+    {
+        memcpy(destination + stringTableOffset, _strings.GetPtr(), _strings.GetSize());
+    }
+}
+
+}}}}
+//--------- LIVE2D NAMESPACE ------------
@@ -0,0 +1,193 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "Type/csmVector.hpp"
+#include "Type/csmMap.hpp"
+#include "Type/csmString.hpp"
+
+//--------- LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+/**
+ * @brief   モーション・表情・物理演算設定のバイナリ形式
+ *
+ * JSON をパースせずに読み込めるよう、実行時のデータをそのまま並べたリトルエンディアンの形式。
+ * ファイル先頭の Header の直後に種類ごとの本体（固定長の構造体）があり、
+ * 可変長の配列はファイル先頭からのオフセットと個数で参照する。
+ * 文字列（ID やイベントの値）は末尾の文字列テーブルにまとめ、テーブル先頭からのオフセットで参照する。
+ * オフセットはすべて 4 バイト境界に揃えるため、mmap したバッファからも直接読める。
+ *
+ * 形式を変更したときは Version を上げること。バージョンの異なるファイルは読み込まない。
+ */
+class CubismBinary
+{
+public:
+    /**
+     * @brief   格納しているデータの種類
+     */
+    enum Kind
+    {
+        Kind_Motion = 1,        ///< .motion3.json
+        Kind_Expression = 2,    ///< .exp3.json
+        Kind_Physics = 3        ///< .physics3.json
+    };
+
+    static const csmUint32 Magic = 0x42534D43;     ///< 先頭 4 バイト "CMSB"
+    static const csmUint16 Version = 1;             ///< 形式のバージョン
+    static const csmUint32 Alignment = 4;           ///< 配列・文字列テーブルのアラインメント
+
+    /**
+     * @brief   ファイルヘッダ（32 バイト）
+     */
+    struct Header
+    {
+        csmUint32 Magic;                ///< Magic
+        csmUint16 Version;              ///< Version
+        csmUint16 Kind;                 ///< Kind
+        csmUint32 FileSize;             ///< ファイル全体のバイト数
+        csmUint32 BodySize;             ///< ヘッダ直後の本体のバイト数
+        csmUint32 StringTableOffset;    ///< 文字列テーブルの位置（ファイル先頭から）
+        csmUint32 StringTableSize;      ///< 文字列テーブルのバイト数
+        csmUint32 Reserved[2];          ///< 予約（0）
+    };
+
+    /**
+     * @brief   バッファがバイナリ形式かどうかを先頭のマジックナンバーで判定する
+     *
+     * @param[in]   buffer  ->  ファイルの内容
+     * @param[in]   size    ->  バッファのサイズ
+     * @retval  true    ->  バイナリ形式
+     * @retval  false   ->  それ以外（JSON として扱う）
+     */
+    static csmBool IsBinary(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * @brief   ヘッダを検証して返す
+     *
+     * マジックナンバー、バージョン、種類、各領域の範囲と、実行環境がリトルエンディアンであることを確認する。
+     *
+     * @param[in]   buffer  ->  ファイルの内容（4 バイト境界に配置されていること）
+     * @param[in]   size    ->  バッファのサイズ
+     * @param[in]   kind    ->  期待する種類
+     * @return  ヘッダ。不正な場合は NULL
+     */
+    static const Header* GetHeader(const csmByte* buffer, csmSizeInt size, Kind kind);
+
+    /**
+     * @brief   本体を取得する
+     *
+     * @param[in]   header  ->  GetHeader で検証済みのヘッダ
+     * @return  本体。本体が T より小さい場合は NULL
+     */
+    template<class T>
+    static const T* GetBody(const Header* header)
+    {
+        if (header->BodySize < sizeof(T))
+        {
+            return NULL;
+        }
+
+        return reinterpret_cast<const T*>(reinterpret_cast<const csmByte*>(header) + sizeof(Header));
+    }
+
+    /**
+     * @brief   配列を取得する
+     *
+     * @param[in]   header  ->  GetHeader で検証済みのヘッダ
+     * @param[in]   offset  ->  配列の位置（ファイル先頭から）
+     * @param[in]   count   ->  要素数
+     * @return  配列の先頭。範囲外またはアラインメントが不正な場合は NULL
+     */
+    template<class T>
+    static const T* GetArray(const Header* header, csmUint32 offset, csmUint32 count)
+    {
+        if (!IsRangeValid(header, offset, count, sizeof(T)))
+        {
+            return NULL;
+        }
+
+        return reinterpret_cast<const T*>(reinterpret_cast<const csmByte*>(header) + offset);
+    }
+
+    /**
+     * @brief   文字列テーブルから文字列を取得する
+     *
+     * @param[in]   header  ->  GetHeader で検証済みのヘッダ
+     * @param[in]   offset  ->  文字列テーブル先頭からのオフセット
+     * @return  文字列。範囲外または終端されていない場合は NULL
+     */
+    static const csmChar* GetString(const Header* header, csmUint32 offset);
+
+    /**
+     * @brief   JSON ファイル名に対応するバイナリ形式のファイル名を返す
+     *
+     * .motion3.json / .exp3.json / .physics3.json の拡張子 .json を .bin に置き換える。
+     *
+     * @param[in]   jsonFileName    ->  JSON ファイル名
+     * @return  バイナリ形式のファイル名。対応しない種類の場合は空文字列
+     */
+    static csmString GetBinaryFileName(const csmChar* jsonFileName);
+
+private:
+    static csmBool IsRangeValid(const Header* header, csmUint32 offset, csmUint32 count, csmUint32 elementSize);
+};
+
+/**
+ * @brief   CubismBinary 形式のファイルを組み立てる
+ *
+ * 本体のサイズを指定して作成し、AddArray / AddString で可変長のデータを追加した後、
+ * Finish に本体を渡してファイルの内容を得る。
+ */
+class CubismBinaryWriter
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     *
+     * @param[in]   kind        ->  格納するデータの種類
+     * @param[in]   bodySize    ->  本体のバイト数
+     */
+    CubismBinaryWriter(CubismBinary::Kind kind, csmUint32 bodySize);
+
+    /**
+     * @brief   配列を追加する
+     *
+     * @param[in]   data    ->  配列の先頭
+     * @param[in]   bytes   ->  バイト数
+     * @return  配列の位置（ファイル先頭から）
+     */
+    csmUint32 AddArray(const void* data, csmUint32 bytes);
+
+    /**
+     * @brief   文字列を文字列テーブルに追加する（同じ文字列は共有する）
+     *
+     * @param[in]   string  ->  文字列
+     * @return  文字列テーブル先頭からのオフセット
+     */
+    csmUint32 AddString(const csmChar* string);
+
+    /**
+     * @brief   ファイルの内容を出力する
+     *
+     * @param[in]   body    ->  本体（コンストラクタで指定したバイト数）
+     * @param[out]  output  ->  ファイルの内容
+     */
+    void Finish(const void* body, csmVector<csmByte>& output);
+
+private:
+    CubismBinary::Kind _kind;                   ///< 種類
+    csmUint32 _bodySize;                        ///< 本体のバイト数
+    csmVector<csmByte> _arrays;                 ///< 本体以降の配列
+    csmVector<csmByte> _strings;                ///< 文字列テーブル
+    csmMap<csmString, csmUint32> _stringOffsets;    ///< 追加済みの文字列のオフセット
+};
+
+}}}}
+//--------- LIVE2D NAMESPACE ------------
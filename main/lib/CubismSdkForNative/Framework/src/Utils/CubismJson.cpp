@@ -15,6 +15,62 @@ using namespace std; // for strtof
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
 
+namespace {
+
+const csmSizeInt ArenaAlignment = 16;           ///< アリーナから確保する領域のアラインメント
+const csmSizeInt ArenaMinimumBlockSize = 4096;  ///< アリーナのブロックの最小サイズ
+
+csmSizeInt AlignArenaSize(csmSizeInt size)
+{
+    return (size + ArenaAlignment - 1) & ~(ArenaAlignment - 1);
+}
+
+/**
+ * @brief   ソースのパースに必要なアリーナのサイズを見積もる
+ *
+ * 区切り文字を数えて要素数を求め、要素の種類ごとの最大サイズを掛ける。
+ * 文字列中の区切り文字も数えるため見積もりは実際より少し大きくなるが、
+ * ソースの長さに一定の倍率を掛けるよりも、数値の少ないファイルでの余りがずっと小さい。
+ *
+ * @param[in]   source  JSONのソース
+ * @param[in]   size    ソースのバイト数
+ *
+ * @return  ソースのコピーとすべての要素が収まるバイト数
+ */
+csmSizeInt EstimateArenaSize(const csmChar* source, csmInt32 size)
+{
+    csmSizeInt separators = 0;    // ',' の数
+    csmSizeInt containers = 0;    // '[' と '{' の数
+    csmSizeInt keys = 0;          // ':' の数（オブジェクトの要素数）
+    csmSizeInt quotes = 0;        // '"' の数（キーと文字列の値の2倍）
+
+    // 分岐のない比較の加算にしてコンパイラがベクトル化できるようにする
+    for (csmInt32 i = 0; i < size; ++i)
+    {
+        const csmChar c = source[i];
+        separators += (c == ',');
+        containers += (c == '[') + (c == '{');
+        keys += (c == ':');
+        quotes += (c == '"');
+    }
+
+    // 要素は区切りの数 + 配列・オブジェクトの数 + 1（ルート）以下
+    const csmSizeInt values = separators + containers + 1;
+    const csmSizeInt items = values - 1;
+    const csmSizeInt elements = (keys < items) ? keys : items;
+    const csmSizeInt scalars = values - containers;
+    const csmSizeInt strings = (quotes / 2 > keys) ? quotes / 2 - keys : 0;
+    const csmSizeInt stringValues = (strings < scalars) ? strings : scalars;
+
+    return AlignArenaSize(size + 1)
+        + stringValues * AlignArenaSize(sizeof(ArenaString))                              // 文字列の値
+        + (scalars - stringValues) * AlignArenaSize(sizeof(Float))                        // 数値・真偽値・null（Float が最大）
+        + containers * (AlignArenaSize(sizeof(ArenaMap)) + ArenaAlignment)                // 配列・オブジェクトと子の配列の端数
+        + elements * sizeof(ArenaMapEntry) + (items - elements) * sizeof(Value*);        // オブジェクトの要素と配列の要素
+}
+
+}
+
 //StaticInitializeNotForClientCall()で初期化する
 Boolean* Boolean::TrueValue = NULL;
 Boolean* Boolean::FalseValue = NULL;
@@ -52,12 +108,18 @@ CubismJson::CubismJson()
     : _error(NULL)
     , _lineCount(0)
     , _root(NULL)
+    , _mode(ParseMode_Heap)
+    , _arena(NULL)
+    , _source(NULL)
 { }
 
 CubismJson::CubismJson(const csmByte* buffer, csmInt32 length)
     : _error(NULL)
     , _lineCount(0)
     , _root(NULL)
+    , _mode(ParseMode_Heap)
+    , _arena(NULL)
+    , _source(NULL)
 {
     ParseBytes(buffer, length);
 }
@@ -66,10 +128,20 @@ CubismJson::~CubismJson()
 {
     if (_root && !_root->IsStatic())
     {
-        CSM_DELETE(_root);
+        if (_mode == ParseMode_Arena)
+        {
+            // 要素はアリーナ上にあるのでデストラクタだけ呼び、領域はまとめて解放する
+            _root->~Value();
+        }
+        else
+        {
+            CSM_DELETE(_root);
+        }
     }
 
     _root = NULL;
+
+    ReleaseArena();
 }
 
 void CubismJson::Delete(CubismJson* instance)
@@ -78,9 +150,10 @@ void CubismJson::Delete(CubismJson* instance)
 }
 
 
-CubismJson* CubismJson::Create(const csmByte* buffer, csmSizeInt size)
+CubismJson* CubismJson::Create(const csmByte* buffer, csmSizeInt size, ParseMode mode)
 {
     CubismJson* json = CSM_NEW CubismJson();
+    json->_mode = mode;
     const csmBool succeeded = json->ParseBytes(buffer, size);
 
     if (!succeeded)
@@ -103,31 +176,177 @@ Value& CubismJson::GetRoot() const
 
 csmBool CubismJson::ParseBytes(const csmByte* buffer, csmInt32 size)
 {
+    const csmChar* source = reinterpret_cast<const csmChar*>(buffer);
+
+    if (_mode == ParseMode_Arena)
+    {
+        // 要素数から見積もったサイズで確保し、最初のブロックでほぼ収まるようにする
+        AddArenaBlock(EstimateArenaSize(source, size));
+
+        // 文字列要素はこのコピーを直接参照する（終端文字の書き込みとエスケープの展開もこの上で行う）
+        _source = static_cast<csmChar*>(ArenaAllocate(size + 1));
+        memcpy(_source, buffer, size);
+        _source[size] = '\0';
+        source = _source;
+
+        // 作業用スタックの伸長を避ける（要素数はソース 8 バイトあたり 1 個程度を見込む）
+        _arenaValues.PrepareCapacity(size / 8 + 16);
+        _arenaEntries.PrepareCapacity(64);
+    }
+
     csmInt32 endPos;
-    _root = ParseValue(reinterpret_cast<const csmChar*>(buffer), size, 0, &endPos);
+    _root = ParseValue(source, size, 0, &endPos);
+
+    // パース中の作業領域はもう使わない
+    _arenaValues.Clear();
+    _arenaEntries.Clear();
 
     if (_error)
     {
 #if defined(CSM_TARGET_WIN_GL) || defined(_MSC_VER)
         csmChar strbuf[256] = {'\0'};
         _snprintf_s(strbuf, 256, 256, "Json parse error : @line %d\n", (_lineCount + 1));
-        _root = CSM_NEW String(strbuf);
 #else
         csmChar strbuf[256] = { '\0' };
         snprintf(strbuf, 256, "Json parse error : @line %d\n", (_lineCount + 1));
-        _root = CSM_NEW String(strbuf);
 #endif
+        _root = (_mode == ParseMode_Arena)
+            ? CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(String))) String(strbuf)
+            : CSM_NEW String(strbuf);
         CubismLogInfo("%s", _root->GetRawString());
         return false;
     }
     else if (_root == NULL)
     {
-        _root = CSM_NEW Error(_error, false); //rootは開放されるのでエラーオブジェクトを別途作る
+        //rootは開放されるのでエラーオブジェクトを別途作る
+        _root = (_mode == ParseMode_Arena)
+            ? CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(Error))) Error("", false)
+            : CSM_NEW Error("", false);
         return false;
     }
     return true;
 }
 
+void* CubismJson::ArenaAllocate(csmSizeInt size)
+{
+    size = AlignArenaSize(size);
+
+    if (_arena == NULL || _arena->Size - _arena->Used < size)
+    {
+        // 足りなければ直前のブロックの倍のブロックを追加する
+        const csmSizeInt nextSize = (_arena != NULL) ? _arena->Size * 2 : 0;
+        AddArenaBlock((size > nextSize) ? size : nextSize);
+    }
+
+    csmByte* data = reinterpret_cast<csmByte*>(_arena) + AlignArenaSize(sizeof(ArenaBlock)) + _arena->Used;
+    _arena->Used += size;
+
+    return data;
+}
+
+void CubismJson::AddArenaBlock(csmSizeInt size)
+{
+    size = AlignArenaSize(size);
+    if (size < ArenaMinimumBlockSize)
+    {
+        size = ArenaMinimumBlockSize;
+    }
+
+    ArenaBlock* block = static_cast<ArenaBlock*>(CSM_MALLOC_ALLIGNED(AlignArenaSize(sizeof(ArenaBlock)) + size, ArenaAlignment));
+    block->Next = _arena;
+    block->Size = size;
+    block->Used = 0;
+
+    _arena = block;
+}
+
+void CubismJson::ReleaseArena()
+{
+    while (_arena != NULL)
+    {
+        ArenaBlock* next = _arena->Next;
+        CSM_FREE_ALLIGNED(_arena);
+        _arena = next;
+    }
+
+    _source = NULL;
+}
+
+csmInt32 CubismJson::ScanString(csmInt32 begin, csmInt32 length, csmInt32* outEndPos, csmBool* outHasEscape)
+{
+    if (_error)
+    {
+        return 0;
+    }
+
+    *outHasEscape = false;
+
+    // エラー条件は ParseString と同じ
+    for (csmInt32 i = begin; i < length; i++)
+    {
+        switch (_source[i])
+        {
+        case '\"':
+            *outEndPos = i + 1;
+            _source[i] = '\0';
+            return i - begin;
+        case '\\':
+            i++;
+            *outHasEscape = true;
+
+            if (i < length)
+            {
+                if (_source[i] == 'u')
+                {
+                    _error = "parse string/unicode escape not supported";
+                }
+            }
+            else
+            {
+                _error = "parse string/escape error";
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    _error = "parse string/illegal end";
+    return 0;
+}
+
+Value* CubismJson::CreateArenaArray(csmInt32 valueBegin)
+{
+    const csmInt32 count = _arenaValues.GetSize() - valueBegin;
+    Value** items = NULL;
+
+    if (count > 0)
+    {
+        items = static_cast<Value**>(ArenaAllocate(sizeof(Value*) * count));
+        memcpy(items, &_arenaValues[valueBegin], sizeof(Value*) * count);
+    }
+
+    _arenaValues.UpdateSize(valueBegin, NULL, false);
+
+    return CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(ArenaArray))) ArenaArray(items, count);
+}
+
+Value* CubismJson::CreateArenaMap(csmInt32 entryBegin)
+{
+    const csmInt32 count = _arenaEntries.GetSize() - entryBegin;
+    ArenaMapEntry* entries = NULL;
+
+    if (count > 0)
+    {
+        entries = static_cast<ArenaMapEntry*>(ArenaAllocate(sizeof(ArenaMapEntry) * count));
+        memcpy(entries, &_arenaEntries[entryBegin], sizeof(ArenaMapEntry) * count);
+    }
+
+    _arenaEntries.UpdateSize(entryBegin, ArenaMapEntry(), false);
+
+    return CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(ArenaMap))) ArenaMap(entries, count);
+}
+
 
 csmString CubismJson::ParseString(const csmChar* string, csmInt32 length, csmInt32 begin, csmInt32* outEndPos)
 {
@@ -269,6 +488,10 @@ Value* CubismJson::ParseNumeric(const csmChar* buffer, csmInt32 length, csmInt32
                 {
                     ret *= -1;
                 }
+                if (_mode == ParseMode_Arena)
+                {
+                    return CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(Float))) Float(ret);
+                }
                 return CSM_NEW Float(ret);
             }
         case '\r': break;  // CRLF スキップ用
@@ -298,7 +521,11 @@ Value* CubismJson::ParseObject(const csmChar* buffer, csmInt32 length, csmInt32
         return NULL;
     }
 
-    Map* ret = CSM_NEW Map();
+    // アリーナモードでは要素を _arenaEntries に積み、閉じカッコでまとめてマップにする
+    const csmBool isArena = (_mode == ParseMode_Arena);
+    Map* ret = isArena ? NULL : CSM_NEW Map();
+    const csmInt32 entryBegin = _arenaEntries.GetSize();
+    ArenaMapEntry entry;
 
     //key : value ,
     csmString key;
@@ -314,14 +541,29 @@ Value* CubismJson::ParseObject(const csmChar* buffer, csmInt32 length, csmInt32
             switch (buffer[i])
             {
             case '\"':
-                key = ParseString(buffer, length, i + 1, local_ret_endpos2);
-                if (_error) return NULL;
+                if (isArena)
+                {
+                    // キーは検索に使うのでその場で展開しておく
+                    csmBool hasEscape;
+                    entry.Key = _source + i + 1;
+                    entry.KeyLength = ScanString(i + 1, length, local_ret_endpos2, &hasEscape);
+                    if (_error) return NULL;
+                    if (hasEscape)
+                    {
+                        entry.KeyLength = ArenaString::UnescapeInPlace(_source + i + 1, entry.KeyLength);
+                    }
+                }
+                else
+                {
+                    key = ParseString(buffer, length, i + 1, local_ret_endpos2);
+                    if (_error) return NULL;
+                }
                 i = local_ret_endpos2[0];
                 ok = true;
                 goto BREAK_LOOP1; //-- loopから出る
             case '}': //閉じカッコ
                 *outEndPos = i + 1;
-                return ret; //空
+                return isArena ? CreateArenaMap(entryBegin) : ret; //空
             case ':':
                 _error = "illegal ':' position";
                 break;
@@ -371,7 +613,15 @@ Value* CubismJson::ParseObject(const csmChar* buffer, csmInt32 length, csmInt32
         }
         i = local_ret_endpos2[0];
         // ret.put( key , value ) ;
-        ret->Put(key, value);
+        if (isArena)
+        {
+            entry.Item = (value != NULL) ? value : Value::NullValue;
+            _arenaEntries.PushBack(entry);
+        }
+        else
+        {
+            ret->Put(key, value);
+        }
 
         for (; i < length; i++)
         {
@@ -381,7 +631,7 @@ Value* CubismJson::ParseObject(const csmChar* buffer, csmInt32 length, csmInt32
                 goto BREAK_LOOP3;
             case '}':
                 *outEndPos = i + 1;
-                return ret; // << [] 正常終了 >>
+                return isArena ? CreateArenaMap(entryBegin) : ret; // << [] 正常終了 >>
             case '\n': _lineCount++;
                 //case ' ': case '\t': case '\r':
             default: break; //スキップ
@@ -409,7 +659,10 @@ Value* CubismJson::ParseArray(const csmChar* buffer, csmInt32 length, csmInt32 b
         return NULL;
     }
 
-    Array* ret = CSM_NEW Array();
+    // アリーナモードでは要素を _arenaValues に積み、閉じカッコでまとめて配列にする
+    const csmBool isArena = (_mode == ParseMode_Arena);
+    Array* ret = isArena ? NULL : CSM_NEW Array();
+    const csmInt32 valueBegin = _arenaValues.GetSize();
 
     //key : value ,
     csmInt32 i = begin;
@@ -427,7 +680,14 @@ Value* CubismJson::ParseArray(const csmChar* buffer, csmInt32 length, csmInt32 b
         i = local_ret_endpos2[0];
         if (value)
         {
-            ret->Add(value);
+            if (isArena)
+            {
+                _arenaValues.PushBack(value);
+            }
+            else
+            {
+                ret->Add(value);
+            }
         }
 
         //FOR_LOOP3:
@@ -442,7 +702,7 @@ Value* CubismJson::ParseArray(const csmChar* buffer, csmInt32 length, csmInt32 b
                 goto BREAK_LOOP3;
             case ']':
                 *outEndPos = i + 1;
-                return ret; //終了
+                return isArena ? CreateArenaArray(valueBegin) : ret; //終了
             case '\n': ++_lineCount;
                 //case ' ': case '\t': case '\r':
             default: break; //スキップ
@@ -452,7 +712,10 @@ Value* CubismJson::ParseArray(const csmChar* buffer, csmInt32 length, csmInt32 b
         ; //dummy
     }
 
-    CSM_DELETE(ret);
+    if (!isArena)
+    {
+        CSM_DELETE(ret);
+    }
     _error = "illegal end of parseObject";
     return NULL;
 }
@@ -485,6 +748,14 @@ Value* CubismJson::ParseValue(const csmChar* buffer, csmInt32 length, csmInt32 b
         case '5': case '6': case '7': case '8': case '9':
             return ParseNumeric(buffer, length, i, outEndPos);
         case '\"':
+            if (_mode == ParseMode_Arena)
+            {
+                // ソースのコピーを参照するだけで、エスケープは参照されたときに展開する
+                csmBool hasEscape;
+                const csmInt32 stringLength = ScanString(i + 1, length, outEndPos, &hasEscape);
+                if (_error) return NULL;
+                return CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(ArenaString))) ArenaString(_source + i + 1, stringLength, hasEscape);
+            }
             return CSM_NEW String(ParseString(buffer, length, i + 1, outEndPos)); //\"の次の文字から
         case '[':
             o = ParseArray(buffer, length, i + 1, outEndPos);
@@ -495,7 +766,9 @@ Value* CubismJson::ParseValue(const csmChar* buffer, csmInt32 length, csmInt32 b
         case 'n': //null以外にない
             if (i + 3 < length)
             {
-                o = CSM_NEW NullValue(); //開放できるようにする
+                o = (_mode == ParseMode_Arena)
+                    ? CSM_PLACEMENT_NEW(ArenaAllocate(sizeof(NullValue))) NullValue()
+                    : CSM_NEW NullValue(); //開放できるようにする
                 *outEndPos = i + 4;
             }
             else _error = "parse null";
@@ -566,5 +839,167 @@ Array::~Array()
         }
     }
 }
+
+csmInt32 ArenaString::UnescapeInPlace(csmChar* chars, csmInt32 length)
+{
+    // 展開の規則は CubismJson::ParseString と同じ（未対応のエスケープは読み飛ばす）
+    csmInt32 written = 0;
+
+    for (csmInt32 i = 0; i < length; i++)
+    {
+        if (chars[i] != '\\')
+        {
+            chars[written++] = chars[i];
+            continue;
+        }
+
+        i++;
+        if (i >= length)
+        {
+            break;
+        }
+
+        switch (chars[i])
+        {
+        case '\\': chars[written++] = '\\';
+            break;
+        case '\"': chars[written++] = '\"';
+            break;
+        case '/': chars[written++] = '/';
+            break;
+        case 'b': chars[written++] = '\b';
+            break;
+        case 'f': chars[written++] = '\f';
+            break;
+        case 'n': chars[written++] = '\n';
+            break;
+        case 'r': chars[written++] = '\r';
+            break;
+        case 't': chars[written++] = '\t';
+            break;
+        default:
+            break;
+        }
+    }
+
+    chars[written] = '\0';
+    return written;
+}
+
+
+ArenaArray::~ArenaArray()
+{
+    for (csmInt32 i = 0; i < _count; ++i)
+    {
+        if (!_items[i]->IsStatic())
+        {
+            _items[i]->~Value();
+        }
+    }
+
+    if (_vector)
+    {
+        CSM_DELETE(_vector);
+    }
+}
+
+const csmString& ArenaArray::GetString(const csmString& /*defaultValue*/, const csmString& indent)
+{
+    _stringBuffer = indent + "[\n";
+    for (csmInt32 i = 0; i < _count; ++i)
+    {
+        _stringBuffer += indent + "	" + _items[i]->GetString(indent + "	") + "\n";
+    }
+    _stringBuffer += indent + "]\n";
+
+    return _stringBuffer;
+}
+
+csmVector<Value*>* ArenaArray::GetVector(csmVector<Value*>* /*defaultValue*/)
+{
+    if (!_vector)
+    {
+        _vector = CSM_NEW csmVector<Value*>(_count);
+        for (csmInt32 i = 0; i < _count; ++i)
+        {
+            _vector->PushBack(_items[i], false);
+        }
+    }
+
+    return _vector;
+}
+
+
+ArenaMap::~ArenaMap()
+{
+    for (csmInt32 i = 0; i < _count; ++i)
+    {
+        if (!_entries[i].Item->IsStatic())
+        {
+            _entries[i].Item->~Value();
+        }
+    }
+
+    if (_map)
+    {
+        CSM_DELETE(_map);
+    }
+
+    if (_keys)
+    {
+        CSM_DELETE(_keys);
+    }
+}
+
+const csmString& ArenaMap::GetString(const csmString& /*defaultValue*/, const csmString& indent)
+{
+    csmMap<csmString, Value*>* map = GetMap();
+
+    _stringBuffer = indent + "{\n";
+    csmMap<csmString, Value*>::const_iterator ite = map->Begin();
+    while (ite != map->End())
+    {
+        const csmString& key = (*ite).First;
+        Value* v = (*ite).Second;
+
+        _stringBuffer += indent + "	" + key + " : " + v->GetString(indent + "	") + "\n";
+        ++ite;
+    }
+    _stringBuffer += indent + "}\n";
+    return _stringBuffer;
+}
+
+csmMap<csmString, Value*>* ArenaMap::GetMap(csmMap<csmString, Value*>* /*defaultValue*/)
+{
+    if (!_map)
+    {
+        // 同じキーは後の値で上書きされる（Map::Put と同じ）
+        _map = CSM_NEW csmMap<csmString, Value*>();
+        for (csmInt32 i = 0; i < _count; ++i)
+        {
+            (*_map)[csmString(_entries[i].Key, _entries[i].KeyLength)] = _entries[i].Item;
+        }
+    }
+
+    return _map;
+}
+
+csmVector<csmString>& ArenaMap::GetKeys()
+{
+    if (!_keys)
+    {
+        csmMap<csmString, Value*>* map = GetMap();
+
+        _keys = CSM_NEW csmVector<csmString>();
+        csmMap<csmString, Value*>::const_iterator ite = map->Begin();
+        while (ite != map->End())
+        {
+            _keys->PushBack((*ite).First, true);
+            ++ite;
+        }
+    }
+
+    return *_keys;
+}
 }}}}
 //------------ LIVE2D NAMESPACE ------------
@@ -233,6 +233,16 @@ private:
 
 };
 
+/**
+ * @brief   アリーナモードでパース中のオブジェクトのキーと値
+ */
+struct ArenaMapEntry
+{
+    const csmChar*  Key;        ///< キー（ソースのコピー上で終端済み）
+    csmInt32        KeyLength;  ///< キーの長さ
+    Value*          Item;       ///< 値
+};
+
 /**
  * @brief   Ascii文字のみ対応した最小限の軽量JSONパーサ。<br>
  *           仕様はJSONのサブセットとなる。<br>
@@ -245,15 +255,30 @@ private:
 class CubismJson
 {
 public:
+    /**
+     * @brief   パース結果の確保方法
+     */
+    enum ParseMode
+    {
+        ParseMode_Heap,     ///< 要素ごとに CSM_NEW で確保し、文字列は csmString にコピーする
+        ParseMode_Arena     ///< 要素をインスタンス専用のアリーナから確保し、文字列はソースのコピーを参照する
+    };
+
     /**
      * @brief  バイトデータから直接ロードしてパースする<br>
      *          引数 buffer は外部で管理（破棄）する必要がある
      *
+     * ParseMode_Arena ではソースを一度だけアリーナにコピーし、文字列要素はそのコピーを直接参照する
+     * （エスケープの展開は最初に参照したときにその場で行う）。
+     * 要素はすべて同じアリーナに置かれ、Delete でまとめて解放される。
+     * どちらのモードでも Value の API と結果は変わらない。
+     *
      * @param   buffer  ->  バイトデータのバッファ
      * @param   size    ->  バッファサイズ
+     * @param   mode    ->  パース結果の確保方法
      * @return  CubismJsonクラスのインスタンス。失敗したらNULL。
      */
-    static CubismJson* Create(const csmByte* buffer, csmSizeInt size);
+    static CubismJson* Create(const csmByte* buffer, csmSizeInt size, ParseMode mode = ParseMode_Arena);
 
     /**
     * @brief   パースしたJSONオブジェクトの解放処理
@@ -348,6 +373,34 @@ protected:
      */
     Value* ParseValue(const csmChar* buffer, csmInt32 length, csmInt32 begin, csmInt32* outEndPos);
 
+    /**
+     * @brief   アリーナモードで次の「"」までの文字列を走査する<br>
+     *           閉じる「"」を終端文字に置き換え、エスケープの展開は行わない。
+     *
+     * @param[in]   begin       ->  パースを開始する位置
+     * @param[in]   length      ->  パースする長さ
+     * @param[out]  outEndPos   ->  パース終了時の位置
+     * @param[out]  outHasEscape    ->  エスケープを含むか
+     * @return      エスケープ展開前の文字列の長さ
+     */
+    csmInt32 ScanString(csmInt32 begin, csmInt32 length, csmInt32* outEndPos, csmBool* outHasEscape);
+
+    /**
+     * @brief   アリーナモードでパース中の配列要素をアリーナに移して配列を作る
+     *
+     * @param[in]   valueBegin  ->  この配列の要素の _arenaValues 上の開始位置
+     * @return      配列要素
+     */
+    Value* CreateArenaArray(csmInt32 valueBegin);
+
+    /**
+     * @brief   アリーナモードでパース中のオブジェクト要素をアリーナに移してマップを作る
+     *
+     * @param[in]   entryBegin  ->  このオブジェクトの要素の _arenaEntries 上の開始位置
+     * @return      マップ要素
+     */
+    Value* CreateArenaMap(csmInt32 entryBegin);
+
 private:
     /**
     * @brief   コンストラクタ
@@ -368,9 +421,45 @@ private:
     */
     virtual ~CubismJson();
 
+    /**
+     * @brief   アリーナのブロック
+     */
+    struct ArenaBlock
+    {
+        ArenaBlock*     Next;       ///< 前に確保したブロック
+        csmSizeInt      Size;       ///< データ部のバイト数
+        csmSizeInt      Used;       ///< 使用済みのバイト数
+    };
+
+    /**
+     * @brief   アリーナから確保する（個別の解放はできない）
+     *
+     * @param[in]   size    ->  バイト数
+     * @return      16バイト境界に揃えた領域
+     */
+    void* ArenaAllocate(csmSizeInt size);
+
+    /**
+     * @brief   アリーナにブロックを追加する
+     *
+     * @param[in]   size    ->  データ部のバイト数
+     */
+    void AddArenaBlock(csmSizeInt size);
+
+    /**
+     * @brief   アリーナをすべて解放する
+     */
+    void ReleaseArena();
+
     const csmChar*  _error;         ///< パース時のエラー
     csmInt32        _lineCount;     ///< エラー報告に用いる行数カウント
     Value*          _root;          ///< パースされたルート要素
+
+    ParseMode       _mode;          ///< パース結果の確保方法
+    ArenaBlock*     _arena;         ///< 最後に確保したアリーナのブロック
+    csmChar*        _source;        ///< アリーナモードでのソースのコピー（終端済み）
+    csmVector<Value*>           _arenaValues;   ///< パース中の配列要素（入れ子の配列で共有するスタック）
+    csmVector<ArenaMapEntry>    _arenaEntries;  ///< パース中のオブジェクト要素（同上）
 };
 
 
@@ -902,6 +991,304 @@ private:
     csmMap<csmString, Value*> _map;     ///< JSON要素の値
     csmVector<csmString>* _keys;        ///< JSON要素の値
 };
+
+
+/**
+ * @brief   アリーナモードの文字列要素<br>
+ *           CubismJson が保持するソースのコピーを直接参照する。
+ *           エスケープは最初に参照されたときにその場で展開する。
+ */
+class ArenaString : public Value
+{
+public:
+    /**
+     * @brief   引数付きコンストラクタ
+     *
+     * @param[in]   chars       ->  ソースのコピー上の文字列の先頭（終端済み）
+     * @param[in]   length      ->  エスケープ展開前の長さ
+     * @param[in]   hasEscape   ->  エスケープを含むか
+     */
+    ArenaString(csmChar* chars, csmInt32 length, csmBool hasEscape)
+        : Value()
+        , _chars(chars)
+        , _length(length)
+        , _hasEscape(hasEscape)
+        , _isBuffered(false) {}
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~ArenaString() {}
+
+    /**
+     *@brief Valueの種類が文字列ならtrue。
+     */
+    virtual csmBool IsString() { return true; }
+
+    /**
+     * @brief   要素を文字列で返す(csmString型)<br>
+     *           初回だけ csmString を作る。
+     */
+    virtual const csmString& GetString(const csmString& defaultValue = "", const csmString& indent = "")
+    {
+        if (!_isBuffered)
+        {
+            Unescape();
+            _stringBuffer = csmString(_chars, _length);
+            _isBuffered = true;
+        }
+        return _stringBuffer;
+    }
+
+    /**
+     * @brief   要素を文字列で返す(csmChar*)<br>
+     *           ソースのコピーを直接返すので確保は発生しない。
+     */
+    virtual const csmChar* GetRawString(const csmString& defaultValue = "", const csmString& indent = "")
+    {
+        Unescape();
+        return _chars;
+    }
+
+    /**
+     *@brief 引数の値と等しければtrue。
+     */
+    virtual csmBool Equals(const csmString& v)
+    {
+        Unescape();
+        return v.GetLength() == _length && memcmp(v.GetRawString(), _chars, _length) == 0;
+    }
+
+    /**
+     *@brief 引数の値と等しければtrue。
+     */
+    virtual csmBool Equals(const csmChar* v)
+    {
+        Unescape();
+        return strcmp(v, _chars) == 0;
+    }
+
+    /**
+     *@brief 引数の値と等しければtrue。
+     */
+    virtual csmBool Equals(csmInt32 v) { return false; }
+
+    /**
+     *@brief 引数の値と等しければtrue。
+     */
+    virtual csmBool Equals(csmFloat32 v) { return false; }
+
+    /**
+     *@brief 引数の値と等しければtrue。
+     */
+    virtual csmBool Equals(csmBool v) { return false; }
+
+    /**
+     * @brief   エスケープ文字列をその場で展開する（展開後は短くなるので上書きできる）
+     *
+     * @param[in,out]   chars   ->  文字列
+     * @param[in]       length  ->  展開前の長さ
+     * @return  展開後の長さ
+     */
+    static csmInt32 UnescapeInPlace(csmChar* chars, csmInt32 length);
+
+private:
+    /**
+     * @brief   未展開のエスケープがあれば展開する
+     */
+    void Unescape()
+    {
+        if (_hasEscape)
+        {
+            _length = UnescapeInPlace(_chars, _length);
+            _hasEscape = false;
+        }
+    }
+
+    csmChar*    _chars;         ///< ソースのコピー上の文字列
+    csmInt32    _length;        ///< 文字列の長さ
+    csmBool     _hasEscape;     ///< エスケープが未展開か
+    csmBool     _isBuffered;    ///< _stringBuffer を作成済みか
+};
+
+
+/**
+ * @brief   アリーナモードの配列要素<br>
+ *           要素の配列もアリーナ上に置く。GetVector() は初回呼び出し時に csmVector を作る。
+ */
+class ArenaArray : public Value
+{
+public:
+    /**
+     * @brief   引数付きコンストラクタ
+     *
+     * @param[in]   items   ->  アリーナ上の要素の配列
+     * @param[in]   count   ->  要素数
+     */
+    ArenaArray(Value** items, csmInt32 count)
+        : Value()
+        , _items(items)
+        , _count(count)
+        , _vector(NULL) {}
+
+    /**
+     * @brief   デストラクタ<br>
+     *           要素はアリーナ上にあるのでデストラクタだけ呼ぶ。
+     */
+    virtual ~ArenaArray();
+
+    /**
+     *@brief Valueの種類が配列ならtrue。
+     */
+    virtual csmBool IsArray() { return true; }
+
+    /**
+     * @brief   添字演算子[csmInt32]
+     */
+    virtual Value& operator[](csmInt32 index)
+    {
+        if (index < 0 || _count <= index)
+        {
+            return *(ErrorValue->SetErrorNotForClientCall(CSM_JSON_ERROR_INDEX_OUT_OF_BOUNDS));
+        }
+        return *_items[index];
+    }
+
+    /**
+     * @brief   添字演算子[csmString]
+     */
+    virtual Value& operator[](const csmString& string)
+    {
+        return *(ErrorValue->SetErrorNotForClientCall(CSM_JSON_ERROR_TYPE_MISMATCH));
+    }
+
+    /**
+     * @brief   添字演算子[csmChar*]
+     */
+    virtual Value& operator[](const csmChar* s)
+    {
+        return *(ErrorValue->SetErrorNotForClientCall(CSM_JSON_ERROR_TYPE_MISMATCH));
+    }
+
+    /**
+     * @brief   要素を文字列で返す(csmString型)
+     */
+    virtual const csmString& GetString(const csmString& defaultValue = "", const csmString& indent = "");
+
+    /**
+     * @brief   要素をコンテナで返す(csmVector<Value*>)
+     */
+    virtual csmVector<Value*>* GetVector(csmVector<Value*>* defaultValue = NULL);
+
+    /**
+     * @brief   要素の数を返す
+     */
+    virtual csmInt32 GetSize() { return _count; }
+
+private:
+    Value**             _items;     ///< アリーナ上の要素の配列
+    csmInt32            _count;     ///< 要素数
+    csmVector<Value*>*  _vector;    ///< GetVector() 用に作成したコンテナ
+};
+
+
+/**
+ * @brief   アリーナモードのマップ要素<br>
+ *           キーと値の組をアリーナ上に出現順で並べ、線形に検索する（同じキーは後のものを優先する）。
+ *           GetMap() / GetKeys() は初回呼び出し時にコンテナを作る。
+ */
+class ArenaMap : public Value
+{
+public:
+    /**
+     * @brief   引数付きコンストラクタ
+     *
+     * @param[in]   entries ->  アリーナ上のキーと値の配列
+     * @param[in]   count   ->  要素数
+     */
+    ArenaMap(ArenaMapEntry* entries, csmInt32 count)
+        : Value()
+        , _entries(entries)
+        , _count(count)
+        , _map(NULL)
+        , _keys(NULL) {}
+
+    /**
+     * @brief   デストラクタ<br>
+     *           要素はアリーナ上にあるのでデストラクタだけ呼ぶ。
+     */
+    virtual ~ArenaMap();
+
+    /**
+     * @brief    Valueの値がMap型ならtrue
+     */
+    virtual csmBool IsMap() { return true; }
+
+    /**
+     * @brief    添字演算子[csmString]
+     */
+    virtual Value& operator[](const csmString& s)
+    {
+        return Find(s.GetRawString(), s.GetLength());
+    }
+
+    /**
+     * @brief   添字演算子[csmChar*]
+     */
+    virtual Value& operator[](const csmChar* s)
+    {
+        return Find(s, static_cast<csmInt32>(strlen(s)));
+    }
+
+    /**
+     * @brief    添字演算子[csmInt32]
+     */
+    virtual Value& operator[](csmInt32 index)
+    {
+        return *(ErrorValue->SetErrorNotForClientCall(CSM_JSON_ERROR_TYPE_MISMATCH));
+    }
+
+    /**
+     * @brief   要素を文字列で返す(csmString型)
+     */
+    virtual const csmString& GetString(const csmString& defaultValue = "", const csmString& indent = "");
+
+    /**
+     * @brief    要素をMap型で返す
+     */
+    virtual csmMap<csmString, Value*>* GetMap(csmMap<csmString, Value*>* defaultValue = NULL);
+
+    /**
+     * @brief    Mapからキーのリストを取得する
+     */
+    virtual csmVector<csmString>& GetKeys();
+
+    /**
+     * @brief    Mapの要素数を取得する
+     */
+    virtual csmInt32 GetSize() { return static_cast<csmInt32>(GetKeys().GetSize()); }
+
+private:
+    /**
+     * @brief   キーで値を検索する
+     */
+    Value& Find(const csmChar* key, csmInt32 keyLength)
+    {
+        for (csmInt32 i = _count - 1; i >= 0; --i)
+        {
+            if (_entries[i].KeyLength == keyLength && memcmp(_entries[i].Key, key, keyLength) == 0)
+            {
+                return *_entries[i].Item;
+            }
+        }
+        return *Value::NullValue;
+    }
+
+    ArenaMapEntry*              _entries;   ///< アリーナ上のキーと値
+    csmInt32                    _count;     ///< 要素数
+    csmMap<csmString, Value*>*  _map;       ///< GetMap() 用に作成したコンテナ
+    csmVector<csmString>*       _keys;      ///< GetKeys() 用に作成したキー一覧
+};
 }}}}
 
 //------------ LIVE2D NAMESPACE ------------
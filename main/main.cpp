@@ -9,6 +9,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <cstdlib>
 #include <unistd.h>
 #include <libgen.h>
 #include <thread>
@@ -25,12 +26,19 @@
 // Live2D
 #include "LAppDefine.hpp"
 #include "LAppAllocator_Common.hpp"
+#include "LAppAllocationTracker.hpp"
 #include "LAppTextureManager.hpp"
 #include "LAppPal.hpp"
+#include "LAppLog.hpp"
+#include "LAppModelCache.hpp"
+#include "LAppGlyphCache.hpp"
+#include "LAppModelPack.hpp"
+#include "LAppTaskPool.hpp"
 #include "CubismUserModelExtend.hpp"
 #include "MouseActionManager.hpp"
 
 #include <CubismFramework.hpp>
+#include <Rendering/OpenGL/CubismRenderer_OpenGLES2.hpp>
 
 // AI Manager
 #include "AIManager.hpp"
@@ -47,12 +55,28 @@ static int g_ChatWindowWidth = 500;
 static int g_ChatWindowHeight = 600;
 
 static CubismUserModelExtend* g_UserModel = nullptr;
-static LAppTextureManager* g_TextureManager = nullptr;
 static LAppAllocator_Common g_CubismAllocator;
 static Csm::CubismFramework::Option g_CubismOption;
 
 static std::string g_ExecuteAbsolutePath;
 static std::string g_CurrentModelDirectory;
+static std::string g_CurrentModelFileName;
+
+// 模型切换：新模型在后台线程中加载，纹理上传完毕后与旧模型交叉淡入淡出
+static CubismUserModelExtend* g_LoadingModel = nullptr;     // 加载中的新模型
+static std::string g_LoadingModelDirectory;
+static std::string g_LoadingModelFileName;
+static std::thread g_ModelLoadThread;
+static std::atomic<bool> g_ModelLoadFinished(false);
+static std::string g_ModelLoadError;                        // 由加载线程写入，g_ModelLoadFinished 之后读取
+static bool g_LoadingModelGraphicsReady = false;            // 是否已创建渲染器与纹理
+static CubismUserModelExtend* g_FadingModel = nullptr;      // 淡出中的旧模型
+static bool g_ModelCrossfading = false;
+static double g_ModelFadeStartTime = 0.0;
+
+// 当前模型的副本（与当前模型共用 moc、动作等只读数据与纹理）
+static std::vector<CubismUserModelExtend*> g_ModelInstances;
+static int g_ModelInstanceCount = 0;                        // 调试面板设定的副本数，在主窗口上下文中增减
 
 // AI 相关
 static AIManager* g_AIManager = nullptr;
@@ -94,6 +118,17 @@ static std::string g_AIInitPrompt =
 // ImGui 字体
 static ImFont* g_ChineseFont = nullptr;
 
+// ImGui 绘制阶段的 GPU 计时，结果汇总到 CubismRendererGpuStats::OverlayMilliseconds
+// （查询对象不跨上下文共享，只能在聊天窗口上下文中创建、使用与删除）
+static Csm::Rendering::CubismGpuTimer_OpenGLES2* g_ImGuiGpuTimer = nullptr;
+static double g_LastGpuStatsLogTime = 0.0;
+
+// 分配统计的上次输出时间、期间的帧数与当时的累计分配次数
+static double g_LastAllocatorStatsLogTime = 0.0;
+static uint64_t g_AllocatorStatsFrames = 0;
+static uint64_t g_LastAllocationCount = 0;
+static uint64_t g_LastOperatorNewCount = 0;
+
 // 保存被 ImGui_ImplGlfw 安装的先前回调（若存在），以便我们在设置自定义回调时转发事件
 static GLFWkeyfun g_prevChatKeyCallback = nullptr;
 static GLFWcharfun g_prevChatCharCallback = nullptr;
@@ -131,15 +166,15 @@ void SetExecuteAbsolutePath() {
  * @brief 初始化 Cubism SDK
  */
 void InitializeCubism() {
-    g_CubismOption.LogFunction = LAppPal::PrintMessage;
-    g_CubismOption.LoggingLevel = Csm::CubismFramework::Option::LogLevel_Verbose;
+    g_CubismOption.LogFunction = LAppLog::PrintCubismMessage;
+    g_CubismOption.LoggingLevel = LAppLog::GetCategoryLevel(LAppLog::Category_Cubism);
     g_CubismOption.LoadFileFunction = LAppPal::LoadFileAsBytes;
     g_CubismOption.ReleaseBytesFunction = LAppPal::ReleaseBytes;
     
     Csm::CubismFramework::StartUp(&g_CubismAllocator, &g_CubismOption);
     Csm::CubismFramework::Initialize();
     
-    std::cout << "[Cubism] Framework initialized" << std::endl;
+    LAppLogInfo(Category_App, "cubism framework initialized");
 }
 
 /**
@@ -170,6 +205,9 @@ bool VerifyOpenGLContext() {
  * @brief 主窗口鼠标按钮回调 - 修复版
  */
 void MainWindowMouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    // 点击会开始新的动作
+    LAppAllocationTracker::MarkUnsteady();
+    
     // 确保当前上下文正确
     glfwMakeContextCurrent(window);
     
@@ -196,10 +234,10 @@ void MainWindowCursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
  * @brief 初始化主窗口（Live2D）
  */
 bool InitializeMainWindow() {
-    std::cout << "[MainWindow] Initializing..." << std::endl;
+    LAppLogInfo(Category_App, "main window: initializing");
     
     if (glfwInit() == GL_FALSE) {
-        std::cerr << "[Error] Failed to initialize GLFW" << std::endl;
+        LAppLogError(Category_App, "failed to initialize GLFW");
         return false;
     }
     
@@ -217,7 +255,7 @@ bool InitializeMainWindow() {
     g_MainWindow = glfwCreateWindow(g_MainWindowWidth, g_MainWindowHeight, 
                                     "AIPet - Live2D Model", NULL, NULL);
     if (!g_MainWindow) {
-        std::cerr << "[Error] Failed to create main window" << std::endl;
+        LAppLogError(Category_App, "failed to create main window");
         glfwTerminate();
         return false;
     }
@@ -229,12 +267,12 @@ bool InitializeMainWindow() {
     glewExperimental = GL_TRUE;
     GLenum glewError = glewInit();
     if (glewError != GLEW_OK) {
-        std::cout << "[Warning] GLEW initialization error: " << glewError << std::endl;
+        LAppLogWarning(Category_App, "GLEW initialization error: %u", static_cast<unsigned int>(glewError));
         if (!VerifyOpenGLContext()) {
-            std::cerr << "[Error] OpenGL context is not functional" << std::endl;
+            LAppLogError(Category_App, "OpenGL context is not functional");
             return false;
         }
-        std::cout << "[GLEW] ✓ Continuing with functional OpenGL context" << std::endl;
+        LAppLogInfo(Category_App, "continuing with functional OpenGL context");
     }
     
     // 清除错误
@@ -258,9 +296,7 @@ bool InitializeMainWindow() {
         EventHandler::OnScroll(window, xoffset, yoffset);
     });
     
-    std::cout << "[MainWindow] ✓ Initialized successfully" << std::endl;
-    std::cout << "[MainWindow] Transparent background: ENABLED" << std::endl;
-    std::cout << "[MainWindow] Window decorations: ENABLED" << std::endl;
+    LAppLogInfo(Category_App, "main window: initialized (transparent background, decorations enabled)");
     return true;
 }
 
@@ -268,7 +304,7 @@ bool InitializeMainWindow() {
  * @brief 初始化聊天窗口
  */
 bool InitializeChatWindow() {
-    std::cout << "[ChatWindow] Initializing..." << std::endl;
+    LAppLogInfo(Category_App, "chat window: initializing");
     
     // 创建共享上下文的窗口
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -282,7 +318,7 @@ bool InitializeChatWindow() {
     g_ChatWindow = glfwCreateWindow(g_ChatWindowWidth, g_ChatWindowHeight, 
                                     "AIPet - AI Chat", NULL, g_MainWindow);
     if (!g_ChatWindow) {
-        std::cerr << "[Error] Failed to create chat window" << std::endl;
+        LAppLogError(Category_App, "failed to create chat window");
         return false;
     }
     
@@ -302,29 +338,28 @@ bool InitializeChatWindow() {
     ImGui::StyleColorsDark();
     
     if (!ImGui_ImplGlfw_InitForOpenGL(g_ChatWindow, true)) {
-        std::cerr << "[Error] Failed to initialize ImGui for chat window" << std::endl;
+        LAppLogError(Category_App, "failed to initialize ImGui for chat window");
         return false;
     }
     if (!ImGui_ImplOpenGL3_Init("#version 330")) {
-        std::cerr << "[Error] Failed to initialize ImGui OpenGL3 backend" << std::endl;
+        LAppLogError(Category_App, "failed to initialize ImGui OpenGL3 backend");
         return false;
     }
     
-    // 加载中文字体
+    // 加载中文字体（不指定字形范围：后端支持动态图集，字形在第一次显示时光栅化）
     std::string fontPath = g_ExecuteAbsolutePath + "assets/fonts/zhcn.ttf";
-    g_ChineseFont = io.Fonts->AddFontFromFileTTF(
-        fontPath.c_str(), 18.0f, nullptr, 
-        io.Fonts->GetGlyphRangesChineseFull()
-    );
+    g_ChineseFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 18.0f);
     
     if (!g_ChineseFont) {
-        std::cerr << "[Warning] Failed to load Chinese font" << std::endl;
+        LAppLogWarning(Category_Texture, "failed to load Chinese font: %s", fontPath.c_str());
     }
+    LAppGlyphCache::Load();
     
     // 回调：保留并转发 ImGui/GLFW 之前设置的回调，避免覆盖导致 IME 与文本输入异常
     // 键盘
     g_prevChatKeyCallback = glfwSetKeyCallback(g_ChatWindow, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
         if (g_prevChatKeyCallback) g_prevChatKeyCallback(window, key, scancode, action, mods);
+        LAppAllocationTracker::MarkUnsteady();
         if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
             g_ShouldClose = true;
         }
@@ -332,10 +367,12 @@ bool InitializeChatWindow() {
     // 字符（IME 需要）
     g_prevChatCharCallback = glfwSetCharCallback(g_ChatWindow, [](GLFWwindow* window, unsigned int c) {
         if (g_prevChatCharCallback) g_prevChatCharCallback(window, c);
+        LAppAllocationTracker::MarkUnsteady();
     });
     // 鼠标按键
     g_prevChatMouseButtonCallback = glfwSetMouseButtonCallback(g_ChatWindow, [](GLFWwindow* window, int button, int action, int mods) {
         if (g_prevChatMouseButtonCallback) g_prevChatMouseButtonCallback(window, button, action, mods);
+        LAppAllocationTracker::MarkUnsteady();
     });
     // 光标移动
     g_prevChatCursorPosCallback = glfwSetCursorPosCallback(g_ChatWindow, [](GLFWwindow* window, double xpos, double ypos) {
@@ -346,15 +383,191 @@ bool InitializeChatWindow() {
         if (g_prevChatScrollCallback) g_prevChatScrollCallback(window, xoffset, yoffset);
     });
     
-    std::cout << "[ChatWindow] ✓ Initialized successfully" << std::endl;
+    LAppLogInfo(Category_App, "chat window: initialized");
     return true;
 }
 
+/**
+ * @brief 加载模型资源，并输出加载耗时与期间的分配次数
+ */
+void LoadUserModelAssets(const char* fileName) {
+    const LAppAllocator_Common::Stats before = g_CubismAllocator.GetStats();
+    const double startTime = glfwGetTime();
+
+    g_UserModel->LoadAssets(fileName);
+    LAppAllocationTracker::MarkUnsteady();
+
+    if (LAppDefine::DebugLogEnable) {
+        const LAppAllocator_Common::Stats after = g_CubismAllocator.GetStats();
+        LAppPal::PrintLogLn("[APP]load %s: %.2f ms, %llu allocs, live %zu KB, transient peak %zu KB",
+            fileName, (glfwGetTime() - startTime) * 1000.0,
+            static_cast<unsigned long long>(after.allocationCount - before.allocationCount),
+            after.liveBytes / 1024, after.transientPeakBytes / 1024);
+    }
+}
+
+/**
+ * @brief 释放模型（渲染器持有的 OpenGL 资源在主窗口上下文中删除）
+ */
+void DeleteUserModel(CubismUserModelExtend* model) {
+    glfwMakeContextCurrent(g_MainWindow);
+    model->DeleteRenderer();
+    delete model;
+}
+
+/**
+ * @brief 开始在后台线程中加载新模型，加载期间旧模型照常更新与绘制
+ */
+void BeginModelSwap(std::string directory, const std::string& fileName) {
+    if (g_LoadingModel || g_ModelCrossfading) {
+        g_ChatHistory.push_back({"System", "Model switch already in progress."});
+        return;
+    }
+    
+    if (directory[directory.size() - 1] != '/') {
+        directory += '/';
+    }
+    
+    // 读取不到 model3.json 时模型无法生成，在启动加载线程之前检查
+    std::ifstream testFile(directory + fileName);
+    if (!testFile.good() && !(LAppDefine::ModelPackEnable && LAppModelPack::Exists(directory))) {
+        g_ChatHistory.push_back({"System", "Model file not found: " + directory + fileName});
+        return;
+    }
+    testFile.close();
+    
+    g_LoadingModelDirectory = directory;
+    g_LoadingModelFileName = fileName;
+    g_LoadingModelGraphicsReady = false;
+    g_ModelLoadError.clear();
+    g_ModelLoadFinished = false;
+    g_LoadingModel = new CubismUserModelExtend(std::string(MODEL_NAME), directory);
+    
+    CubismUserModelExtend* model = g_LoadingModel;
+    g_ModelLoadThread = std::thread([model, fileName]() {
+        const double startTime = glfwGetTime();
+        try {
+            model->LoadModelData(fileName.c_str());
+        } catch (const std::exception& e) {
+            g_ModelLoadError = e.what();
+        }
+        if (LAppDefine::DebugLogEnable) {
+            LAppPal::PrintLogLn("[APP]background load %s: %.2f ms", fileName.c_str(), (glfwGetTime() - startTime) * 1000.0);
+        }
+        g_ModelLoadFinished = true;
+    });
+    
+    g_ChatHistory.push_back({"System", "Loading model in background..."});
+}
+
+/**
+ * @brief 推进模型切换（每帧在主窗口上下文中、绘制模型之前调用）
+ *
+ * 后台加载结束后创建渲染器与纹理；纹理全部上传后新模型接管输入与调试面板，
+ * 在 ModelCrossfadeSeconds 内淡入新模型、淡出旧模型，结束后释放旧模型。
+ */
+void UpdateModelSwap() {
+    if (g_LoadingModel && !g_LoadingModelGraphicsReady && g_ModelLoadFinished) {
+        g_ModelLoadThread.join();
+        if (g_ModelLoadError.empty()) {
+            // 只有渲染器与纹理对象的创建在本线程进行，纹理解码仍在工作线程中
+            g_LoadingModel->SetupGraphics();
+            g_LoadingModelGraphicsReady = true;
+        } else {
+            g_ChatHistory.push_back({"System", "Model load failed: " + g_ModelLoadError});
+            DeleteUserModel(g_LoadingModel);
+            g_LoadingModel = nullptr;
+        }
+    }
+    
+    // 有纹理解码失败时放弃切换，继续使用旧模型
+    if (g_LoadingModel && g_LoadingModelGraphicsReady && g_LoadingModel->IsTexturesReady() && g_LoadingModel->HasFailedTextures()) {
+        g_ChatHistory.push_back({"System", "Model load failed: texture could not be decoded."});
+        DeleteUserModel(g_LoadingModel);
+        g_LoadingModel = nullptr;
+    }
+    
+    if (g_LoadingModel && g_LoadingModelGraphicsReady && g_LoadingModel->IsTexturesReady()) {
+        g_FadingModel = g_UserModel;
+        g_UserModel = g_LoadingModel;
+        g_LoadingModel = nullptr;
+        g_CurrentModelDirectory = g_LoadingModelDirectory;
+        g_CurrentModelFileName = g_LoadingModelFileName;
+        MouseActionManager::GetInstance()->SetUserModel(g_UserModel);
+        // 副本是旧模型的，交接时释放，之后由 UpdateModelInstances 用新模型重新生成
+        for (CubismUserModelExtend* instance : g_ModelInstances) {
+            DeleteUserModel(instance);
+        }
+        g_ModelInstances.clear();
+        g_ModelCrossfading = true;
+        g_ModelFadeStartTime = glfwGetTime();
+        g_ChatHistory.push_back({"System", "Model loaded successfully."});
+    }
+    
+    if (g_ModelCrossfading) {
+        const float progress = LAppDefine::ModelCrossfadeSeconds > 0.0f
+            ? static_cast<float>(glfwGetTime() - g_ModelFadeStartTime) / LAppDefine::ModelCrossfadeSeconds
+            : 1.0f;
+        if (progress < 1.0f) {
+            g_UserModel->SetOpacity(progress);
+            if (g_FadingModel) {
+                g_FadingModel->SetOpacity(1.0f - progress);
+            }
+        } else {
+            g_UserModel->SetOpacity(1.0f);
+            if (g_FadingModel) {
+                DeleteUserModel(g_FadingModel);
+                g_FadingModel = nullptr;
+            }
+            g_ModelCrossfading = false;
+        }
+    }
+    
+    // 加载线程与新模型的首批更新都会分配内存
+    if (g_LoadingModel || g_ModelCrossfading) {
+        LAppAllocationTracker::MarkUnsteady();
+    }
+}
+
+/**
+ * @brief 按调试面板设定的数量增减当前模型的副本（每帧在主窗口上下文中、绘制模型之前调用）
+ *
+ * 副本经 LAppModelCache 取得 moc 与解析结果，纹理也已由 LAppTextureManager 加载，
+ * 在本线程中同步生成；为避免一帧内集中加载，每帧最多生成一个。
+ */
+void UpdateModelInstances() {
+    while (static_cast<int>(g_ModelInstances.size()) > g_ModelInstanceCount) {
+        DeleteUserModel(g_ModelInstances.back());
+        g_ModelInstances.pop_back();
+    }
+    
+    if (!g_UserModel || g_LoadingModel || static_cast<int>(g_ModelInstances.size()) >= g_ModelInstanceCount) {
+        return;
+    }
+    
+    const int index = static_cast<int>(g_ModelInstances.size());
+    CubismUserModelExtend* model = new CubismUserModelExtend(MODEL_NAME, g_CurrentModelDirectory);
+    try {
+        model->LoadAssets(g_CurrentModelFileName.c_str());
+    } catch (const std::exception& e) {
+        g_ChatHistory.push_back({"System", std::string("Model instance load failed: ") + e.what()});
+        DeleteUserModel(model);
+        g_ModelInstanceCount = index;
+        return;
+    }
+    
+    // 在当前模型的右、左交替排开，依次向外
+    const float offset = LAppDefine::ModelInstanceSpacing * static_cast<float>(index / 2 + 1) * (index % 2 == 0 ? 1.0f : -1.0f);
+    model->GetModelMatrix()->TranslateRelative(offset, 0.0f);
+    g_ModelInstances.push_back(model);
+    LAppAllocationTracker::MarkUnsteady();
+}
+
 /**
  * @brief 初始化Live2D
  */
 bool InitializeLive2D() {
-    std::cout << "[Live2D] Initializing..." << std::endl;
+    LAppLogInfo(Category_Model, "live2d: initializing");
     
     SetExecuteAbsolutePath();
     InitializeCubism();
@@ -375,26 +588,26 @@ bool InitializeLive2D() {
     // 检查模型文件
     std::string modelJsonPath = g_CurrentModelDirectory + std::string(MODEL_NAME) + ".model3.json";
     std::ifstream testFile(modelJsonPath);
-    if (!testFile.good()) {
-        std::cerr << "[Error] Model file not found: " << modelJsonPath << std::endl;
+    if (!testFile.good() && !(LAppDefine::ModelPackEnable && LAppModelPack::Exists(g_CurrentModelDirectory))) {
+        LAppLogError(Category_Model, "model file not found: %s", modelJsonPath.c_str());
         return false;
     }
     testFile.close();
     
-    g_TextureManager = new LAppTextureManager();
     g_UserModel = new CubismUserModelExtend(MODEL_NAME, g_CurrentModelDirectory);
     
     std::string jsonFileName = std::string(MODEL_NAME) + ".model3.json";
+    g_CurrentModelFileName = jsonFileName;
     try {
-        g_UserModel->LoadAssets(jsonFileName.c_str());
+        LoadUserModelAssets(jsonFileName.c_str());
     } catch (const std::exception& e) {
-        std::cerr << "[Error] Failed to load model: " << e.what() << std::endl;
+        LAppLogError(Category_Model, "failed to load model: %s", e.what());
         return false;
     }
     
     MouseActionManager::GetInstance()->SetUserModel(g_UserModel);
     
-    std::cout << "[Live2D] ✓ Initialized successfully" << std::endl;
+    LAppLogInfo(Category_Model, "live2d: initialized");
     return true;
 }
 
@@ -402,11 +615,11 @@ bool InitializeLive2D() {
  * @brief 初始化 AI
  */
 bool InitializeAI() {
-    std::cout << "[AI] Initializing..." << std::endl;
+    LAppLogInfo(Category_AI, "initializing");
     
     const char* apiKey = std::getenv("GOOGLE_AI_STUDIO_API_KEY");
     if (!apiKey || strlen(apiKey) == 0) {
-        std::cerr << "[Warning] GOOGLE_AI_STUDIO_API_KEY not set" << std::endl;
+        LAppLogWarning(Category_AI, "GOOGLE_AI_STUDIO_API_KEY not set");
         apiKey = "";
     }
     
@@ -449,12 +662,37 @@ void RenderMainWindow() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearDepth(1.0);
     
+    // 推进后台的模型切换（在纹理上传之前，最后一张纹理上传完毕的下一帧才开始首次绘制新模型）
+    UpdateModelSwap();
+    UpdateModelInstances();
+    
+    // 推进异步纹理的上传（完成前模型以占位纹理绘制）
+    LAppTextureManager::GetInstance()->UpdatePendingTextures();
+    
+    // 交叉淡入淡出期间旧模型继续更新，画在新模型之下
+    if (g_FadingModel) {
+        try {
+            g_FadingModel->ModelOnUpdate(g_MainWindow);
+        } catch (const std::exception& e) {
+            LAppLogError(Category_Model, "model update failed: %s", e.what());
+        }
+    }
+    
+    // 副本画在当前模型之下
+    for (CubismUserModelExtend* instance : g_ModelInstances) {
+        try {
+            instance->ModelOnUpdate(g_MainWindow);
+        } catch (const std::exception& e) {
+            LAppLogError(Category_Model, "model update failed: %s", e.what());
+        }
+    }
+    
     // 更新并渲染Live2D模型
     if (g_UserModel) {
         try {
             g_UserModel->ModelOnUpdate(g_MainWindow);
         } catch (const std::exception& e) {
-            std::cerr << "[Error] Model update failed: " << e.what() << std::endl;
+            LAppLogError(Category_Model, "model update failed: %s", e.what());
         }
     }
     
@@ -476,6 +714,7 @@ void RenderChatWindow() {
     
     if (g_ChineseFont) {
         ImGui::PushFont(g_ChineseFont);
+        LAppGlyphCache::Update(g_ChineseFont);
     }
     
     // 全屏ImGui窗口
@@ -513,15 +752,15 @@ void RenderChatWindow() {
             for (size_t i = 0; i < g_ErrorEntries.size(); ++i) {
                 const auto &e = g_ErrorEntries[i];
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.4f, 0.4f, 1.0f));
-                std::string header = "[" + std::to_string(e.requestId) + "] " + (e.errorText.empty() ? "(no message)" : e.errorText);
-                ImGui::TextWrapped("%s", header.c_str());
+                ImGui::TextWrapped("[%llu] %s", (unsigned long long)e.requestId,
+                    e.errorText.empty() ? "(no message)" : e.errorText.c_str());
                 ImGui::PopStyleColor();
                 if (ImGui::TreeNode((void*)i, "Details")) {
                     ImGui::TextWrapped("Code: %d", e.code);
                     ImGui::TextWrapped("Timestamp: %lld", (long long)std::chrono::duration_cast<std::chrono::seconds>(e.ts.time_since_epoch()).count());
                     ImGui::Separator();
                     ImGui::TextWrapped("%s", e.errorText.c_str());
-                    if (ImGui::Button((std::string("Clear##err") + std::to_string(i)).c_str())) {
+                    if (ImGui::Button("Clear")) {
                         g_ErrorEntries.erase(g_ErrorEntries.begin() + i);
                         ImGui::TreePop();
                         break; // avoid iterator invalidation
@@ -585,7 +824,7 @@ void RenderChatWindow() {
     ImGui::Separator();
     if (ImGui::CollapsingHeader("Expressions (debug)")) {
         if (g_UserModel) {
-            auto exprs = g_UserModel->GetExpressionNames();
+            const auto& exprs = g_UserModel->GetExpressionNames();
             ImGui::Text("Loaded expressions: %zu", exprs.size());
             ImGui::BeginChild("ExprList", ImVec2(0, 120), true);
             int col = 0;
@@ -605,6 +844,37 @@ void RenderChatWindow() {
         }
     }
 
+    ImGui::Separator();
+    // 动作调试面板（待机组以外的动作在第一次播放时加载）
+    if (ImGui::CollapsingHeader("Motions (debug)")) {
+        if (g_UserModel) {
+            const CubismUserModelExtend::MotionCacheStats stats = g_UserModel->GetMotionCacheStats();
+            ImGui::Text("Cache: %llu hits, %llu misses, %llu evictions",
+                (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions);
+            ImGui::Text("Resident %u KB, cached %u KB (%u motions)",
+                stats.residentBytes / 1024, stats.cachedBytes / 1024, stats.cachedCount);
+            for (const auto &group : g_UserModel->GetMotionGroups()) {
+                for (int i = 0; i < group.second; ++i) {
+                    const std::string label = group.first + "_" + std::to_string(i);
+                    if (ImGui::Button(label.c_str())) {
+                        g_UserModel->RequestMotion(group.first, i, LAppDefine::PriorityForce);
+                    }
+                    ImGui::SameLine();
+                }
+                ImGui::NewLine();
+            }
+        } else {
+            ImGui::TextDisabled("No model loaded");
+        }
+    }
+
+    ImGui::Separator();
+    // 多实例面板（当前模型的副本，共用 moc、动作、表情、物理设置与纹理）
+    if (ImGui::CollapsingHeader("Instances (debug)")) {
+        ImGui::SliderInt("Copies", &g_ModelInstanceCount, 0, LAppDefine::ModelInstanceMaxCount);
+        ImGui::Text("Loaded: %d", static_cast<int>(g_ModelInstances.size()));
+    }
+
     // 手动加载文件面板（用于模型或字体加载失败时的手工选择）
     ImGui::Separator();
     if (ImGui::CollapsingHeader("Manual file loader")) {
@@ -624,26 +894,11 @@ void RenderChatWindow() {
             ImGui::InputText("Model Directory", modelDirBuf, sizeof(modelDirBuf));
             ImGui::InputText("Model filename (e.g. Haru.model3.json)", modelFileBuf, sizeof(modelFileBuf));
             if (ImGui::Button("Load")) {
-                // 尝试加载模型（在主 OpenGL 上下文）
+                // 在后台线程中加载，旧模型在加载期间继续显示，完成后交叉淡入淡出
                 std::string dir = std::string(modelDirBuf);
                 std::string file = std::string(modelFileBuf);
                 if (!dir.empty() && !file.empty()) {
-                    try {
-                        // 切换上下文并重建模型
-                        glfwMakeContextCurrent(g_MainWindow);
-                        if (g_UserModel) {
-                            g_UserModel->DeleteRenderer();
-                            delete g_UserModel;
-                            g_UserModel = nullptr;
-                        }
-                        g_CurrentModelDirectory = dir;
-                        g_UserModel = new CubismUserModelExtend(std::string(MODEL_NAME), g_CurrentModelDirectory);
-                        g_UserModel->LoadAssets(file.c_str());
-                        MouseActionManager::GetInstance()->SetUserModel(g_UserModel);
-                        g_ChatHistory.push_back({"System", "Model loaded successfully."});
-                    } catch (const std::exception &e) {
-                        g_ChatHistory.push_back({"System", std::string("Model load failed: ") + e.what()});
-                    }
+                    BeginModelSwap(dir, file);
                 } else {
                     g_ChatHistory.push_back({"System", "Model directory or filename empty."});
                 }
@@ -663,12 +918,9 @@ void RenderChatWindow() {
                 if (!fpath.empty()) {
                     try {
                         ImGuiIO& io = ImGui::GetIO();
-                        ImFont* font = io.Fonts->AddFontFromFileTTF(fpath.c_str(), 18.0f, NULL, io.Fonts->GetGlyphRangesChineseFull());
+                        ImFont* font = io.Fonts->AddFontFromFileTTF(fpath.c_str(), 18.0f);
                         if (font) {
-                            // 重新创建设备纹理对象以确保字体生效（在新 imgui 后端里使用 CreateDeviceObjects）
-                            io.Fonts->Build();
-                            ImGui_ImplOpenGL3_DestroyDeviceObjects();
-                            ImGui_ImplOpenGL3_CreateDeviceObjects();
+                            // 图集由后端按需更新，无需重建纹理；字形缓存对新字体重新预加载
                             g_ChineseFont = font;
                             g_ChatHistory.push_back({"System", "Font loaded successfully."});
                         } else {
@@ -696,27 +948,135 @@ void RenderChatWindow() {
     }
     
     ImGui::Render();
+    if (LAppDefine::GpuTimerEnable) {
+        if (!g_ImGuiGpuTimer) {
+            g_ImGuiGpuTimer = new Csm::Rendering::CubismGpuTimer_OpenGLES2();
+        }
+        g_ImGuiGpuTimer->Begin();
+    }
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (g_ImGuiGpuTimer) {
+        g_ImGuiGpuTimer->End();
+    }
     
     glfwSwapBuffers(g_ChatWindow);
 }
 
+/**
+ * @brief 删除 ImGui 的 GPU 计时器（在创建它的聊天窗口上下文中删除查询对象，之后恢复原来的上下文）
+ */
+void DeleteImGuiGpuTimer() {
+    if (!g_ImGuiGpuTimer) {
+        return;
+    }
+    
+    GLFWwindow* previousContext = glfwGetCurrentContext();
+    if (previousContext != g_ChatWindow) {
+        glfwMakeContextCurrent(g_ChatWindow);
+    }
+    delete g_ImGuiGpuTimer;
+    g_ImGuiGpuTimer = nullptr;
+    if (previousContext != g_ChatWindow) {
+        glfwMakeContextCurrent(previousContext);
+    }
+}
+
+/**
+ * @brief 汇总各绘制阶段的 GPU 耗时（模型的遮罩与绘制阶段来自渲染器，ImGui 阶段作为 OverlayMilliseconds）
+ */
+Csm::Rendering::CubismRendererGpuStats CollectGpuStats() {
+    Csm::Rendering::CubismRendererGpuStats stats = {};
+    if (g_UserModel && g_UserModel->GetRenderer<Csm::Rendering::CubismRenderer_OpenGLES2>()) {
+        stats = g_UserModel->GetRenderer<Csm::Rendering::CubismRenderer_OpenGLES2>()->GetGpuStats();
+    }
+    if (g_ImGuiGpuTimer) {
+        stats.OverlayMilliseconds = g_ImGuiGpuTimer->GetMilliseconds();
+        stats.IsAvailable = stats.IsAvailable || g_ImGuiGpuTimer->HasResult();
+    }
+    return stats;
+}
+
+/**
+ * @brief 按 GpuTimerLogInterval 输出各绘制阶段的 GPU 耗时
+ */
+void ReportGpuStats() {
+    if (!LAppDefine::GpuTimerEnable || !LAppDefine::DebugLogEnable) {
+        return;
+    }
+    
+    const double now = glfwGetTime();
+    if (now - g_LastGpuStatsLogTime < LAppDefine::GpuTimerLogInterval) {
+        return;
+    }
+    g_LastGpuStatsLogTime = now;
+    
+    const Csm::Rendering::CubismRendererGpuStats stats = CollectGpuStats();
+    LAppPal::PrintLogLn("[APP]GPU mask %.3f ms, model %.3f ms, imgui %.3f ms",
+        stats.MaskMilliseconds, stats.DrawMilliseconds, stats.OverlayMilliseconds);
+}
+
+/**
+ * @brief 按 AllocatorStatsLogInterval 输出每帧分配次数、内存占用与尺寸级别直方图
+ */
+void ReportAllocatorStats() {
+    if (!LAppDefine::AllocatorStatsEnable || !LAppDefine::DebugLogEnable) {
+        return;
+    }
+    
+    g_AllocatorStatsFrames++;
+    const double now = glfwGetTime();
+    if (now - g_LastAllocatorStatsLogTime < LAppDefine::AllocatorStatsLogInterval) {
+        return;
+    }
+    
+    const LAppAllocator_Common::Stats stats = g_CubismAllocator.GetStats();
+    // 首次调用只记录基准
+    if (g_LastAllocatorStatsLogTime > 0.0) {
+        LAppPal::PrintLogLn("[APP]alloc %.1f/frame, live %zu KB (%zu blocks), reserved %zu KB, peak %zu KB",
+            static_cast<double>(stats.allocationCount - g_LastAllocationCount) / g_AllocatorStatsFrames,
+            stats.liveBytes / 1024, stats.liveCount, stats.reservedBytes / 1024, stats.peakReservedBytes / 1024);
+        if (LAppAllocationTracker::IsEnabled()) {
+            LAppPal::PrintLogLn("[APP]operator new %.1f/frame",
+                static_cast<double>(LAppAllocationTracker::GetOperatorNewCount() - g_LastOperatorNewCount) / g_AllocatorStatsFrames);
+        }
+        
+        std::ostringstream histogram;
+        for (Csm::csmUint32 i = 0; i <= LAppAllocator_Common::SizeClassCount; i++) {
+            if (stats.classAllocations[i] == 0) {
+                continue;
+            }
+            if (i < LAppAllocator_Common::SizeClassCount) {
+                histogram << ' ' << LAppAllocator_Common::GetSizeClassBytes(i) << ':' << stats.classAllocations[i];
+            } else {
+                histogram << " large:" << stats.classAllocations[i];
+            }
+        }
+        LAppPal::PrintLogLn("[APP]alloc classes%s", histogram.str().c_str());
+    }
+    
+    g_LastAllocatorStatsLogTime = now;
+    g_AllocatorStatsFrames = 0;
+    g_LastAllocationCount = stats.allocationCount;
+    g_LastOperatorNewCount = LAppAllocationTracker::GetOperatorNewCount();
+}
+
 /**
  * @brief 主循环
  */
 void Run() {
-    std::cout << "[App] Starting dual-window loop" << std::endl;
-    std::cout << "[Info] Live2D window: Semi-transparent gray background" << std::endl;
-    std::cout << "[Info] Both windows have decorations and can be dragged" << std::endl;
-    std::cout << "[Info] Press ESC in any window to exit" << std::endl;
+    LAppLogInfo(Category_App, "starting dual-window loop (press ESC in either window to exit)");
     
     while (!g_ShouldClose && !glfwWindowShouldClose(g_MainWindow) && !glfwWindowShouldClose(g_ChatWindow)) {
+        LAppAllocationTracker::BeginFrame();
+        
         // 更新时间
         LAppPal::UpdateTime();
         
         // 渲染两个窗口
         RenderMainWindow();
         RenderChatWindow();
+        ReportGpuStats();
+        ReportAllocatorStats();
         
         // 处理事件（先处理用户输入，这样新发送的消息能在本循环后由 AI 返回）
         glfwPollEvents();
@@ -727,6 +1087,7 @@ void Run() {
 
             // 先处理错误队列，显示到 ERROR 面板并生成系统提示（不触发表情解析）；可短暂触发伤心表情
             while (g_AIManager->popErrorResponse(evt)) {
+                LAppAllocationTracker::MarkUnsteady();
                 g_ErrorEntries.push_back(evt);
                 std::string shortMsg = "[Network Error] ";
                 if (!evt.errorText.empty()) shortMsg += evt.errorText; else shortMsg += "Unknown error.";
@@ -743,15 +1104,17 @@ void Run() {
 
             // 然后处理成功的 AI 响应队列
             while (g_AIManager->popAIResponse(evt)) {
+                LAppAllocationTracker::MarkUnsteady();
                 // 只处理最近一次发送的回复，忽略过时回复
                 if (g_LastSentRequestId != 0 && evt.requestId != g_LastSentRequestId) {
-                    std::cout << "[AI] Ignored stale response id=" << evt.requestId << " expected=" << g_LastSentRequestId << std::endl;
+                    LAppLogInfo(Category_AI, "ignored stale response id=%llu expected=%llu",
+                        static_cast<unsigned long long>(evt.requestId), static_cast<unsigned long long>(g_LastSentRequestId));
                     continue;
                 }
 
                 std::string response = evt.text;
                 if (!response.empty()) {
-                    std::cout << "[AI RAW] " << response << std::endl;
+                    LAppLogInfo(Category_AI, "raw response: %s", response.c_str());
                 }
 
                 if (!response.empty()) {
@@ -839,37 +1202,59 @@ void Run() {
         
         // 处理事件
         glfwPollEvents();
+        
+        LAppAllocationTracker::EndFrame();
     }
+    
+    LAppAllocationTracker::ReportSummary();
 }
 
 /**
  * @brief 清理资源
  */
 void Cleanup() {
-    std::cout << "[App] Cleaning up..." << std::endl;
+    LAppLogInfo(Category_App, "cleaning up");
     
     if (g_AIManager) {
         delete g_AIManager;
         g_AIManager = nullptr;
     }
     
+    // 等待后台加载结束后释放切换中的模型
+    if (g_ModelLoadThread.joinable()) {
+        g_ModelLoadThread.join();
+    }
+    if (g_LoadingModel) {
+        DeleteUserModel(g_LoadingModel);
+        g_LoadingModel = nullptr;
+    }
+    if (g_FadingModel) {
+        DeleteUserModel(g_FadingModel);
+        g_FadingModel = nullptr;
+    }
+    for (CubismUserModelExtend* instance : g_ModelInstances) {
+        DeleteUserModel(instance);
+    }
+    g_ModelInstances.clear();
+    
     if (g_UserModel) {
-        glfwMakeContextCurrent(g_MainWindow);
-        g_UserModel->DeleteRenderer();
-        delete g_UserModel;
+        DeleteUserModel(g_UserModel);
         g_UserModel = nullptr;
     }
     
-    if (g_TextureManager) {
-        delete g_TextureManager;
-        g_TextureManager = nullptr;
-    }
+    // 纹理在主窗口上下文中创建，需在该上下文中删除
+    glfwMakeContextCurrent(g_MainWindow);
+    LAppTextureManager::ReleaseInstance();
+    LAppModelCache::ReleaseInstance();
+    LAppTaskPool::ReleaseInstance();
     
     MouseActionManager::ReleaseInstance();
     
     // 清理聊天窗口
     if (g_ChatWindow) {
         glfwMakeContextCurrent(g_ChatWindow);
+        DeleteImGuiGpuTimer();
+        LAppGlyphCache::Save(g_ChineseFont);
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -887,6 +1272,8 @@ void Cleanup() {
     
     glfwTerminate();
     
+    // 日志线程已停止，最后一行直接写到标准输出
+    LAppLog::Stop();
     std::cout << "[App] Cleanup complete" << std::endl;
 }
 
@@ -894,28 +1281,39 @@ void Cleanup() {
  * @brief 主函数
  */
 int main(int argc, char* argv[]) {
-    std::cout << "========================================" << std::endl;
-    std::cout << " AIPet - Dual Window Mode " << std::endl;
-    std::cout << "========================================" << std::endl;
+    // 日志级别可用环境变量覆盖，例如 AIPET_LOG=info,input=debug
+    LAppLog::Configure(std::getenv("AIPET_LOG"));
+    LAppLog::Start();
+
+    // 以 AIPET_PREMULTIPLY_SELF_CHECK 构建时检查预乘的向量化实现（未启用时直接返回 true）
+    if (!LAppTextureManager_Common::CheckPremultiplyPixels()) {
+        LAppLog::Stop();
+        return -1;
+    }
+
+    LAppLogInfo(Category_App, "AIPet - Dual Window Mode");
     
+    // 未经 Cleanup 返回时也要 Stop，否则缓冲区中的错误日志不会输出
     if (!InitializeMainWindow()) {
-        std::cerr << "[Error] Failed to initialize main window" << std::endl;
+        LAppLogError(Category_App, "failed to initialize main window");
+        LAppLog::Stop();
         return -1;
     }
     
     if (!InitializeChatWindow()) {
-        std::cerr << "[Error] Failed to initialize chat window" << std::endl;
+        LAppLogError(Category_App, "failed to initialize chat window");
+        LAppLog::Stop();
         return -1;
     }
     
     if (!InitializeLive2D()) {
-        std::cerr << "[Error] Failed to initialize Live2D" << std::endl;
+        LAppLogError(Category_App, "failed to initialize Live2D");
         Cleanup();
         return -1;
     }
     
     if (!InitializeAI()) {
-        std::cerr << "[Error] Failed to initialize AI" << std::endl;
+        LAppLogError(Category_AI, "failed to initialize AI");
         Cleanup();
         return -1;
     }
@@ -9,8 +9,11 @@
  * @return                  返回已开始动作的识别编号。用于判断单个动作是否结束的 IsFinished() 的参数。如果无法开始则返回 -1。
  */
 #include <Utils/CubismString.hpp>
+#include <Utils/CubismBinary.hpp>
 #include <Motion/CubismMotion.hpp>
+#include <Motion/CubismExpressionMotion.hpp>
 #include <Physics/CubismPhysics.hpp>
+#include <Model/CubismMoc.hpp>
 #include <CubismDefaultParameterId.hpp>
 #include <Rendering/OpenGL/CubismRenderer_OpenGLES2.hpp>
 #include <Motion/CubismMotionQueueEntry.hpp>
@@ -18,12 +21,15 @@
 
 #include "LAppPal.hpp"
 #include "LAppDefine.hpp"
+#include "LAppLog.hpp"
 #include "MouseActionManager.hpp"
 
 #include "CubismUserModelExtend.hpp"
-#include <iostream>
+#include <cstring>
+#include <cstdio>
 
 using namespace Live2D::Cubism::Framework;
+using namespace Live2D::Cubism;
 using namespace DefaultParameterId;
 using namespace LAppDefine;
 
@@ -33,7 +39,9 @@ CubismUserModelExtend::CubismUserModelExtend(const std::string modelDirectoryNam
     , _userTimeSeconds(0.0f)
     , _modelDirName(modelDirectoryName)
     , _currentModelDirectory(_currentModelDirectory)
-    , _textureManager(new LAppTextureManager())
+    , _modelCache(NULL)
+    , _textureManager(LAppTextureManager::GetInstance())
+    , _glContext(NULL)
 {
     // 获取参数 ID
     _idParamAngleX = CubismFramework::GetIdManager()->GetId(ParamAngleX);
@@ -42,15 +50,71 @@ CubismUserModelExtend::CubismUserModelExtend(const std::string modelDirectoryNam
     _idParamBodyAngleX = CubismFramework::GetIdManager()->GetId(ParamBodyAngleX);
     _idParamEyeBallX = CubismFramework::GetIdManager()->GetId(ParamEyeBallX);
     _idParamEyeBallY = CubismFramework::GetIdManager()->GetId(ParamEyeBallY);
+
+    _indexParamAngleX = -1;
+    _indexParamAngleY = -1;
+    _indexParamAngleZ = -1;
+    _indexParamBodyAngleX = -1;
+    _indexParamEyeBallX = -1;
+    _indexParamEyeBallY = -1;
+
+    // 目录旁有模型包时，之后读取该目录下的文件都从包中取
+    _modelPack = ModelPackEnable ? LAppModelPack::Mount(_currentModelDirectory) : NULL;
 }
 
 CubismUserModelExtend::~CubismUserModelExtend()
 {
+    // 先停止更新线程，之后的释放处理不再与其竞争
+    StopUpdateThread();
+
+    // 等待按需加载中的动作，结果留在表项中，由 ReleaseModelSetting 释放
+    LAppTaskPool::GetInstance()->Wait(&_motionLoadTasks);
+
+    // 渲染器与纹理的 OpenGL 对象属于创建它们的上下文，双窗口下当前上下文可能是聊天窗口的，
+    // 释放前切换到创建时的上下文，结束后恢复
+    GLFWwindow* previousContext = glfwGetCurrentContext();
+    if (_glContext != NULL && _glContext != previousContext)
+    {
+        glfwMakeContextCurrent(_glContext);
+    }
+
+    // 渲染器引用 _renderModel 或 _model，需先于它们释放
+    DeleteRenderer();
+
+    if (_renderModel)
+    {
+        LAppModelCache::GetInstance()->DeleteModel(_modelCache, _renderModel);
+        _renderModel = NULL;
+    }
+
     // 释放模型设置数据
     ReleaseModelSetting();
 
-    // 释放纹理管理器
-    delete _textureManager;
+    // 模型由共用的 moc 生成，在基类的析构之前删除，moc 由最后归还表项的实例释放
+    if (_modelCache)
+    {
+        LAppModelCache::GetInstance()->DeleteModel(_modelCache, _model);
+        LAppModelCache::GetInstance()->Release(_modelCache);
+        _modelCache = NULL;
+    }
+    _model = NULL;
+    _moc = NULL;
+
+    // 归还本模型引用的纹理（纹理管理器为进程内共享，其他模型仍在使用的纹理会保留）
+    for (csmUint32 i = 0; i < _textureIds.GetSize(); i++)
+    {
+        _textureManager->ReleaseTexture(_textureIds[i]);
+    }
+    _textureIds.Clear();
+
+    if (glfwGetCurrentContext() != previousContext)
+    {
+        glfwMakeContextCurrent(previousContext);
+    }
+
+    // 仍在解码线程中读取的纹理数据持有包的引用，全部归还后才解除映射
+    LAppModelPack::Unmount(_modelPack);
+    _modelPack = NULL;
 }
 
 void CubismUserModelExtend::LoadAssets(const Csm::csmChar* fileName)
@@ -62,88 +126,147 @@ void CubismUserModelExtend::LoadAssets(const Csm::csmChar* fileName)
     _modelJson = new CubismModelSettingJson(buffer, size);
     DeleteBuffer(buffer, path.GetRawString());
 
+    // 同一 model3.json 的实例共用 moc 与解析结果
+    _modelCache = LAppModelCache::GetInstance()->Acquire(path.GetRawString());
+
     // 生成模型
-    SetupModel();
+    SetupModel(true);
 }
 
-void CubismUserModelExtend::SetupModel()
+void CubismUserModelExtend::LoadModelData(const Csm::csmChar* fileName)
+{
+    csmSizeInt size;
+    const csmString path = csmString(_currentModelDirectory.c_str()) + fileName;
+
+    csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+    _modelJson = new CubismModelSettingJson(buffer, size);
+    DeleteBuffer(buffer, path.GetRawString());
+
+    _modelCache = LAppModelCache::GetInstance()->Acquire(path.GetRawString());
+
+    // 生成模型（渲染器与纹理由 SetupGraphics 在 OpenGL 线程中创建）
+    SetupModel(false);
+}
+
+void CubismUserModelExtend::SetupModel(Csm::csmBool setupGraphics)
 {
     _updating = true;
     _initialized = false;
 
-    csmByte* buffer;
-    csmSizeInt size;
+    // 文件的读取与解析在任务池中并行进行，各任务只写入自己的槽位或成员（_moc、_pose、_physics 等）；
+    // 全部完成后按 model3.json 中的顺序登记，结果与执行顺序无关
+    // moc、表情、物理与动作经 LAppModelCache 取得，同一模型的其他实例已读取过时不再读取文件
+    LAppTaskPool* taskPool = LAppTaskPool::GetInstance();
+    LAppModelCache* modelCache = LAppModelCache::GetInstance();
+    const csmString directory(_currentModelDirectory.c_str());
 
-    //Cubism Model
+    //Cubism Model（渲染器、纹理与布局依赖它，单独成组先等待）
+    LAppTaskPool::Group modelTasks;
+    std::function<CubismMoc*()> loadMoc;
     if (strcmp(_modelJson->GetModelFileName(), ""))
     {
-        csmString path = _modelJson->GetModelFileName();
-        path = csmString(_currentModelDirectory.c_str()) + path;
-
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadModel(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+        const csmString path = directory + _modelJson->GetModelFileName();
+        loadMoc = [this, path]() -> CubismMoc*
+        {
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            CubismMoc* moc = CubismMoc::Create(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+            return moc;
+        };
+        taskPool->Submit(&modelTasks, [this, modelCache, &loadMoc]()
+        {
+            // 与 CubismUserModel::LoadModel 相同，只是 moc 由各实例共用
+            _model = modelCache->CreateModel(_modelCache, loadMoc, &_moc);
+            if (_model == NULL)
+            {
+                LAppPal::PrintLogLn("[APP]failed to create model: %s", _modelJson->GetModelFileName());
+                return;
+            }
+            _model->SaveParameters();
+            _modelMatrix = CSM_NEW CubismModelMatrix(_model->GetCanvasWidth(), _model->GetCanvasHeight());
+        });
     }
 
+    LAppTaskPool::Group assetTasks;
+
     // 读取表情数据
-    if (_modelJson->GetExpressionCount() > 0)
+    std::deque<AssetLoad> expressionLoads;
+    for (csmInt32 i = 0; i < _modelJson->GetExpressionCount(); i++)
     {
-        const csmInt32 count = _modelJson->GetExpressionCount();
-        for (csmInt32 i = 0; i < count; i++)
-        {
-            csmString name = _modelJson->GetExpressionName(i);
-            csmString path = _modelJson->GetExpressionFileName(i);
-            path = csmString(_currentModelDirectory.c_str()) + path;
-
-            buffer = CreateBuffer(path.GetRawString(), &size);
-            ACubismMotion* motion = LoadExpression(buffer, size, name.GetRawString());
+        AssetLoad load = {};
+        load.name = _modelJson->GetExpressionName(i);
+        load.path = directory + _modelJson->GetExpressionFileName(i);
+        expressionLoads.push_back(load);
 
-            if (motion)
+        AssetLoad* slot = &expressionLoads.back();
+        taskPool->Submit(&assetTasks, [this, modelCache, slot]()
+        {
+            slot->motion = modelCache->CreateExpression(_modelCache, slot->name, [this, slot]()
             {
-                if (_expressions[name])
-                {
-                    ACubismMotion::Delete(_expressions[name]);
-                    _expressions[name] = nullptr;
-                }
-                _expressions[name] = motion;
-            }
-
-            DeleteBuffer(buffer, path.GetRawString());
-        }
+                csmSizeInt size;
+                csmByte* buffer = CreateBuffer(slot->path.GetRawString(), &size);
+                ACubismMotion* expression = LoadExpression(buffer, size, slot->name.GetRawString());
+                DeleteBuffer(buffer, slot->path.GetRawString());
+                return static_cast<CubismExpressionMotion*>(expression);
+            });
+        });
     }
 
     // 读取姿势（pose）数据
     if (strcmp(_modelJson->GetPoseFileName(), ""))
     {
-        csmString path = _modelJson->GetPoseFileName();
-        path = csmString(_currentModelDirectory.c_str()) + path;
-
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadPose(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+        const csmString path = directory + _modelJson->GetPoseFileName();
+        taskPool->Submit(&assetTasks, [this, path]()
+        {
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            LoadPose(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+        });
     }
 
     // 读取物理（physics）数据
     if (strcmp(_modelJson->GetPhysicsFileName(), ""))
     {
-        csmString path = _modelJson->GetPhysicsFileName();
-        path = csmString(_currentModelDirectory.c_str()) + path;
-
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadPhysics(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+        const csmString path = directory + _modelJson->GetPhysicsFileName();
+        taskPool->Submit(&assetTasks, [this, modelCache, path]()
+        {
+            // 物理点同时持有设置与演算状态，各实例持有模板的复制
+            _physics = modelCache->CreatePhysics(_modelCache, [this, path]()
+            {
+                csmSizeInt size;
+                csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+                CubismPhysics* physics = CubismPhysics::Create(buffer, size);
+                DeleteBuffer(buffer, path.GetRawString());
+                return physics;
+            });
+        });
     }
 
     // 读取模型附带的用户数据
     if (strcmp(_modelJson->GetUserDataFile(), ""))
     {
-        csmString path = _modelJson->GetUserDataFile();
-        path = csmString(_currentModelDirectory.c_str()) + path;
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadUserData(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+        const csmString path = directory + _modelJson->GetUserDataFile();
+        taskPool->Submit(&assetTasks, [this, path]()
+        {
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            LoadUserData(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+        });
+    }
+
+    // 读取动作（motion）数据。待机组常驻，其余的组在第一次请求播放时才加载
+    for (csmInt32 i = 0; i < _modelJson->GetMotionGroupCount(); i++)
+    {
+        const csmChar* group = _modelJson->GetMotionGroupName(i);
+        const bool resident = !MotionLazyLoadEnable || strcmp(group, MotionGroupIdle) == 0;
+        PreloadMotionGroup(group, resident, &assetTasks);
     }
 
+    taskPool->Wait(&modelTasks);
+
     // 布局
     csmMap<csmString, csmFloat32> layout;
     _modelJson->GetLayoutMap(layout);
@@ -153,68 +276,341 @@ void CubismUserModelExtend::SetupModel()
     // 保存参数
     _model->SaveParameters();
 
-    // 读取动作（motion）数据
-    for (csmInt32 i = 0; i < _modelJson->GetMotionGroupCount(); i++)
+    // 拖拽相关参数的下标在模型生命周期内不变，只解析一次
+    _indexParamAngleX = _model->GetParameterIndex(_idParamAngleX);
+    _indexParamAngleY = _model->GetParameterIndex(_idParamAngleY);
+    _indexParamAngleZ = _model->GetParameterIndex(_idParamAngleZ);
+    _indexParamBodyAngleX = _model->GetParameterIndex(_idParamBodyAngleX);
+    _indexParamEyeBallX = _model->GetParameterIndex(_idParamEyeBallX);
+    _indexParamEyeBallY = _model->GetParameterIndex(_idParamEyeBallY);
+
+    if (PipelinedUpdateEnable && _moc)
     {
-        const csmChar* group = _modelJson->GetMotionGroupName(i);
-    // 根据组名一次性预加载该组的动作数据
-    PreloadMotionGroup(group);
+        // 流水线模式下渲染器绑定独立的绘制用模型，更新线程修改 _model 时不影响绘制
+        _renderModel = modelCache->CreateModel(_modelCache, loadMoc, &_moc);
+    }
+
+    // 创建渲染器（与其余文件的解析并行）
+    if (setupGraphics)
+    {
+        _glContext = glfwGetCurrentContext();
+        CreateRenderer(_renderModel ? _renderModel : _model);
+        GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->SetGpuTimerEnabled(GpuTimerEnable);
     }
 
+    taskPool->Wait(&assetTasks);
+
+    for (std::deque<AssetLoad>::iterator it = expressionLoads.begin(); it != expressionLoads.end(); ++it)
+    {
+        if (it->motion == NULL)
+        {
+            continue;
+        }
+
+        if (_expressions[it->name])
+        {
+            ACubismMotion::Delete(_expressions[it->name]);
+            _expressions[it->name] = nullptr;
+        }
+        else
+        {
+            _expressionNames.emplace_back(it->name.GetRawString());
+        }
+        _expressions[it->name] = it->motion;
+    }
+
+    csmSizeInt residentBytes = 0;
+    for (std::deque<MotionEntry>::iterator it = _motionEntries.begin(); it != _motionEntries.end(); ++it)
+    {
+        if (it->load.motion != NULL)
+        {
+            it->bytes = static_cast<CubismMotion*>(it->load.motion)->GetMemoryBytes();
+            residentBytes += it->bytes;
+        }
+    }
+    _motionResidentBytes = residentBytes;
+
     _motionManager->StopAllMotions();
 
-    // 创建渲染器
-    CreateRenderer();
+    _updating = false;
+
+    // 设置纹理（解码线程读取 PNG 时，首帧所需的文件已全部读完，冷启动时不会排在纹理的磁盘读取之后）
+    if (setupGraphics)
+    {
+        SetupGraphics();
+    }
+}
+
+void CubismUserModelExtend::SetupGraphics()
+{
+    _glContext = glfwGetCurrentContext();
+
+    if (!GetRenderer<Rendering::CubismRenderer_OpenGLES2>())
+    {
+        CreateRenderer(_renderModel ? _renderModel : _model);
+        GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->SetGpuTimerEnabled(GpuTimerEnable);
+    }
 
-    // 设置纹理
     SetupTextures();
 
-    _updating = false;
+    if (_renderModel)
+    {
+        StartUpdateThread();
+    }
+
     _initialized = true;
 }
 
-void CubismUserModelExtend::PreloadMotionGroup(const csmChar* group)
+bool CubismUserModelExtend::IsTexturesReady() const
+{
+    for (csmUint32 i = 0; i < _textureIds.GetSize(); i++)
+    {
+        const LAppTextureManager::TextureInfo* texture = _textureManager->GetTextureInfoById(_textureIds[i]);
+        if (texture != NULL && !texture->ready && !texture->failed)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CubismUserModelExtend::HasFailedTextures() const
+{
+    for (csmUint32 i = 0; i < _textureIds.GetSize(); i++)
+    {
+        const LAppTextureManager::TextureInfo* texture = _textureManager->GetTextureInfoById(_textureIds[i]);
+        if (texture != NULL && texture->failed)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CubismUserModelExtend::SetOpacity(float opacity)
+{
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->SetModelColor(1.0f, 1.0f, 1.0f, opacity);
+}
+
+void CubismUserModelExtend::PreloadMotionGroup(const csmChar* group, bool resident, LAppTaskPool::Group* tasks)
 {
     // 获取组中注册的动作数量
     const csmInt32 count = _modelJson->GetMotionCount(group);
+    _motionGroups.emplace_back(group, count);
 
     for (csmInt32 i = 0; i < count; i++)
     {
-    // ex) idle_0
-    // 获取动作的文件名与路径
-        csmString name = Utils::CubismString::GetFormatedString("%s_%d", group, i);
-        csmString path = _modelJson->GetMotionFileName(group, i);
-        path = csmString(_currentModelDirectory.c_str()) + path;
-
-        csmByte* buffer;
-        csmSizeInt size;
-        buffer = CreateBuffer(path.GetRawString(), &size);
+        // ex) idle_0
+        // 获取动作的文件名与路径（model3.json 只在本线程中读取）
+        MotionEntry entry = {};
+        entry.load.name = Utils::CubismString::GetFormatedString("%s_%d", group, i);
+        entry.load.path = csmString(_currentModelDirectory.c_str()) + _modelJson->GetMotionFileName(group, i);
+        entry.load.fadeInTime = _modelJson->GetMotionFadeInTimeValue(group, i);
+        entry.load.fadeOutTime = _modelJson->GetMotionFadeOutTimeValue(group, i);
+        entry.resident = resident;
+        _motionEntries.push_back(entry);
+
+        MotionEntry* slot = &_motionEntries.back();
+        _motions[slot->load.name] = slot;
+
+        if (resident)
+        {
+            LAppTaskPool::GetInstance()->Submit(tasks, [this, slot]()
+            {
+                slot->load.motion = LoadMotionAsset(slot->load);
+            });
+        }
+    }
+}
+
+Csm::CubismMotion* CubismUserModelExtend::LoadMotionAsset(const AssetLoad& load)
+{
+    return LAppModelCache::GetInstance()->CreateMotion(_modelCache, load.name, [this, &load]()
+    {
+        return ParseMotionAsset(load);
+    });
+}
+
+Csm::CubismMotion* CubismUserModelExtend::ParseMotionAsset(const AssetLoad& load)
+{
+    csmSizeInt size;
+    csmByte* buffer = CreateBuffer(load.path.GetRawString(), &size);
+    const csmBool binary = (buffer != NULL) && Utils::CubismBinary::IsBinary(buffer, size);
     // 读取动作数据
-        CubismMotion* tmpMotion = static_cast<CubismMotion*>(LoadMotion(buffer, size, name.GetRawString(), NULL, NULL, _modelJson, group, i));
+    CubismMotion* motion = static_cast<CubismMotion*>(LoadMotion(buffer, size, load.name.GetRawString()));
+    DeleteBuffer(buffer, load.path.GetRawString());
+
+    if (motion == NULL && binary)
+    {
+        // .bin 的版本一致但内容损坏时，改为读取同名的 motion3.json
+        LAppPal::PrintLogLn("[APP]corrupt binary motion, loading json instead: %s", load.path.GetRawString());
+        buffer = LAppPal::LoadFileAsBytes(load.path.GetRawString(), &size);
+        if (buffer != NULL)
+        {
+            motion = static_cast<CubismMotion*>(LoadMotion(buffer, size, load.name.GetRawString()));
+            LAppPal::ReleaseBytes(buffer);
+        }
+    }
+
+    if (motion)
+    {
+        // 与 LoadMotion 传入 ModelSetting 时相同，按 model3.json 覆盖淡入淡出时间
+        if (load.fadeInTime >= 0.0f)
+        {
+            motion->SetFadeInTime(load.fadeInTime);
+        }
+        if (load.fadeOutTime >= 0.0f)
+        {
+            motion->SetFadeOutTime(load.fadeOutTime);
+        }
+        BakeMotion(motion, load.name.GetRawString());
+    }
+
+    return motion;
+}
+
+void CubismUserModelExtend::LoadMotionAsync(MotionEntry* entry)
+{
+    entry->loading = true;
+    _loadingMotionCount++;
+
+    LAppTaskPool::GetInstance()->Submit(&_motionLoadTasks, [this, entry]()
+    {
+        entry->load.motion = LoadMotionAsset(entry->load);
+
+        std::lock_guard<std::mutex> lock(_motionLoadMutex);
+        _loadedMotions.push_back(entry);
+    });
+}
+
+void CubismUserModelExtend::ProcessLoadedMotions()
+{
+    std::vector<MotionEntry*> loaded;
+    {
+        std::lock_guard<std::mutex> lock(_motionLoadMutex);
+        loaded.swap(_loadedMotions);
+    }
+
+    for (size_t i = 0; i < loaded.size(); i++)
+    {
+        MotionEntry* entry = loaded[i];
+        entry->loading = false;
+        _loadingMotionCount--;
 
-        if (tmpMotion)
+        if (entry->load.motion != NULL)
         {
-            if (_motions[name])
+            entry->bytes = static_cast<CubismMotion*>(entry->load.motion)->GetMemoryBytes();
+            _motionCachedBytes += entry->bytes;
+            _motionCachedCount++;
+        }
+
+        if (entry != _pendingMotion)
+        {
+            continue;
+        }
+
+        // 加载期间没有占用预约，此时重新按优先级判断（期间开始了更高优先级的动作时放弃）
+        _pendingMotion = NULL;
+        _hasPendingMotion = false;
+        if (entry->load.motion == NULL)
+        {
+            continue;
+        }
+        if (_pendingMotionPriority == LAppDefine::PriorityForce || _motionManager->ReserveMotion(_pendingMotionPriority))
+        {
+            _motionManager->StartMotionPriority(entry->load.motion, false, _pendingMotionPriority);
+        }
+    }
+
+    if (!loaded.empty())
+    {
+        EvictMotions();
+    }
+}
+
+void CubismUserModelExtend::EvictMotions()
+{
+    while (_motionCachedBytes > MotionCacheBudgetBytes)
+    {
+        // 最久未请求、且不在播放或淡出中的动作
+        MotionEntry* victim = NULL;
+        for (std::deque<MotionEntry>::iterator it = _motionEntries.begin(); it != _motionEntries.end(); ++it)
+        {
+            if (it->resident || it->loading || it->load.motion == NULL)
+            {
+                continue;
+            }
+            if ((victim == NULL || it->lastUse < victim->lastUse) && !IsMotionQueued(it->load.motion))
             {
-                // 释放实例
-                ACubismMotion::Delete(_motions[name]);
+                victim = &*it;
             }
-            _motions[name] = tmpMotion;
         }
 
-        DeleteBuffer(buffer, path.GetRawString());
+        // 都在播放中时暂时超出预算，下一次加载完成时再释放
+        if (victim == NULL)
+        {
+            return;
+        }
+
+        LAppLogDebug(Category_Model, "motion cache evict: %s (%zu bytes)", victim->load.name.GetRawString(), static_cast<size_t>(victim->bytes));
+
+        ACubismMotion::Delete(victim->load.motion);
+        victim->load.motion = NULL;
+        LAppModelCache::GetInstance()->TrimMotion(_modelCache, victim->load.name);
+        _motionCachedBytes -= victim->bytes;
+        _motionCachedCount--;
+        _motionCacheEvictions++;
+    }
+}
+
+bool CubismUserModelExtend::IsMotionQueued(const ACubismMotion* motion)
+{
+    csmVector<CubismMotionQueueEntry*>* entries = _motionManager->GetCubismMotionQueueEntries();
+    for (csmUint32 i = 0; i < entries->GetSize(); i++)
+    {
+        if ((*entries)[i] != NULL && (*entries)[i]->GetCubismMotion() == motion)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CubismUserModelExtend::BakeMotion(CubismMotion* motion, const csmChar* name)
+{
+    if (!MotionBakeEnable || motion == NULL)
+    {
+        return;
+    }
+
+    motion->Bake(MotionBakeSampleRate);
+
+    if (motion->GetBakedMaxError() > MotionBakeMaxError)
+    {
+        if (DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]motion %s: baked error %.4f exceeds %.4f, evaluating curves", name, motion->GetBakedMaxError(), MotionBakeMaxError);
+        }
+        motion->Bake(0.0f);
     }
 }
 
 void CubismUserModelExtend::ReleaseModelSetting()
 {
     // 释放动作（motion）
-    for (Csm::csmMap<Csm::csmString, Csm::ACubismMotion*>::const_iterator iter = _motions.Begin(); iter != _motions.End(); ++iter)
+    for (std::deque<MotionEntry>::iterator it = _motionEntries.begin(); it != _motionEntries.end(); ++it)
     {
-        Csm::ACubismMotion::Delete(iter->Second);
+        if (it->load.motion != NULL)
+        {
+            Csm::ACubismMotion::Delete(it->load.motion);
+            LAppModelCache::GetInstance()->TrimMotion(_modelCache, it->load.name);
+        }
     }
 
     _motions.Clear();
+    _motionEntries.clear();
+    _motionGroups.clear();
 
     // 释放所有表情数据
     for (Csm::csmMap<Csm::csmString, Csm::ACubismMotion*>::const_iterator iter = _expressions.Begin(); iter != _expressions.End(); ++iter)
@@ -223,6 +619,7 @@ void CubismUserModelExtend::ReleaseModelSetting()
     }
 
     _expressions.Clear();
+    _expressionNames.clear();
 
     delete(_modelJson);
 }
@@ -233,12 +630,19 @@ void CubismUserModelExtend::ReleaseModelSetting()
  * @param[in] group 动作组名称
  * @param[in] no    组内索引
  * @param[in] priority 优先级
- * @return 返回已开始动作的识别 ID。用于 IsFinished() 判断单个动作是否结束。无法开始时返回 -1。
+ * @return 返回已开始动作的识别 ID。用于 IsFinished() 判断单个动作是否结束。
+ *         无法开始时返回 -1；动作正在加载、加载完成后才开始时也返回 -1（IsMotionPending() 为 true）。
  */
 Csm::CubismMotionQueueEntryHandle CubismUserModelExtend::StartMotion(const Csm::csmChar* group, Csm::csmInt32 no, Csm::csmInt32 priority)
 {
-    // 未能获取到动作数量或数量为 0
-    if (!(_modelJson->GetMotionCount(group)))
+    // ex) idle_0
+    // 空闲动作每播放完一次就会调用这里，名称在栈上格式化（短字符串不需要分配）
+    csmChar nameBuffer[64];
+    snprintf(nameBuffer, sizeof(nameBuffer), "%s_%d", group, no);
+    const csmString name(nameBuffer);
+
+    // model3.json 中没有该动作
+    if (!_motions.IsExist(name))
     {
         return Csm::InvalidMotionQueueEntryHandleValue;
     }
@@ -253,53 +657,60 @@ Csm::CubismMotionQueueEntryHandle CubismUserModelExtend::StartMotion(const Csm::
         return Csm::InvalidMotionQueueEntryHandleValue;
     }
 
-    // 获取指定的 .motion3.json 文件名
-    const Csm::csmString fileName = _modelJson->GetMotionFileName(group, no);
-
-    // ex) idle_0
-    // 生成动作数据对象
-    csmString name = Utils::CubismString::GetFormatedString("%s_%d", group, no);
-    CubismMotion* motion = static_cast<CubismMotion*>(_motions[name.GetRawString()]);
-    csmBool autoDelete = false;
+    MotionEntry* entry = _motions[name];
+    entry->lastUse = ++_motionUseCounter;
 
-    if (!motion)
+    if (!entry->loading && entry->load.motion != NULL)
     {
-        csmString path = fileName;
-        path = csmString(_currentModelDirectory.c_str()) + path;
-
-        csmByte* buffer;
-        csmSizeInt size;
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        // 加载第一个（首个）动作
-        motion = static_cast<CubismMotion*>(LoadMotion(buffer, size, NULL, NULL, NULL, _modelJson, group, no));
-
-        if (motion)
+        _motionCacheHits++;
+        // 同等以上优先级的动作开始后，不再播放等待加载的动作
+        if (_pendingMotion != NULL && priority >= _pendingMotionPriority)
         {
-            // 在结束时从内存中删除
-            autoDelete = true;
+            _pendingMotion = NULL;
+            _hasPendingMotion = false;
         }
+        // 设置优先级并开始动作
+        return _motionManager->StartMotionPriority(entry->load.motion, false, priority);
+    }
+
+    // 尚未加载：解除预约，加载期间当前动作播放完后仍可重新开始空闲动作
+    if (_motionManager->GetReservePriority() == priority)
+    {
+        _motionManager->SetReservePriority(0);
+    }
 
-        DeleteBuffer(buffer, path.GetRawString());
+    // 等待中的动作只被同等以上优先级的请求替换
+    if (_pendingMotion != NULL && priority < _pendingMotionPriority)
+    {
+        return Csm::InvalidMotionQueueEntryHandleValue;
     }
 
-    // 设置优先级并开始动作
-    return  _motionManager->StartMotionPriority(motion, autoDelete, priority);
+    _motionCacheMisses++;
+    _pendingMotion = entry;
+    _pendingMotionPriority = priority;
+    _hasPendingMotion = true;
+    if (!entry->loading)
+    {
+        LAppLogDebug(Category_Model, "motion cache miss: %s", entry->load.name.GetRawString());
+        LoadMotionAsync(entry);
+    }
+
+    return Csm::InvalidMotionQueueEntryHandleValue;
 }
 
-void CubismUserModelExtend::ModelParamUpdate()
+void CubismUserModelExtend::ModelParamUpdate(Csm::csmFloat32 deltaTimeSeconds)
 {
-    // 获取与上一帧的时间差
-    const Csm::csmFloat32 deltaTimeSeconds = LAppPal::GetDeltaTime();
     _userTimeSeconds += deltaTimeSeconds;
 
-    // 更新拖拽信息
-    _dragManager->Update(deltaTimeSeconds);
-    _dragX = _dragManager->GetX();
-    _dragY = _dragManager->GetY();
-
     // 是否有动作（motion）更新参数
     Csm::csmBool motionUpdated = false;
 
+    // 登记按需加载完成的动作（没有加载中的动作时不加锁）
+    if (_loadingMotionCount > 0)
+    {
+        ProcessLoadedMotions();
+    }
+
     // 加载上一次保存的状态
     _model->LoadParameters();
 
@@ -340,16 +751,16 @@ void CubismUserModelExtend::ModelParamUpdate()
     * 通过拖拽调整面部朝向
     * 添加 -30 到 30 的值
     */
-    _model->AddParameterValue(_idParamAngleX, _dragX * 30.0f);
-    _model->AddParameterValue(_idParamAngleY, _dragY * 30.0f);
-    _model->AddParameterValue(_idParamAngleZ, _dragX * _dragY * -30.0f);
+    _model->AddParameterValue(_indexParamAngleX, _dragX * 30.0f);
+    _model->AddParameterValue(_indexParamAngleY, _dragY * 30.0f);
+    _model->AddParameterValue(_indexParamAngleZ, _dragX * _dragY * -30.0f);
 
     // 通过拖拽调整身体的朝向
-    _model->AddParameterValue(_idParamBodyAngleX, _dragX * 10.0f); // 添加 -10 到 10 的值
+    _model->AddParameterValue(_indexParamBodyAngleX, _dragX * 10.0f); // 添加 -10 到 10 的值
 
     // 通过拖拽调整眼睛朝向
-    _model->AddParameterValue(_idParamEyeBallX, _dragX); // 添加 -1 到 1 的值
-    _model->AddParameterValue(_idParamEyeBallY, _dragY);
+    _model->AddParameterValue(_indexParamEyeBallX, _dragX); // 添加 -1 到 1 的值
+    _model->AddParameterValue(_indexParamEyeBallY, _dragY);
 
     // 应用物理演算设置（如果存在）
     if (_physics)
@@ -386,6 +797,9 @@ void CubismUserModelExtend::Draw(Csm::CubismMatrix44& matrix)
 
 void CubismUserModelExtend::SetupTextures()
 {
+    // 只有全部纹理都已预乘时才使用 PremultipliedAlpha 着色器
+    csmBool premultipliedAlpha = true;
+
     for (csmInt32 modelTextureNumber = 0; modelTextureNumber < _modelJson->GetTextureCount(); modelTextureNumber++)
     {
         // 若纹理名为空则跳过加载与绑定
@@ -398,22 +812,29 @@ void CubismUserModelExtend::SetupTextures()
         csmString texturePath = _modelJson->GetTextureFileName(modelTextureNumber);
         texturePath = csmString(_currentModelDirectory.c_str()) + texturePath;
 
-        LAppTextureManager::TextureInfo* texture = _textureManager->CreateTextureFromPngFile(texturePath.GetRawString());
+        // 解码在工作线程中进行，完成前绑定的是占位图（上传由 main.cpp 每帧推进）
+        LAppTextureManager::TextureInfo* texture = _textureManager->CreateTextureFromPngFileAsync(texturePath.GetRawString());
+        if (!texture)
+        {
+            continue;
+        }
         const csmInt32 glTextueNumber = texture->id;
+        _textureIds.PushBack(texture->id);
+        premultipliedAlpha = premultipliedAlpha && texture->premultipliedAlpha;
 
         // OpenGL
         GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->BindTexture(modelTextureNumber, glTextueNumber);
     }
 
-    // 设置是否启用预乘（premultiplied）alpha
-    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->IsPremultipliedAlpha(false);
+    // 设置是否启用预乘（premultiplied）alpha，渲染器据此选择对应的着色器组
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->IsPremultipliedAlpha(premultipliedAlpha);
 }
 
 // 按表情名查找并切换表情（如果存在）
 void CubismUserModelExtend::SetExpressionByName(const std::string& name)
 {
     // 默认播放并将其设置为临时表情（使用默认持续时间）
-    PlayExpression(name, _defaultExpressionDuration);
+    RequestExpression(name, _defaultExpressionDuration);
 }
 
 // 根据 AI 文本进行简单关键词映射到表情名，然后调用 SetExpressionByName
@@ -470,23 +891,34 @@ void CubismUserModelExtend::SetExpressionByAIText(const std::string& text)
     }
 
     // 播放表情，默认使用默认持续时间（会在到期后恢复）
-    PlayExpression(name, _defaultExpressionDuration);
+    RequestExpression(name, _defaultExpressionDuration);
+}
+
+void CubismUserModelExtend::RequestExpression(const std::string& name, float durationSeconds)
+{
+    if (_updateThread.joinable())
+    {
+        // 表情管理器与计时只在更新线程中访问
+        std::lock_guard<std::mutex> lock(_pipelineMutex);
+        _pendingExpressions.emplace_back(name, durationSeconds);
+        return;
+    }
+
+    PlayExpression(name, durationSeconds);
 }
 
 // 内部通用播放函数，可指定持续时间（<=0 表示不自动恢复）
 void CubismUserModelExtend::PlayExpression(const std::string& name, float durationSeconds)
 {
-    std::cout << "[Expression] Request PlayExpression name='" << name << "' duration=" << durationSeconds << std::endl;
     if (!_expressionManager) {
-        std::cout << "[Expression] No _expressionManager available" << std::endl;
+        LAppLogWarning(Category_Expression, "No _expressionManager available");
         return;
     }
 
     Csm::ACubismMotion* motion = nullptr;
     for (auto iter = _expressions.Begin(); iter != _expressions.End(); ++iter)
     {
-        const std::string k = iter->First.GetRawString();
-        if (k == name && iter->Second != nullptr)
+        if (name == iter->First.GetRawString() && iter->Second != nullptr)
         {
             motion = iter->Second;
             break;
@@ -494,11 +926,11 @@ void CubismUserModelExtend::PlayExpression(const std::string& name, float durati
     }
 
     if (!motion) {
-        std::cout << "[Expression] Motion '" << name << "' not found in _expressions" << std::endl;
+        LAppLogWarning(Category_Expression, "Motion '%s' not found in _expressions", name.c_str());
         return;
     }
 
-    std::cout << "[Expression] Found motion for '" << name << "', starting" << std::endl;
+    LAppLogDebug(Category_Expression, "Start '%s' duration=%.2f", name.c_str(), durationSeconds);
     _expressionManager->StartMotion(motion, false);
 
     _currentExpressionName = name;
@@ -515,14 +947,45 @@ void CubismUserModelExtend::PlayExpression(const std::string& name, float durati
     }
 }
 
-std::vector<std::string> CubismUserModelExtend::GetExpressionNames() const
+const std::vector<std::string>& CubismUserModelExtend::GetExpressionNames() const
 {
-    std::vector<std::string> list;
-    for (auto iter = _expressions.Begin(); iter != _expressions.End(); ++iter)
+    return _expressionNames;
+}
+
+void CubismUserModelExtend::RequestMotion(const std::string& group, int no, int priority)
+{
+    if (_updateThread.joinable())
     {
-        list.emplace_back(iter->First.GetRawString());
+        // 动作管理器与动作缓存只在更新线程中访问
+        std::lock_guard<std::mutex> lock(_pipelineMutex);
+        MotionRequest request = { group, no, priority };
+        _pendingMotionRequests.push_back(request);
+        return;
     }
-    return list;
+
+    StartMotion(group.c_str(), no, priority);
+}
+
+const std::vector<std::pair<std::string, int>>& CubismUserModelExtend::GetMotionGroups() const
+{
+    return _motionGroups;
+}
+
+CubismUserModelExtend::MotionCacheStats CubismUserModelExtend::GetMotionCacheStats() const
+{
+    MotionCacheStats stats;
+    stats.hits = _motionCacheHits;
+    stats.misses = _motionCacheMisses;
+    stats.evictions = _motionCacheEvictions;
+    stats.residentBytes = _motionResidentBytes;
+    stats.cachedBytes = _motionCachedBytes;
+    stats.cachedCount = _motionCachedCount;
+    return stats;
+}
+
+bool CubismUserModelExtend::IsMotionPending() const
+{
+    return _hasPendingMotion;
 }
 
 void CubismUserModelExtend::ModelOnUpdate(GLFWwindow* window)
@@ -552,9 +1015,250 @@ void CubismUserModelExtend::ModelOnUpdate(GLFWwindow* window)
         projection.MultiplyByMatrix(MouseActionManager::GetInstance()->GetViewMatrix());
     }
 
-    // 更新模型参数
-    ModelParamUpdate();
+    // 获取与上一帧的时间差
+    const Csm::csmFloat32 deltaTimeSeconds = LAppPal::GetDeltaTime();
+
+    // 更新拖拽信息（SetDragging 由鼠标回调在本线程调用，平滑也在本线程进行）
+    _dragManager->Update(deltaTimeSeconds);
+
+    if (_updateThread.joinable())
+    {
+        // 取出上一次更新的结果，并让更新线程在绘制期间计算下一帧
+        SubmitPipelinedUpdate(deltaTimeSeconds, _dragManager->GetX(), _dragManager->GetY());
+    }
+    else
+    {
+        _dragX = _dragManager->GetX();
+        _dragY = _dragManager->GetY();
+
+        // 更新模型参数
+        ModelParamUpdate(deltaTimeSeconds);
+    }
 
     // 更新模型绘制（projection 作为引用会被修改）
     Draw(projection);
 }
+
+void CubismUserModelExtend::StartUpdateThread()
+{
+    Core::csmModel* model = _model->GetModel();
+    const csmInt32 drawableCount = Core::csmGetDrawableCount(model);
+    const csmInt32* vertexCounts = Core::csmGetDrawableVertexCounts(model);
+
+    _snapshotVertexOffsets.resize(drawableCount + 1);
+    _snapshotVertexOffsets[0] = 0;
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        _snapshotVertexOffsets[i + 1] = _snapshotVertexOffsets[i] + vertexCounts[i];
+    }
+
+    for (DrawableSnapshot& snapshot : _snapshots)
+    {
+        snapshot.vertexPositions.resize(_snapshotVertexOffsets[drawableCount]);
+        snapshot.vertexPositionPointers.resize(drawableCount);
+        snapshot.opacities.resize(drawableCount);
+        snapshot.renderOrders.resize(drawableCount);
+        snapshot.dynamicFlags.resize(drawableCount);
+        snapshot.multiplyColors.resize(drawableCount);
+        snapshot.screenColors.resize(drawableCount);
+
+        for (csmInt32 i = 0; i < drawableCount; i++)
+        {
+            snapshot.vertexPositionPointers[i] = snapshot.vertexPositions.data() + _snapshotVertexOffsets[i];
+        }
+
+        snapshot.source.VertexPositions = snapshot.vertexPositionPointers.data();
+        snapshot.source.Opacities = snapshot.opacities.data();
+        snapshot.source.RenderOrders = snapshot.renderOrders.data();
+        snapshot.source.DynamicFlags = snapshot.dynamicFlags.data();
+        snapshot.source.MultiplyColors = snapshot.multiplyColors.data();
+        snapshot.source.ScreenColors = snapshot.screenColors.data();
+    }
+
+    // 初始状态作为第一份快照，保证第一帧就有可绘制的数据
+    _model->Update();
+    CaptureSnapshot(_snapshots[0]);
+    _snapshots[0].inputTime = std::chrono::steady_clock::now();
+    _snapshots[0].inputFrame = 0;
+    ApplySnapshot(_snapshots[0]);
+
+    _publishedSnapshot = 0;
+    _readingSnapshot = 0;
+    _publishedSequence = 1;
+    _appliedSequence = 1;
+    _pipelineStopping = false;
+    _latencyLogTime = std::chrono::steady_clock::now();
+
+    _updateThread = std::thread(&CubismUserModelExtend::UpdateThreadMain, this);
+}
+
+void CubismUserModelExtend::StopUpdateThread()
+{
+    if (!_updateThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_pipelineMutex);
+        _pipelineStopping = true;
+    }
+    _pipelineCondition.notify_all();
+    _updateThread.join();
+}
+
+void CubismUserModelExtend::UpdateThreadMain()
+{
+    std::vector<std::pair<std::string, float>> expressions;
+    std::vector<MotionRequest> motions;
+
+    for (;;)
+    {
+        UpdateRequest request;
+        {
+            std::unique_lock<std::mutex> lock(_pipelineMutex);
+            _pipelineCondition.wait(lock, [this] { return _pipelineStopping || _updateRequest.pending; });
+            if (_pipelineStopping)
+            {
+                return;
+            }
+
+            request = _updateRequest;
+            _updateRequest.pending = false;
+            _updateRequest.deltaTimeSeconds = 0.0f;
+            expressions.swap(_pendingExpressions);
+            motions.swap(_pendingMotionRequests);
+        }
+
+        for (const auto& expression : expressions)
+        {
+            PlayExpression(expression.first, expression.second);
+        }
+        expressions.clear();
+
+        for (const auto& motion : motions)
+        {
+            StartMotion(motion.group.c_str(), motion.no, motion.priority);
+        }
+        motions.clear();
+
+        _dragX = request.dragX;
+        _dragY = request.dragY;
+        ModelParamUpdate(request.deltaTimeSeconds);
+
+        // 写入既未发布、也不在绘制中的那一份。OpenGL 线程只会改为读取已发布的快照，
+        // 因此写入期间不会与绘制冲突，也不必等待
+        int target = 0;
+        {
+            std::lock_guard<std::mutex> lock(_pipelineMutex);
+            while (target == _publishedSnapshot || target == _readingSnapshot)
+            {
+                target++;
+            }
+        }
+
+        CaptureSnapshot(_snapshots[target]);
+        _snapshots[target].inputTime = request.inputTime;
+        _snapshots[target].inputFrame = request.inputFrame;
+
+        {
+            std::lock_guard<std::mutex> lock(_pipelineMutex);
+            _publishedSnapshot = target;
+            ++_publishedSequence;
+        }
+    }
+}
+
+void CubismUserModelExtend::SubmitPipelinedUpdate(csmFloat32 deltaTimeSeconds, csmFloat32 dragX, csmFloat32 dragY)
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    int snapshotIndex = -1;
+
+    {
+        std::lock_guard<std::mutex> lock(_pipelineMutex);
+
+        // 有新发布的快照时改为读取它；更新线程还没算完时沿用上一帧的快照
+        if (_publishedSequence != _appliedSequence)
+        {
+            snapshotIndex = _publishedSnapshot;
+            _readingSnapshot = snapshotIndex;
+            _appliedSequence = _publishedSequence;
+        }
+
+        _updateRequest.pending = true;
+        _updateRequest.deltaTimeSeconds += deltaTimeSeconds;
+        _updateRequest.dragX = dragX;
+        _updateRequest.dragY = dragY;
+        _updateRequest.inputTime = now;
+        _updateRequest.inputFrame = _frameNumber;
+    }
+    _pipelineCondition.notify_all();
+
+    if (snapshotIndex >= 0)
+    {
+        ApplySnapshot(_snapshots[snapshotIndex]);
+        RecordInputLatency(_snapshots[snapshotIndex], now);
+    }
+
+    ++_frameNumber;
+}
+
+void CubismUserModelExtend::CaptureSnapshot(DrawableSnapshot& snapshot) const
+{
+    const Core::csmModel* model = _model->GetModel();
+    const csmInt32 drawableCount = static_cast<csmInt32>(snapshot.opacities.size());
+    const Core::csmVector2** vertexPositions = Core::csmGetDrawableVertexPositions(model);
+
+    for (csmInt32 i = 0; i < drawableCount; i++)
+    {
+        const csmInt32 offset = _snapshotVertexOffsets[i];
+        memcpy(&snapshot.vertexPositions[offset], vertexPositions[i], (_snapshotVertexOffsets[i + 1] - offset) * sizeof(Core::csmVector2));
+    }
+
+    memcpy(snapshot.opacities.data(), Core::csmGetDrawableOpacities(model), drawableCount * sizeof(csmFloat32));
+    memcpy(snapshot.renderOrders.data(), Core::csmGetDrawableRenderOrders(model), drawableCount * sizeof(csmInt32));
+    memcpy(snapshot.dynamicFlags.data(), Core::csmGetDrawableDynamicFlags(model), drawableCount * sizeof(Core::csmFlags));
+    memcpy(snapshot.multiplyColors.data(), Core::csmGetDrawableMultiplyColors(model), drawableCount * sizeof(Core::csmVector4));
+    memcpy(snapshot.screenColors.data(), Core::csmGetDrawableScreenColors(model), drawableCount * sizeof(Core::csmVector4));
+}
+
+void CubismUserModelExtend::ApplySnapshot(const DrawableSnapshot& snapshot)
+{
+    // 渲染器经由 CubismModel 的访问函数读取 Drawable 数据，_renderModel 的 Core 数组保持初始状态不用
+    _renderModel->SetDrawableDynamicSource(&snapshot.source);
+}
+
+void CubismUserModelExtend::RecordInputLatency(const DrawableSnapshot& snapshot, std::chrono::steady_clock::time_point now)
+{
+    // 快照中的拖拽在 inputFrame 帧开头采样，在本帧（_frameNumber）显示
+    const double milliseconds = std::chrono::duration<double, std::milli>(now - snapshot.inputTime).count();
+    const csmUint64 frames = _frameNumber - snapshot.inputFrame;
+
+    _latencySamples++;
+    _latencyTotalMilliseconds += milliseconds;
+    if (milliseconds > _latencyMaxMilliseconds)
+    {
+        _latencyMaxMilliseconds = milliseconds;
+    }
+    if (frames > _latencyMaxFrames)
+    {
+        _latencyMaxFrames = frames;
+    }
+
+    if (std::chrono::duration<float>(now - _latencyLogTime).count() < PipelineLatencyLogInterval)
+    {
+        return;
+    }
+
+    if (DebugLogEnable)
+    {
+        LAppPal::PrintLogLn("[APP]drag latency: avg %.2f ms, max %.2f ms, max %llu frame(s)",
+            _latencyTotalMilliseconds / _latencySamples, _latencyMaxMilliseconds, _latencyMaxFrames);
+    }
+
+    _latencySamples = 0;
+    _latencyTotalMilliseconds = 0.0;
+    _latencyMaxMilliseconds = 0.0;
+    _latencyMaxFrames = 0;
+    _latencyLogTime = now;
+}
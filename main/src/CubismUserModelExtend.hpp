@@ -7,13 +7,25 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <CubismFramework.hpp>
 #include <CubismModelSettingJson.hpp>
+#include <Motion/CubismMotion.hpp>
 
 #include "LAppTextureManager.hpp"
+#include "LAppModelCache.hpp"
+#include "LAppModelPack.hpp"
+#include "LAppTaskPool.hpp"
 #include "LAppModel_Common.hpp"
 
  /**
@@ -36,10 +48,43 @@ public:
     */
     void LoadAssets(const  Csm::csmChar* fileName);
 
+    /**
+    * @brief 与 LoadAssets 相同，但不创建渲染器与纹理（不调用 OpenGL，可在后台线程中调用）
+    *
+    * 切换模型时用于在后台加载新模型，完成后需在 OpenGL 线程中调用 SetupGraphics。
+    */
+    void LoadModelData(const  Csm::csmChar* fileName);
+
+    /**
+    * @brief 创建渲染器与纹理并开始更新（OpenGL 线程，LoadModelData 之后调用）
+    *
+    * 纹理的解码在工作线程中进行，可用 IsTexturesReady 判断是否已全部上传。
+    */
+    void SetupGraphics();
+
+    /**
+    * @brief 本模型的纹理是否已全部加载结束（之前以占位图绘制）
+    *
+    * 解码失败的纹理也视为结束，需再用 HasFailedTextures 判断是否全部成功。
+    */
+    bool IsTexturesReady() const;
+
+    /**
+    * @brief 本模型是否有解码失败的纹理（失败的纹理保留 1x1 透明占位图）
+    */
+    bool HasFailedTextures() const;
+
+    /**
+    * @brief 设置整个模型的不透明度（切换模型时的交叉淡入淡出用）
+    */
+    void SetOpacity(float opacity);
+
     /**
     * @brief 更新模型
     *
-    * 更新模型的状态和渲染
+    * 更新模型的状态和渲染。
+    * 启用 LAppDefine::PipelinedUpdateEnable 时，本函数只取出更新线程发布的最新快照并绘制，
+    * 同时请求更新线程计算下一帧，不会等待 csmUpdateModel。
     */
     void ModelOnUpdate(GLFWwindow* window);
 
@@ -57,30 +102,117 @@ public:
 
     /**
     * @brief 返回已加载的表情名称列表（用于调试/UI）
+    *
+    * 列表在加载表情时生成，调试面板每帧读取也不会复制。
     */
-    std::vector<std::string> GetExpressionNames() const;
+    const std::vector<std::string>& GetExpressionNames() const;
 
     /**
     * @brief 设置默认表情持续时间（秒），<=0 表示不自动恢复
     */
     void SetDefaultExpressionDuration(float seconds) { _defaultExpressionDuration = seconds; }
 
+    /**
+    * @brief 动作缓存的统计
+    */
+    struct MotionCacheStats
+    {
+        Csm::csmUint64 hits;            ///< 请求播放时动作已在内存中的次数（含常驻的待机组）
+        Csm::csmUint64 misses;          ///< 请求播放时需要加载的次数
+        Csm::csmUint64 evictions;       ///< 按 LRU 释放的次数
+        Csm::csmSizeInt residentBytes;  ///< 常驻动作占用的字节数
+        Csm::csmSizeInt cachedBytes;    ///< 按需加载的动作占用的字节数
+        Csm::csmUint32 cachedCount;     ///< 按需加载且尚未释放的动作数
+    };
+
+    /**
+    * @brief 播放指定的动作。流水线模式下排队，在下一次更新开始时由更新线程处理
+    *
+    * 动作尚未加载时在任务池中加载，完成后再开始播放，加载期间继续播放当前的动作。
+    *
+    * @param[in] group    动作组名
+    * @param[in] no       组内序号
+    * @param[in] priority 优先级（LAppDefine::PriorityIdle 等）
+    */
+    void RequestMotion(const std::string& group, int no, int priority);
+
+    /**
+    * @brief 返回动作组名与各组的动作数（按 model3.json 中的顺序，用于调试/UI）
+    */
+    const std::vector<std::pair<std::string, int>>& GetMotionGroups() const;
+
+    /**
+    * @brief 返回动作缓存的统计（可在任意线程调用）
+    */
+    MotionCacheStats GetMotionCacheStats() const;
+
+    /**
+    * @brief 是否有等待加载完成后开始播放的动作（可在任意线程调用）
+    */
+    bool IsMotionPending() const;
+
 private:
+    /**
+    * @brief 在任务池中加载的表情或动作
+    *
+    * 路径等在提交前由 OpenGL 线程从 model3.json 取出，工作线程只写入 motion。
+    */
+    struct AssetLoad
+    {
+        Csm::csmString name;            ///< 登记名（表情名，或 "组名_序号" 形式的动作名）
+        Csm::csmString path;            ///< 文件路径
+        Csm::csmFloat32 fadeInTime;     ///< model3.json 中指定的淡入时间[秒]（未指定时为负）
+        Csm::csmFloat32 fadeOutTime;    ///< model3.json 中指定的淡出时间[秒]（未指定时为负）
+        Csm::ACubismMotion* motion;     ///< 加载结果（失败时为 NULL）
+    };
+
+    /**
+    * @brief 动作缓存中的一个动作
+    *
+    * 待机组（LAppDefine::MotionGroupIdle）在 SetupModel 中加载并常驻；其余动作在第一次请求播放时
+    * 由任务池加载，合计超过 LAppDefine::MotionCacheBudgetBytes 时释放最久未请求且不在播放中的动作。
+    * loading 为 true 期间 load.motion 只由加载任务写入，其余时间只在更新动作的线程中访问。
+    */
+    struct MotionEntry
+    {
+        AssetLoad load;                 ///< 路径、淡入淡出时间与加载结果
+        bool resident;                  ///< 是否常驻
+        bool loading;                   ///< 是否正在任务池中加载
+        Csm::csmSizeInt bytes;          ///< 加载后占用的字节数
+        Csm::csmUint64 lastUse;         ///< 最近一次请求播放的序号（LRU）
+    };
+
+    /**
+    * @brief 流水线模式下排队的动作请求
+    */
+    struct MotionRequest
+    {
+        std::string group;              ///< 动作组名
+        int no;                         ///< 组内序号
+        int priority;                   ///< 优先级
+    };
+
     /**
     * @brief 从 model3.json 生成模型
     *
-    * 根据 model3.json 的描述生成模型，并创建动作、物理等组件
+    * 根据 model3.json 的描述生成模型，并创建动作、物理等组件。
+    * 各文件的读取与解析在 LAppTaskPool 中并行进行，本线程只创建渲染器与纹理。
     *
-    * @param[in]   setting     ICubismModelSetting 的实例
+    * @param[in] setupGraphics 是否同时创建渲染器与纹理（为 false 时不调用 OpenGL，之后需调用 SetupGraphics）
     */
-    void SetupModel();
+    void SetupModel(Csm::csmBool setupGraphics);
     /**
     * @brief 开始播放由参数指定的动作
     *
+    * 动作尚未加载时记为等待中的动作并开始加载，加载完成后由 ProcessLoadedMotions 开始播放。
+    * 等待期间不占用动作管理器的预约，当前动作与空闲动作照常播放；
+    * 优先级不低于等待中动作的新请求会取代它，更低的未加载请求会被拒绝。
+    *
     * @param[in] group    动作组名
     * @param[in] no       组内序号
     * @param[in] priority 优先级
-    * @return 返回已开始动作的识别编号，用于 IsFinished() 判断。无法开始时返回 -1。
+    * @return 返回已开始动作的识别编号，用于 IsFinished() 判断。
+    *         无法开始时返回 -1；正在加载时同样返回 -1，此时 IsMotionPending() 为 true。
     */
     Csm::CubismMotionQueueEntryHandle StartMotion(const Csm::csmChar* group, Csm::csmInt32 no, Csm::csmInt32 priority);
 
@@ -101,9 +233,92 @@ private:
     /**
     * @brief 更新模型参数信息
     *
-    * 更新模型的参数信息
+    * 更新模型的参数信息。流水线模式下在更新线程中调用。
+    *
+    * @param[in] deltaTimeSeconds 与上一次更新的时间差[秒]
+    */
+    void ModelParamUpdate(Csm::csmFloat32 deltaTimeSeconds);
+
+    /**
+    * @brief 绘制所需的 Drawable 动态数据
+    *
+    * 由更新线程在 csmUpdateModel 之后写入，OpenGL 线程把它设为 _renderModel 的 Drawable 数据源后绘制。
+    * 数组在 StartUpdateThread 中按模型的 Drawable 数量分配，之后不再改变大小，source 中的指针一直有效。
+    */
+    struct DrawableSnapshot
+    {
+        std::vector<Live2D::Cubism::Core::csmVector2> vertexPositions;  ///< 全部 Drawable 的顶点（按 _snapshotVertexOffsets 排列）
+        std::vector<const Live2D::Cubism::Core::csmVector2*> vertexPositionPointers; ///< 各 Drawable 顶点在 vertexPositions 中的起始位置
+        std::vector<Csm::csmFloat32> opacities;                         ///< 不透明度
+        std::vector<Csm::csmInt32> renderOrders;                        ///< 渲染顺序
+        std::vector<Live2D::Cubism::Core::csmFlags> dynamicFlags;       ///< 动态标志（可见性等）
+        std::vector<Live2D::Cubism::Core::csmVector4> multiplyColors;   ///< 乘算色
+        std::vector<Live2D::Cubism::Core::csmVector4> screenColors;     ///< 屏幕色
+        Csm::CubismModel::DrawableDynamicSource source;                 ///< 指向以上数组，交给 _renderModel
+        std::chrono::steady_clock::time_point inputTime;                ///< 本次更新所用拖拽输入的采样时刻
+        Csm::csmUint64 inputFrame;                                      ///< 采样拖拽输入时的帧号
+    };
+
+    /**
+    * @brief OpenGL 线程提交给更新线程的请求
+    *
+    * 更新线程未处理完时，新的请求合并到未处理的请求中：时间差累加，拖拽取最新值。
+    */
+    struct UpdateRequest
+    {
+        bool pending;                                       ///< 是否有未处理的请求
+        Csm::csmFloat32 deltaTimeSeconds;                   ///< 累计的时间差[秒]
+        Csm::csmFloat32 dragX;                              ///< 拖拽 X
+        Csm::csmFloat32 dragY;                              ///< 拖拽 Y
+        std::chrono::steady_clock::time_point inputTime;    ///< 拖拽输入的采样时刻
+        Csm::csmUint64 inputFrame;                          ///< 采样拖拽输入时的帧号
+    };
+
+    /**
+    * @brief 创建绘制用模型与快照缓冲，发布初始快照并启动更新线程
     */
-    void ModelParamUpdate();
+    void StartUpdateThread();
+
+    /**
+    * @brief 停止并等待更新线程
+    */
+    void StopUpdateThread();
+
+    /**
+    * @brief 更新线程主循环
+    */
+    void UpdateThreadMain();
+
+    /**
+    * @brief 在 OpenGL 线程中取出最新快照并提交下一帧的更新请求
+    *
+    * @param[in] deltaTimeSeconds 与上一帧的时间差[秒]
+    * @param[in] dragX            拖拽 X
+    * @param[in] dragY            拖拽 Y
+    */
+    void SubmitPipelinedUpdate(Csm::csmFloat32 deltaTimeSeconds, Csm::csmFloat32 dragX, Csm::csmFloat32 dragY);
+
+    /**
+    * @brief 把 _model 的 Drawable 动态数据写入快照（更新线程）
+    */
+    void CaptureSnapshot(DrawableSnapshot& snapshot) const;
+
+    /**
+    * @brief 让 _renderModel 从快照读取 Drawable 数据（OpenGL 线程）
+    *
+    * 设置后直到下一次调用，渲染器都会读取该快照，期间它保持为 _readingSnapshot。
+    */
+    void ApplySnapshot(const DrawableSnapshot& snapshot);
+
+    /**
+    * @brief 统计拖拽输入到绘制的延迟，并按 PipelineLatencyLogInterval 输出
+    */
+    void RecordInputLatency(const DrawableSnapshot& snapshot, std::chrono::steady_clock::time_point now);
+
+    /**
+    * @brief 播放表情。流水线模式下排队，在下一次更新开始时由更新线程播放
+    */
+    void RequestExpression(const std::string& name, float durationSeconds);
 
 
     /**
@@ -115,24 +330,77 @@ private:
     void PlayExpression(const std::string& name, float durationSeconds);
 
     /**
-    * @brief 根据组名批量加载动作数据
+    * @brief 登记组中的全部动作，常驻的组同时把读取与解析提交到任务池
     *
-    * 动作数据的名称从 ModelSetting 中获取
+    * 动作数据的名称从 ModelSetting 中获取。加载结果在 tasks 完成后写入各表项。
     *
-    * @param[in]   group  动作组名
+    * @param[in]   group     动作组名
+    * @param[in]   resident  是否常驻（否则在第一次请求播放时加载）
+    * @param[in]   tasks     任务所属的组
     */
-    void PreloadMotionGroup(const Csm::csmChar * group);
+    void PreloadMotionGroup(const Csm::csmChar * group, bool resident, LAppTaskPool::Group* tasks);
+
+    /**
+    * @brief 读取并解析一个动作文件（在任务池中调用，不访问 model3.json）
+    *
+    * 同一模型的其他实例已解析过该动作时不再读取文件，与其共用曲线与烘焙表。
+    *
+    * @param[in]   load  路径、名称与淡入淡出时间
+    * @return 动作；读取失败时返回 NULL
+    */
+    Csm::CubismMotion* LoadMotionAsset(const AssetLoad& load);
+
+    /**
+    * @brief 读取并解析动作文件（.bin 损坏时改读 JSON），按 model3.json 覆盖淡入淡出时间并烘焙（LoadMotionAsset 中没有共用的动作时调用）
+    */
+    Csm::CubismMotion* ParseMotionAsset(const AssetLoad& load);
+
+    /**
+    * @brief 在任务池中加载未常驻的动作
+    */
+    void LoadMotionAsync(MotionEntry* entry);
+
+    /**
+    * @brief 登记加载完成的动作，开始播放等待中的动作，并按预算释放旧的动作
+    */
+    void ProcessLoadedMotions();
+
+    /**
+    * @brief 按预算释放最久未请求且不在播放中的动作
+    */
+    void EvictMotions();
+
+    /**
+    * @brief 动作是否在动作队列中（播放中或淡出中）
+    */
+    bool IsMotionQueued(const Csm::ACubismMotion* motion);
+
+    /**
+    * @brief 按 LAppDefine 的设置烘焙动作曲线
+    *
+    * 误差超过 MotionBakeMaxError 的动作丢弃采样表，仍按曲线求值。
+    *
+    * @param[in]   motion  刚加载的动作
+    * @param[in]   name    动作名（用于日志）
+    */
+    void BakeMotion(Csm::CubismMotion* motion, const Csm::csmChar* name);
 
     std::string _modelDirName; ///< 存放模型设置的目录名称
     std::string _currentModelDirectory; ///< 当前模型目录
+    LAppModelPack* _modelPack; ///< 挂载的模型包（目录旁没有 .aipack 时为 NULL）
+    LAppModelCache::Entry* _modelCache; ///< 同一模型的各实例共用的 moc、动作、表情与物理设置
 
     Csm::csmFloat32 _userTimeSeconds; ///< 累计的时间差[秒]
     Csm::CubismModelSettingJson* _modelJson; ///< 模型设置信息
     Csm::csmVector<Csm::CubismIdHandle> _eyeBlinkIds; ///< 模型设置的眨眼参数 ID
-    Csm::csmMap<Csm::csmString, Csm::ACubismMotion*> _motions; ///< 已加载的动作列表
+    std::deque<MotionEntry> _motionEntries; ///< 全部动作（按 model3.json 中的顺序）
+    Csm::csmMap<Csm::csmString, MotionEntry*> _motions; ///< 动作名（"组名_序号"）到表项
+    std::vector<std::pair<std::string, int>> _motionGroups; ///< 动作组名与动作数
     Csm::csmMap<Csm::csmString, Csm::ACubismMotion*> _expressions; ///< 已加载的表情列表
 
-    LAppTextureManager* _textureManager;         ///< 纹理管理器
+    LAppTextureManager* _textureManager;         ///< 纹理管理器（进程内共享）
+    Csm::csmVector<Csm::csmUint32> _textureIds;  ///< 本模型持有引用的纹理 ID
+    GLFWwindow* _glContext;                      ///< 创建渲染器与纹理时的 OpenGL 上下文（析构时在此上下文中释放）
 
     const Csm::CubismId* _idParamAngleX; ///< 参数 ID: ParamAngleX
     const Csm::CubismId* _idParamAngleY; ///< 参数 ID: ParamAngleY
@@ -141,10 +409,58 @@ private:
     const Csm::CubismId* _idParamEyeBallX; ///< 参数 ID: ParamEyeBallX
     const Csm::CubismId* _idParamEyeBallY; ///< 参数 ID: ParamEyeBallY
 
+    Csm::csmInt32 _indexParamAngleX; ///< 参数下标: ParamAngleX（SetupModel 中解析）
+    Csm::csmInt32 _indexParamAngleY; ///< 参数下标: ParamAngleY
+    Csm::csmInt32 _indexParamAngleZ; ///< 参数下标: ParamAngleZ
+    Csm::csmInt32 _indexParamBodyAngleX; ///< 参数下标: ParamBodyAngleX
+    Csm::csmInt32 _indexParamEyeBallX; ///< 参数下标: ParamEyeBallX
+    Csm::csmInt32 _indexParamEyeBallY; ///< 参数下标: ParamEyeBallY
+
     // 当前表情控制（用于超时恢复）
     std::string _currentExpressionName; ///< 当前播放的表情名
+    std::vector<std::string> _expressionNames; ///< 已加载的表情名（按 model3.json 中的顺序）
     float _defaultExpressionDuration = 5.0f; ///< 表情自动恢复到中性所用的默认持续时间（秒）
     float _expressionDuration = 0.0f; ///< 当前表情的持续时间（若>0表示会在到期后恢复）
     double _expressionSetTime = 0.0; ///< 设置当前表情时的累计时间点（以 _userTimeSeconds 计）
     bool _expressionTemporary = false; ///< 当前表情是否为临时表情（到期后恢复）
+
+    // 流水线更新（_model 只由更新线程修改，渲染器绑定的是 _renderModel）
+    Csm::CubismModel* _renderModel = NULL;          ///< 绘制用模型（与 _model 共用 moc）
+    std::vector<Csm::csmInt32> _snapshotVertexOffsets; ///< 各 Drawable 顶点在快照中的起始位置
+    DrawableSnapshot _snapshots[3];                 ///< 快照（绘制中、已发布、写入中各一份）
+    std::thread _updateThread;                      ///< 更新线程
+    std::mutex _pipelineMutex;                      ///< 保护下面的状态
+    std::condition_variable _pipelineCondition;     ///< 通知请求到达或退出
+    UpdateRequest _updateRequest = {};              ///< 待处理的更新请求
+    std::vector<std::pair<std::string, float>> _pendingExpressions; ///< 待播放的表情（名称, 持续时间）
+    std::vector<MotionRequest> _pendingMotionRequests; ///< 待处理的动作请求
+    int _publishedSnapshot = -1;                    ///< 最新发布的快照（只由更新线程修改）
+    int _readingSnapshot = -1;                      ///< _renderModel 正在读取的快照（只由 OpenGL 线程修改）
+    Csm::csmUint64 _publishedSequence = 0;          ///< 已发布的快照数
+    Csm::csmUint64 _appliedSequence = 0;            ///< OpenGL 线程已取出的快照数
+    bool _pipelineStopping = false;                 ///< 更新线程退出标志
+
+    // 动作缓存（除注明的以外只在更新动作的线程中访问）
+    LAppTaskPool::Group _motionLoadTasks;           ///< 按需加载动作的任务
+    std::mutex _motionLoadMutex;                    ///< 保护 _loadedMotions
+    std::vector<MotionEntry*> _loadedMotions;       ///< 加载任务已完成、尚未登记的表项（加载任务写入）
+    Csm::csmUint32 _loadingMotionCount = 0;         ///< 正在加载的表项数
+    MotionEntry* _pendingMotion = NULL;             ///< 加载完成后开始播放的表项
+    Csm::csmInt32 _pendingMotionPriority = 0;       ///< 该表项的优先级
+    std::atomic<bool> _hasPendingMotion{false};     ///< _pendingMotion 是否非空（供其他线程查询）
+    Csm::csmUint64 _motionUseCounter = 0;           ///< 请求播放的累计次数（LRU 的序号）
+    std::atomic<Csm::csmUint64> _motionCacheHits{0};        ///< MotionCacheStats::hits
+    std::atomic<Csm::csmUint64> _motionCacheMisses{0};      ///< MotionCacheStats::misses
+    std::atomic<Csm::csmUint64> _motionCacheEvictions{0};   ///< MotionCacheStats::evictions
+    std::atomic<Csm::csmSizeInt> _motionResidentBytes{0};   ///< MotionCacheStats::residentBytes
+    std::atomic<Csm::csmSizeInt> _motionCachedBytes{0};     ///< MotionCacheStats::cachedBytes
+    std::atomic<Csm::csmUint32> _motionCachedCount{0};      ///< MotionCacheStats::cachedCount
+
+    // 拖拽延迟统计（仅在 OpenGL 线程访问）
+    Csm::csmUint64 _frameNumber = 0;                ///< OpenGL 线程的帧号
+    Csm::csmUint32 _latencySamples = 0;             ///< 本统计区间的样本数
+    double _latencyTotalMilliseconds = 0.0;         ///< 延迟合计[毫秒]
+    double _latencyMaxMilliseconds = 0.0;           ///< 最大延迟[毫秒]
+    Csm::csmUint64 _latencyMaxFrames = 0;           ///< 最大延迟[帧]
+    std::chrono::steady_clock::time_point _latencyLogTime; ///< 上次输出日志的时刻
 };
@@ -0,0 +1,177 @@
+/**
+ * @file LAppAllocationTracker.cpp
+ */
+#include "LAppAllocationTracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <GLFW/glfw3.h>
+
+#include "LAppAllocator_Common.hpp"
+#include "LAppDefine.hpp"
+#include "LAppLog.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+#ifdef AIPET_ALLOCATION_TRACKING
+
+namespace {
+
+std::atomic<csmUint64> s_operatorNewCount(0);   ///< 所有线程的 operator new 调用次数
+
+csmUint64 s_frameAllocatorCount = 0;            ///< 帧开始时 Csm 分配器的累计分配次数
+csmUint64 s_frameOperatorNewCount = 0;          ///< 帧开始时 operator new 的累计调用次数
+double s_unsteadyTime = 0.0;                    ///< 最近一次 MarkUnsteady 的时间
+csmUint64 s_checkedFrames = 0;                  ///< 检查过的稳定帧数
+csmUint64 s_failedFrames = 0;                   ///< 其中发生分配的帧数
+
+csmUint64 GetAllocatorCount()
+{
+    LAppAllocator_Common* allocator = LAppAllocator_Common::GetInstance();
+    return allocator ? allocator->GetStats().allocationCount : 0;
+}
+
+void* CountedAllocate(std::size_t size)
+{
+    s_operatorNewCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* CountedAllocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    s_operatorNewCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* memory = NULL;
+    if (posix_memalign(&memory, static_cast<std::size_t>(alignment), size > 0 ? size : 1) != 0)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+}
+
+// 数组与 nothrow 版本的默认实现会调用这里的版本
+void* operator new(std::size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    free(memory);
+}
+
+bool LAppAllocationTracker::IsEnabled()
+{
+    return true;
+}
+
+csmUint64 LAppAllocationTracker::GetOperatorNewCount()
+{
+    return s_operatorNewCount.load(std::memory_order_relaxed);
+}
+
+void LAppAllocationTracker::BeginFrame()
+{
+    s_frameAllocatorCount = GetAllocatorCount();
+    s_frameOperatorNewCount = GetOperatorNewCount();
+}
+
+void LAppAllocationTracker::EndFrame()
+{
+    // 先读取计数，避免把下面的日志输出算进本帧
+    const csmUint64 allocatorCount = GetAllocatorCount() - s_frameAllocatorCount;
+    const csmUint64 operatorNewCount = GetOperatorNewCount() - s_frameOperatorNewCount;
+
+    if (glfwGetTime() - s_unsteadyTime < LAppDefine::AllocationCheckWarmupSeconds)
+    {
+        return;
+    }
+
+    s_checkedFrames++;
+    if (allocatorCount == 0 && operatorNewCount == 0)
+    {
+        return;
+    }
+
+    s_failedFrames++;
+    LAppPal::PrintLogLn("[APP]steady frame allocated: csm %llu, operator new %llu (%llu of %llu frames)",
+        static_cast<unsigned long long>(allocatorCount), static_cast<unsigned long long>(operatorNewCount),
+        static_cast<unsigned long long>(s_failedFrames), static_cast<unsigned long long>(s_checkedFrames));
+
+    if (LAppDefine::AllocationCheckAbort)
+    {
+        LAppLog::Flush();
+        abort();
+    }
+}
+
+void LAppAllocationTracker::MarkUnsteady()
+{
+    s_unsteadyTime = glfwGetTime();
+}
+
+void LAppAllocationTracker::ReportSummary()
+{
+    LAppPal::PrintLogLn("[APP]allocation check: %llu steady frames, %llu with allocations",
+        static_cast<unsigned long long>(s_checkedFrames), static_cast<unsigned long long>(s_failedFrames));
+}
+
+#else
+
+bool LAppAllocationTracker::IsEnabled()
+{
+    return false;
+}
+
+csmUint64 LAppAllocationTracker::GetOperatorNewCount()
+{
+    return 0;
+}
+
+void LAppAllocationTracker::BeginFrame()
+{
+}
+
+void LAppAllocationTracker::EndFrame()
+{
+}
+
+void LAppAllocationTracker::MarkUnsteady()
+{
+}
+
+void LAppAllocationTracker::ReportSummary()
+{
+}
+
+#endif
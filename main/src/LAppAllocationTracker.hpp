@@ -0,0 +1,52 @@
+/**
+ * @file LAppAllocationTracker.hpp
+ */
+#pragma once
+
+#include <CubismFramework.hpp>
+
+/**
+ * @brief 检查稳定帧堆分配次数的调试工具
+ *
+ * 以 CMake 选项 AIPET_ALLOCATION_TRACKING 构建时生效：替换全局 operator new 计数，
+ * 并与 Csm 分配器（LAppAllocator_Common）的计数一起按帧统计。未启用时所有函数都不做任何处理。
+ *
+ * 主循环每帧调用 BeginFrame / EndFrame。模型加载、点击、键盘输入、AI 回复等
+ * 本来就会分配内存的事件调用 MarkUnsteady，其后 AllocationCheckWarmupSeconds 秒内的帧不检查
+ * （同时让动作队列、参数数组等在首次使用时增长到稳定容量）。
+ * 其余的稳定帧（空闲动作、表情、拖拽）应当不发生任何分配，发生时输出日志，
+ * AllocationCheckAbort 为 true 时直接中止，用于发现回归。
+ */
+class LAppAllocationTracker
+{
+public:
+    /**
+     * @brief 是否以 AIPET_ALLOCATION_TRACKING 构建
+     */
+    static bool IsEnabled();
+
+    /**
+     * @brief 全局 operator new 的累计调用次数（未启用时为 0）
+     */
+    static Csm::csmUint64 GetOperatorNewCount();
+
+    /**
+     * @brief 帧开始时记录计数
+     */
+    static void BeginFrame();
+
+    /**
+     * @brief 帧结束时检查本帧的分配次数
+     */
+    static void EndFrame();
+
+    /**
+     * @brief 标记本帧发生了会分配内存的事件，重新开始预热
+     */
+    static void MarkUnsteady();
+
+    /**
+     * @brief 输出检查过的稳定帧数与其中发生分配的帧数
+     */
+    static void ReportSummary();
+};
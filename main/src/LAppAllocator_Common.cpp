@@ -7,48 +7,586 @@
 
 #include "LAppAllocator_Common.hpp"
 
+#include <stdlib.h>
+#include <string.h>
+
 using namespace Csm;
 
-void* LAppAllocator_Common::Allocate(const csmSizeType  size)
+namespace {
+
+const csmSizeType HeaderSize = 16;                  ///< 块头的字节数（同时保证返回地址 16 字节对齐）
+const csmSizeType ChunkBytes = 64 * 1024;           ///< 内存池 chunk 的字节数
+const csmUint32 ThreadCacheLimit = 64;              ///< 线程缓存每个级别最多保留的块数，超出时归还一半
+const csmUint32 RefillCount = 32;                   ///< 一次从仓库取出的块数
+const csmSizeType TransientAlignment = 64;          ///< 临时 arena 的对齐
+const csmSizeType TransientChunkBytes = 1024 * 1024;        ///< 临时 arena 新建 chunk 的最小字节数
+const csmSizeType TransientRetainBytes = 16 * 1024 * 1024;  ///< 复位时保留的最大字节数
+
+/**
+ * @brief 各尺寸级别的块大小（16 的倍数，相邻级别相差不超过 25%）
+ */
+const csmSizeType SizeClassBytes[LAppAllocator_Common::SizeClassCount] =
+{
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+};
+
+/**
+ * @brief 请求字节数（按 16 向上取整后除以 16）到尺寸级别的查找表
+ */
+struct SizeClassTable
+{
+    csmUint8 index[LAppAllocator_Common::MaxPooledSize / 16 + 1];
+
+    constexpr SizeClassTable() : index()
+    {
+        csmUint32 sizeClass = 0;
+        for (csmSizeType i = 0; i <= LAppAllocator_Common::MaxPooledSize / 16; i++)
+        {
+            while (SizeClassBytes[sizeClass] < i * 16)
+            {
+                sizeClass++;
+            }
+            index[i] = static_cast<csmUint8>(sizeClass);
+        }
+    }
+};
+
+constexpr SizeClassTable ClassTable;
+
+/**
+ * @brief 块头
+ */
+struct BlockHeader
+{
+    csmUint32 sizeClass;    ///< 尺寸级别（SizeClassCount 表示 malloc 的大块）
+    csmUint32 offset;       ///< malloc 返回的地址到块头的距离（仅大块）
+    csmUint64 size;         ///< 请求的字节数
+};
+
+static_assert(sizeof(BlockHeader) == HeaderSize, "BlockHeader must be 16 bytes");
+
+/**
+ * @brief 空闲块（复用块头的位置串成链表）
+ */
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+std::atomic<LAppAllocator_Common*> s_instance(NULL);
+
+/**
+ * @brief 线程缓存登记用的锁
+ *
+ * 线程结束时分配器可能已销毁，因此不放在分配器中。
+ */
+std::mutex& GetRegistryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief 计数的下标（0 ~ SizeClassCount 为各尺寸级别的分配次数）
+ */
+const csmUint32 CountDeallocations = LAppAllocator_Common::SizeClassCount + 1;
+const csmUint32 CountLiveBytes = LAppAllocator_Common::SizeClassCount + 2;     ///< 按 2^64 取模累加（分配与释放可能在不同线程）
+const csmUint32 CountSlots = LAppAllocator_Common::SizeClassCount + 3;
+
+/**
+ * @brief 只由一个线程写入的计数加法（避免原子的读改写）
+ */
+inline void AddCount(std::atomic<csmUint64>& counter, csmUint64 value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+csmSizeType AlignUp(csmSizeType value, csmSizeType alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+/**
+ * @brief 线程缓存
+ */
+struct LAppAllocator_Common::ThreadCache
+{
+    LAppAllocator_Common* owner;                        ///< 所属分配器（分配器销毁时置 NULL）
+    FreeBlock* lists[SizeClassCount];                   ///< 各级别的空闲块
+    csmUint32 counts[SizeClassCount];                   ///< 各级别的空闲块数
+    std::atomic<csmUint64> statistics[CountSlots];      ///< 计数（只由本线程写入）
+
+    ~ThreadCache()
+    {
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        if (owner != NULL)
+        {
+            owner->RetireThreadCache(*this);
+        }
+    }
+};
+
+thread_local LAppAllocator_Common::ThreadCache LAppAllocator_Common::s_threadCache;
+
+LAppAllocator_Common* LAppAllocator_Common::GetInstance()
+{
+    return s_instance.load(std::memory_order_acquire);
+}
+
+csmSizeType LAppAllocator_Common::GetSizeClassBytes(csmUint32 sizeClass)
+{
+    return sizeClass < SizeClassCount ? SizeClassBytes[sizeClass] : 0;
+}
+
+LAppAllocator_Common::LAppAllocator_Common()
+    : _transientLiveCount(0)
+    , _transientBytes(0)
+    , _transientPeakBytes(0)
+    , _transientAllocationCount(0)
+    , _reservedBytes(0)
+    , _peakReservedBytes(0)
+{
+    memset(_retiredCounts, 0, sizeof(_retiredCounts));
+    memset(_depot, 0, sizeof(_depot));
+
+    s_instance.store(this, std::memory_order_release);
+}
+
+LAppAllocator_Common::~LAppAllocator_Common()
+{
+    LAppAllocator_Common* self = this;
+    s_instance.compare_exchange_strong(self, NULL);
+
+    csmUint64 allocations = 0;
+    csmUint64 deallocations = 0;
+    {
+        // 其他线程的缓存不再属于本分配器，其中的空闲块随 chunk 一起失效
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        for (csmUint32 i = 0; i < _threadCaches.size(); i++)
+        {
+            ThreadCache& cache = *_threadCaches[i];
+            for (csmUint32 j = 0; j <= SizeClassCount; j++)
+            {
+                allocations += cache.statistics[j].load(std::memory_order_relaxed);
+            }
+            deallocations += cache.statistics[CountDeallocations].load(std::memory_order_relaxed);
+            cache.owner = NULL;
+        }
+        _threadCaches.clear();
+
+        for (csmUint32 j = 0; j <= SizeClassCount; j++)
+        {
+            allocations += _retiredCounts[j];
+        }
+        deallocations += _retiredCounts[CountDeallocations];
+    }
+
+    // 仍有存活的块时，之后的 Deallocate 还会访问 chunk，保留到进程结束
+    if (allocations == deallocations)
+    {
+        for (csmUint32 i = 0; i < _chunks.size(); i++)
+        {
+            free(_chunks[i]);
+        }
+        _chunks.clear();
+    }
+
+    if (_transientLiveCount == 0)
+    {
+        for (csmUint32 i = 0; i < _transientChunks.size(); i++)
+        {
+            free(_transientChunks[i].allocation);
+        }
+        _transientChunks.clear();
+    }
+}
+
+void* LAppAllocator_Common::Allocate(const csmSizeType size)
 {
-    return malloc(size);
+    if (size > MaxPooledSize)
+    {
+        return AllocateLarge(size, HeaderSize);
+    }
+
+    const csmUint32 sizeClass = ClassTable.index[(size + 15) / 16];
+    ThreadCache& cache = GetThreadCache();
+
+    FreeBlock* block = cache.lists[sizeClass];
+    if (block != NULL)
+    {
+        cache.lists[sizeClass] = block->next;
+        cache.counts[sizeClass]--;
+    }
+    else
+    {
+        block = static_cast<FreeBlock*>(RefillThreadCache(cache, sizeClass));
+        if (block == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+    header->sizeClass = sizeClass;
+    header->offset = 0;
+    header->size = size;
+
+    AddCount(cache.statistics[sizeClass], 1);
+    AddCount(cache.statistics[CountLiveBytes], size);
+
+    return reinterpret_cast<csmByte*>(header) + HeaderSize;
 }
 
 void LAppAllocator_Common::Deallocate(void* memory)
 {
-    free(memory);
+    if (memory == NULL)
+    {
+        return;
+    }
+
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(static_cast<csmByte*>(memory) - HeaderSize);
+    const csmSizeType size = static_cast<csmSizeType>(header->size);
+    const csmUint32 sizeClass = header->sizeClass;
+
+    ThreadCache& cache = GetThreadCache();
+    AddCount(cache.statistics[CountDeallocations], 1);
+    AddCount(cache.statistics[CountLiveBytes], 0 - static_cast<csmUint64>(size));
+
+    if (sizeClass >= SizeClassCount)
+    {
+        _reservedBytes.fetch_sub(size + HeaderSize + header->offset, std::memory_order_relaxed);
+        free(reinterpret_cast<csmByte*>(header) - header->offset);
+        return;
+    }
+
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+    block->next = cache.lists[sizeClass];
+    cache.lists[sizeClass] = block;
+
+    if (++cache.counts[sizeClass] > ThreadCacheLimit)
+    {
+        FlushThreadCache(cache, sizeClass);
+    }
 }
 
 void* LAppAllocator_Common::AllocateAligned(const csmSizeType size, const csmUint32 alignment)
 {
-    size_t offset, shift, alignedAddress;
-    void* allocation;
-    void** preamble;
+    // 块头为 16 字节，池中的块与 malloc 的大块本身就满足 16 字节对齐
+    if (alignment <= HeaderSize)
+    {
+        return Allocate(size);
+    }
+
+    return AllocateLarge(size, alignment);
+}
+
+void LAppAllocator_Common::DeallocateAligned(void* alignedMemory)
+{
+    Deallocate(alignedMemory);
+}
+
+LAppAllocator_Common::ThreadCache& LAppAllocator_Common::GetThreadCache()
+{
+    ThreadCache& cache = s_threadCache;
+    if (cache.owner == this)
+    {
+        return cache;
+    }
+
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
 
-    offset = alignment - 1 + sizeof(void*);
+    // 属于其他分配器时先归还给它（已销毁的分配器会把 owner 置 NULL）
+    if (cache.owner != NULL)
+    {
+        cache.owner->RetireThreadCache(cache);
+    }
 
-    allocation = Allocate(size + static_cast<csmUint32>(offset));
+    memset(cache.lists, 0, sizeof(cache.lists));
+    memset(cache.counts, 0, sizeof(cache.counts));
+    for (csmUint32 i = 0; i < CountSlots; i++)
+    {
+        cache.statistics[i].store(0, std::memory_order_relaxed);
+    }
+    cache.owner = this;
+    _threadCaches.push_back(&cache);
 
-    alignedAddress = reinterpret_cast<size_t>(allocation) + sizeof(void*);
+    return cache;
+}
 
-    shift = alignedAddress % alignment;
+void LAppAllocator_Common::RetireThreadCache(ThreadCache& cache)
+{
+    for (csmUint32 i = 0; i < CountSlots; i++)
+    {
+        _retiredCounts[i] += cache.statistics[i].load(std::memory_order_relaxed);
+    }
 
-    if (shift)
+    for (csmUint32 i = 0; i < _threadCaches.size(); i++)
     {
-        alignedAddress += (alignment - shift);
+        if (_threadCaches[i] == &cache)
+        {
+            _threadCaches[i] = _threadCaches.back();
+            _threadCaches.pop_back();
+            break;
+        }
     }
 
-    preamble = reinterpret_cast<void**>(alignedAddress);
-    preamble[-1] = allocation;
+    {
+        std::lock_guard<std::mutex> lock(_depotMutex);
+        for (csmUint32 sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+        {
+            FreeBlock* block = cache.lists[sizeClass];
+            while (block != NULL)
+            {
+                FreeBlock* next = block->next;
+                block->next = static_cast<FreeBlock*>(_depot[sizeClass]);
+                _depot[sizeClass] = block;
+                block = next;
+            }
+            cache.lists[sizeClass] = NULL;
+            cache.counts[sizeClass] = 0;
+        }
+    }
 
-    return reinterpret_cast<void*>(alignedAddress);
+    cache.owner = NULL;
 }
 
-void LAppAllocator_Common::DeallocateAligned(void* alignedMemory)
+void* LAppAllocator_Common::AllocateLarge(csmSizeType size, csmSizeType alignment)
+{
+    const csmSizeType padding = (alignment > HeaderSize) ? alignment : 0;
+    csmByte* allocation = static_cast<csmByte*>(malloc(size + HeaderSize + padding));
+    if (allocation == NULL)
+    {
+        return NULL;
+    }
+
+    csmSizeType address = reinterpret_cast<csmSizeType>(allocation) + HeaderSize;
+    if (padding > 0)
+    {
+        address = AlignUp(address, alignment);
+    }
+
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(address - HeaderSize);
+    header->sizeClass = SizeClassCount;
+    header->offset = static_cast<csmUint32>(reinterpret_cast<csmByte*>(header) - allocation);
+    header->size = size;
+
+    AddReservedBytes(size + HeaderSize + header->offset);
+
+    ThreadCache& cache = GetThreadCache();
+    AddCount(cache.statistics[SizeClassCount], 1);
+    AddCount(cache.statistics[CountLiveBytes], size);
+
+    return reinterpret_cast<void*>(address);
+}
+
+void* LAppAllocator_Common::RefillThreadCache(ThreadCache& cache, csmUint32 sizeClass)
+{
+    std::lock_guard<std::mutex> lock(_depotMutex);
+
+    FreeBlock* head = static_cast<FreeBlock*>(_depot[sizeClass]);
+
+    if (head == NULL)
+    {
+        // 仓库为空：新建 chunk 并整块切分
+        csmByte* chunk = static_cast<csmByte*>(malloc(ChunkBytes));
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        _chunks.push_back(chunk);
+        AddReservedBytes(ChunkBytes);
+
+        const csmSizeType stride = SizeClassBytes[sizeClass] + HeaderSize;
+        const csmSizeType count = ChunkBytes / stride;
+        for (csmSizeType i = count; i > 0; i--)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * stride);
+            block->next = head;
+            head = block;
+        }
+    }
+
+    // 第一块直接返回，其后最多 RefillCount - 1 块放入线程缓存
+    FreeBlock* result = head;
+    head = head->next;
+
+    for (csmUint32 i = 1; i < RefillCount && head != NULL; i++)
+    {
+        FreeBlock* block = head;
+        head = head->next;
+        block->next = cache.lists[sizeClass];
+        cache.lists[sizeClass] = block;
+        cache.counts[sizeClass]++;
+    }
+
+    _depot[sizeClass] = head;
+
+    return result;
+}
+
+void LAppAllocator_Common::FlushThreadCache(ThreadCache& cache, csmUint32 sizeClass)
+{
+    // 先在锁外把要归还的一半摘下来
+    const csmUint32 flushCount = cache.counts[sizeClass] / 2;
+    FreeBlock* first = cache.lists[sizeClass];
+    FreeBlock* last = first;
+    for (csmUint32 i = 1; i < flushCount; i++)
+    {
+        last = last->next;
+    }
+    cache.lists[sizeClass] = last->next;
+    cache.counts[sizeClass] -= flushCount;
+
+    std::lock_guard<std::mutex> lock(_depotMutex);
+    last->next = static_cast<FreeBlock*>(_depot[sizeClass]);
+    _depot[sizeClass] = first;
+}
+
+void LAppAllocator_Common::AddReservedBytes(csmSizeType bytes)
+{
+    const csmSizeType reserved = _reservedBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    csmSizeType peak = _peakReservedBytes.load(std::memory_order_relaxed);
+    while (reserved > peak && !_peakReservedBytes.compare_exchange_weak(peak, reserved, std::memory_order_relaxed))
+    {
+    }
+}
+
+void* LAppAllocator_Common::AllocateTransient(csmSizeType size)
+{
+    const csmSizeType alignedSize = AlignUp(size > 0 ? size : 1, TransientAlignment);
+
+    std::lock_guard<std::mutex> lock(_transientMutex);
+
+    if (_transientChunks.empty() || _transientChunks.back().capacity - _transientChunks.back().used < alignedSize)
+    {
+        TransientChunk chunk;
+        chunk.capacity = alignedSize > TransientChunkBytes ? alignedSize : TransientChunkBytes;
+        chunk.allocation = malloc(chunk.capacity + TransientAlignment);
+        if (chunk.allocation == NULL)
+        {
+            return NULL;
+        }
+        chunk.memory = reinterpret_cast<csmByte*>(AlignUp(reinterpret_cast<csmSizeType>(chunk.allocation), TransientAlignment));
+        chunk.used = 0;
+        _transientChunks.push_back(chunk);
+    }
+
+    TransientChunk& chunk = _transientChunks.back();
+    void* memory = chunk.memory + chunk.used;
+    chunk.used += alignedSize;
+
+    _transientLiveCount++;
+    _transientAllocationCount++;
+    _transientBytes += alignedSize;
+    if (_transientBytes > _transientPeakBytes)
+    {
+        _transientPeakBytes = _transientBytes;
+    }
+
+    return memory;
+}
+
+bool LAppAllocator_Common::DeallocateTransient(void* memory)
+{
+    std::lock_guard<std::mutex> lock(_transientMutex);
+
+    bool owned = false;
+    for (csmUint32 i = 0; i < _transientChunks.size(); i++)
+    {
+        const TransientChunk& chunk = _transientChunks[i];
+        if (memory >= chunk.memory && memory < chunk.memory + chunk.used)
+        {
+            owned = true;
+            break;
+        }
+    }
+
+    if (!owned)
+    {
+        return false;
+    }
+
+    if (--_transientLiveCount > 0)
+    {
+        return true;
+    }
+
+    // 全部释放：复位。多个 chunk 合并为一个，下一次加载不必再扩充
+    csmSizeType capacity = 0;
+    for (csmUint32 i = 0; i < _transientChunks.size(); i++)
+    {
+        capacity += _transientChunks[i].capacity;
+    }
+
+    if (_transientChunks.size() == 1 && capacity <= TransientRetainBytes)
+    {
+        _transientChunks[0].used = 0;
+    }
+    else
+    {
+        for (csmUint32 i = 0; i < _transientChunks.size(); i++)
+        {
+            free(_transientChunks[i].allocation);
+        }
+        _transientChunks.clear();
+
+        if (capacity <= TransientRetainBytes)
+        {
+            TransientChunk chunk;
+            chunk.capacity = capacity;
+            chunk.allocation = malloc(capacity + TransientAlignment);
+            if (chunk.allocation != NULL)
+            {
+                chunk.memory = reinterpret_cast<csmByte*>(AlignUp(reinterpret_cast<csmSizeType>(chunk.allocation), TransientAlignment));
+                chunk.used = 0;
+                _transientChunks.push_back(chunk);
+            }
+        }
+    }
+
+    _transientBytes = 0;
+
+    return true;
+}
+
+LAppAllocator_Common::Stats LAppAllocator_Common::GetStats() const
 {
-    void** preamble;
+    csmUint64 counts[CountSlots];
+
+    {
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        memcpy(counts, _retiredCounts, sizeof(counts));
+        for (csmUint32 i = 0; i < _threadCaches.size(); i++)
+        {
+            for (csmUint32 j = 0; j < CountSlots; j++)
+            {
+                counts[j] += _threadCaches[i]->statistics[j].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Stats stats;
+
+    stats.allocationCount = 0;
+    for (csmUint32 i = 0; i <= SizeClassCount; i++)
+    {
+        stats.classAllocations[i] = counts[i];
+        stats.allocationCount += counts[i];
+    }
+    stats.deallocationCount = counts[CountDeallocations];
+    stats.liveBytes = static_cast<csmSizeType>(counts[CountLiveBytes]);
+    stats.liveCount = static_cast<csmSizeType>(stats.allocationCount - stats.deallocationCount);
+    stats.reservedBytes = _reservedBytes.load(std::memory_order_relaxed);
+    stats.peakReservedBytes = _peakReservedBytes.load(std::memory_order_relaxed);
 
-    preamble = static_cast<void**>(alignedMemory);
+    std::lock_guard<std::mutex> lock(_transientMutex);
+    stats.transientAllocationCount = _transientAllocationCount;
+    stats.transientBytes = _transientBytes;
+    stats.transientPeakBytes = _transientPeakBytes;
 
-    Deallocate(preamble[-1]);
+    return stats;
 }
@@ -7,18 +7,78 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <CubismFramework.hpp>
 #include <ICubismAllocator.hpp>
 
 /**
  * @brief 实现内存分配的类。
  *
- * 实现了内存分配与释放的接口。
- * 由框架调用。
+ * 实现了内存分配与释放的接口，由框架调用（经 CubismFramework::StartUp 传入）。
  *
+ * 2KB 以下的请求按尺寸级别从内存池分配：每个线程持有各级别的空闲块缓存，
+ * 缓存为空或过多时才与全局仓库成批交换（需加锁），仓库不足时从 64KB 的 chunk 切分新块。
+ * 更大的请求以及 16 字节以上的对齐请求直接交给 malloc。
+ * 每个块前有 16 字节的块头，记录尺寸级别与请求的字节数，释放时据此归还。
+ * 计数也记在线程缓存中（只由本线程写入，不需要原子的读改写），GetStats 时汇总；
+ * 线程结束时其计数与缓存的空闲块归还给分配器。
+ *
+ * 另外提供一个用于加载期临时数据（文件内容等）的 bump arena，
+ * 所有临时块释放后整体复位，下一次加载复用同一块内存。
+ *
+ * 分配次数、存活字节数、峰值和各尺寸级别的直方图可以随时用 GetStats 读取。
+ * 进程内只应存在一个实例（GetInstance 返回最近创建的实例）。
  */
 class LAppAllocator_Common : public Csm::ICubismAllocator
 {
+public:
+    static const Csm::csmUint32 SizeClassCount = 24;        ///< 尺寸级别数
+    static const Csm::csmSizeType MaxPooledSize = 2048;     ///< 从内存池分配的最大字节数
+
+    /**
+     * @brief 分配统计
+     */
+    struct Stats
+    {
+        Csm::csmUint64 allocationCount;         ///< 累计分配次数
+        Csm::csmUint64 deallocationCount;       ///< 累计释放次数
+        Csm::csmSizeType liveBytes;             ///< 存活的请求字节数
+        Csm::csmSizeType liveCount;             ///< 存活的块数
+        Csm::csmSizeType reservedBytes;         ///< 实际占用（chunk 与 malloc 的大块，含块头）
+        Csm::csmSizeType peakReservedBytes;     ///< reservedBytes 的峰值
+        Csm::csmUint64 transientAllocationCount;    ///< 临时 arena 的累计分配次数
+        Csm::csmSizeType transientBytes;        ///< 临时 arena 当前使用的字节数
+        Csm::csmSizeType transientPeakBytes;    ///< 临时 arena 使用量的峰值
+        Csm::csmUint64 classAllocations[SizeClassCount + 1];   ///< 各尺寸级别的累计分配次数（最后一项为大块）
+    };
+
+    /**
+     * @brief 返回最近创建的实例，不存在时返回 NULL
+     */
+    static LAppAllocator_Common* GetInstance();
+
+    /**
+     * @brief 返回尺寸级别的块大小
+     *
+     * @param[in] sizeClass 尺寸级别（0 ~ SizeClassCount - 1）
+     * @return 块大小（字节）
+     */
+    static Csm::csmSizeType GetSizeClassBytes(Csm::csmUint32 sizeClass);
+
+    /**
+     * @brief 构造函数
+     */
+    LAppAllocator_Common();
+
+    /**
+     * @brief 析构函数
+     *
+     * 仍有存活的块时不释放 chunk（进程退出时静态对象的析构顺序不确定）。
+     */
+    virtual ~LAppAllocator_Common();
+
     /**
      * @brief 分配内存区域
      *
@@ -37,6 +97,8 @@ class LAppAllocator_Common : public Csm::ICubismAllocator
     /**
      * @brief 按对齐要求分配内存
      *
+     * 16 字节以内的对齐直接从内存池分配，不需要额外空间。
+     *
      * @param[in] size 要分配的大小
      * @param[in] alignment 对齐字节数
      * @return 对齐后的地址
@@ -49,4 +111,67 @@ class LAppAllocator_Common : public Csm::ICubismAllocator
      * @param[in] alignedMemory 要释放的对齐内存指针
      */
     virtual void DeallocateAligned(void* alignedMemory);
+
+    /**
+     * @brief 从临时 arena 分配（线程安全，地址按 64 字节对齐）
+     *
+     * 用于加载期间读取后即释放的数据。arena 中的块全部释放后整体复位。
+     *
+     * @param[in] size 要分配的大小
+     * @return 分配到的内存指针
+     */
+    void* AllocateTransient(Csm::csmSizeType size);
+
+    /**
+     * @brief 释放 AllocateTransient 分配的内存
+     *
+     * @param[in] memory 要释放的内存指针
+     * @return memory 不属于临时 arena 时返回 false（不做任何处理）
+     */
+    bool DeallocateTransient(void* memory);
+
+    /**
+     * @brief 读取当前的统计
+     */
+    Stats GetStats() const;
+
+private:
+    struct ThreadCache;
+
+    /**
+     * @brief 临时 arena 的一段连续内存
+     */
+    struct TransientChunk
+    {
+        Csm::csmByte* memory;       ///< 起始地址（64 字节对齐）
+        void* allocation;           ///< malloc 返回的地址
+        Csm::csmSizeType capacity;  ///< 容量
+        Csm::csmSizeType used;      ///< 已使用的字节数
+    };
+
+    ThreadCache& GetThreadCache();                                              ///< 当前线程的缓存（首次使用时登记）
+    void RetireThreadCache(ThreadCache& cache);                                 ///< 汇总计数、归还空闲块并取消登记（需持有登记锁）
+    void* AllocateLarge(Csm::csmSizeType size, Csm::csmSizeType alignment);    ///< 直接用 malloc 分配
+    void* RefillThreadCache(ThreadCache& cache, Csm::csmUint32 sizeClass);      ///< 从仓库或新 chunk 补充线程缓存并取出一块
+    void FlushThreadCache(ThreadCache& cache, Csm::csmUint32 sizeClass);        ///< 把线程缓存的一半归还仓库
+    void AddReservedBytes(Csm::csmSizeType bytes);                              ///< 增加实际占用并更新峰值
+
+    static thread_local ThreadCache s_threadCache;  ///< 当前线程的缓存
+
+    std::vector<ThreadCache*> _threadCaches;        ///< 已登记的线程缓存（受登记锁保护）
+    Csm::csmUint64 _retiredCounts[SizeClassCount + 3];  ///< 已结束线程的计数（受登记锁保护）
+
+    std::mutex _depotMutex;                         ///< 保护仓库与 chunk 列表
+    void* _depot[SizeClassCount];                   ///< 各尺寸级别的空闲块链表
+    std::vector<void*> _chunks;                     ///< 内存池的 chunk
+
+    mutable std::mutex _transientMutex;             ///< 保护临时 arena
+    std::vector<TransientChunk> _transientChunks;   ///< 临时 arena 的内存
+    Csm::csmSizeType _transientLiveCount;           ///< 临时 arena 中存活的块数
+    Csm::csmSizeType _transientBytes;               ///< 临时 arena 当前使用的字节数
+    Csm::csmSizeType _transientPeakBytes;           ///< 临时 arena 使用量的峰值
+    Csm::csmUint64 _transientAllocationCount;       ///< 临时 arena 的累计分配次数
+
+    std::atomic<Csm::csmSizeType> _reservedBytes;   ///< 实际占用
+    std::atomic<Csm::csmSizeType> _peakReservedBytes;   ///< 实际占用的峰值
 };
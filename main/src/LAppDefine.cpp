@@ -61,7 +61,77 @@ namespace LAppDefine {
     const csmBool DebugTouchLogEnable = false;
 
     // 框架输出日志等级设置
-    const CubismFramework::Option::LogLevel CubismLoggingLevel = CubismFramework::Option::LogLevel_Verbose;
+    const CubismFramework::Option::LogLevel CubismLoggingLevel = CubismFramework::Option::LogLevel_Warning;
+
+    // 日志在调用线程中格式化后放入环形缓冲区，由输出线程写出；各分类的级别可用环境变量 AIPET_LOG 覆盖
+    // （例如 AIPET_LOG=info,input=debug）。每条记录约 300 字节，缓冲区满时丢弃新记录
+    const CubismFramework::Option::LogLevel LogLevel = CubismFramework::Option::LogLevel_Info;
+    const csmUint32 LogRingCapacity = 1024;
+    const csmUint32 LogFlushIntervalMilliseconds = 50;
+    const csmBool LogConsoleEnable = true;
+    const csmChar* LogFilePath = "";
+
+    // 纹理在加载时预乘 alpha，渲染器据此选择 PremultipliedAlpha 系列着色器
+    const csmBool PremultipliedAlphaEnable = true;
+    // 异步纹理每帧最多向 PBO 拷贝 4MB（2048x2048 的 RGBA 纹理分 4 帧完成）
+    const csmInt32 TextureUploadBytesPerFrame = 4 * 1024 * 1024;
+    // 解码结果缓存到 ~/.cache/AIPet/textures，再次启动时跳过 PNG 解压
+    const csmBool TextureCacheEnable = true;
+    // 缓存完整 mipmap 链，命中时无需 glGenerateMipmap（缓存文件约大 1/3）
+    const csmBool TextureCacheMipmapEnable = true;
+    // 缓存目录超过 512MB 时按修改时间（命中时更新）删除最久未使用的文件，2048x2048 的纹理约 21MB
+    const csmUint64 TextureCacheMaxBytes = 512ull * 1024 * 1024;
+
+    // 动作曲线按 120Hz 烘焙后每帧只需一次线性插值；120Hz 下自带动作的误差约 0.05（参数单位）
+    const csmBool MotionBakeEnable = false;
+    const csmFloat32 MotionBakeSampleRate = 120.0f;
+    const csmFloat32 MotionBakeMaxError = 0.1f;
+
+    // 待机组以外的动作在第一次播放时由任务池加载（加载期间继续播放当前的动作）；
+    // 按需加载的动作合计超过预算时，释放最久未播放且不在播放中的动作
+    const csmBool MotionLazyLoadEnable = true;
+    const csmSizeInt MotionCacheBudgetBytes = 1024 * 1024;
+
+    // 切换模型时新模型在后台线程中加载，纹理全部上传后与旧模型交叉淡入淡出，期间两者都继续更新
+    const csmFloat32 ModelCrossfadeSeconds = 0.5f;
+
+    // 副本与当前模型共用 moc、动作、表情与物理设置（LAppModelCache）和纹理，只各自持有参数与演算状态；
+    // 副本在当前模型左右交替排开，不响应拖拽
+    const csmInt32 ModelInstanceMaxCount = 15;
+    const csmFloat32 ModelInstanceSpacing = 0.6f;
+
+    // 聊天字体的字形由 ImGui 按需光栅化；用过的字形记录到 ~/.cache/AIPet/glyphs.bin，
+    // 下次启动后每帧预先光栅化 32 个，不阻塞第一帧（图集扩大的那一帧约 3ms）
+    const csmBool GlyphCacheEnable = true;
+    const csmInt32 GlyphPreloadPerFrame = 32;
+
+    // AIPetAssetConverter 生成的 .bin 无需解析 JSON；比对应 JSON 旧（JSON 被修改过）的 .bin 不会被使用
+    const csmBool BinaryAssetEnable = true;
+
+    // 实测 100KB 以下 read() 更快（mmap 的建立与缺页开销占主导），moc3 与 PNG 用 mmap 冷读快 10~20%
+    const csmBool MappedFileLoadEnable = true;
+    const csmSizeInt MappedFileMinBytes = 256 * 1024;
+
+    // AIPetModelPacker 生成的包；挂载期间包优先于目录中的散文件
+    const csmBool ModelPackEnable = true;
+    // moc3、表情、动作、物理等在工作线程中读取并解析，OpenGL 线程只创建渲染器与纹理；结果按 model3.json 中的顺序登记
+    const csmBool ParallelAssetLoadEnable = true;
+
+    // 统计遮罩、模型绘制与 ImGui 三个阶段的 GPU 耗时（结果延迟 1~2 帧读取，不会等待 GPU）
+    const csmBool GpuTimerEnable = false;
+    const csmFloat32 GpuTimerLogInterval = 5.0f;
+
+    // 稳定运行时每帧分配次数应接近 0；模型加载的耗时与分配次数在 DebugLogEnable 时总会输出
+    const csmBool AllocatorStatsEnable = false;
+    const csmFloat32 AllocatorStatsLogInterval = 5.0f;
+    // 以 AIPET_ALLOCATION_TRACKING 构建时检查稳定帧是否零分配；预热需覆盖一次空闲动作的重新开始（Haru 为 10 秒）
+    const csmFloat32 AllocationCheckWarmupSeconds = 30.0f;
+    const csmBool AllocationCheckAbort = false;
+
+    // 第 N+1 帧的动作/物理/csmUpdateModel 在工作线程中计算，OpenGL 线程同时用快照绘制第 N 帧；
+    // 拖拽输入因此晚 1 帧显示（更新线程跟不上时为 2 帧以上，会在日志中体现）
+    const csmBool PipelinedUpdateEnable = true;
+    const csmFloat32 PipelineLatencyLogInterval = 5.0f;
 
     // 默认的渲染目标尺寸
     const csmInt32 RenderTargetWidth = 1900;
@@ -55,6 +55,63 @@ namespace LAppDefine {
     // 框架输出的日志级别设置
     extern const CubismFramework::Option::LogLevel CubismLoggingLevel; ///< 框架日志级别
 
+    // 日志（LAppLog）
+    extern const CubismFramework::Option::LogLevel LogLevel; ///< 框架以外各分类的最低日志级别
+    extern const csmUint32 LogRingCapacity;         ///< 日志环形缓冲区的记录数
+    extern const csmUint32 LogFlushIntervalMilliseconds; ///< 日志输出线程的轮询间隔[毫秒]
+    extern const csmBool LogConsoleEnable;          ///< 是否输出到标准输出
+    extern const csmChar* LogFilePath;              ///< 日志文件路径（空字符串时不写文件）
+
+    // 纹理设置
+    extern const csmBool PremultipliedAlphaEnable;  ///< 加载纹理时是否预乘 alpha（同时选用 PA 着色器）
+    extern const csmInt32 TextureUploadBytesPerFrame; ///< 异步纹理每帧写入 PBO 的最大字节数
+    extern const csmBool TextureCacheEnable;        ///< 是否使用解码后纹理的磁盘缓存
+    extern const csmBool TextureCacheMipmapEnable;  ///< 缓存中是否同时保存 CPU 生成的 mipmap
+    extern const csmUint64 TextureCacheMaxBytes;    ///< 缓存目录的容量上限[字节]（超出时删除最久未使用的文件）
+
+    // 动作烘焙
+    extern const csmBool MotionBakeEnable;          ///< 加载动作时是否把曲线烘焙为定频采样表
+    extern const csmFloat32 MotionBakeSampleRate;   ///< 烘焙采样率[Hz]
+    extern const csmFloat32 MotionBakeMaxError;     ///< 允许的最大插值误差（超出的动作仍按曲线求值）
+
+    // 动作缓存
+    extern const csmBool MotionLazyLoadEnable;      ///< 是否只让待机组常驻，其余动作在第一次播放时加载
+    extern const csmSizeInt MotionCacheBudgetBytes; ///< 按需加载的动作合计的内存预算[字节]（超出时按 LRU 释放）
+
+    // 模型切换
+    extern const csmFloat32 ModelCrossfadeSeconds;  ///< 切换模型时新旧模型交叉淡入淡出的时间[秒]
+
+    // 多实例
+    extern const csmInt32 ModelInstanceMaxCount;    ///< 同时显示的当前模型的副本数上限
+    extern const csmFloat32 ModelInstanceSpacing;   ///< 副本之间的水平间隔（模型坐标）
+
+    // 聊天窗口字体
+    extern const csmBool GlyphCacheEnable;          ///< 是否保存用过的字形，下次启动时预先光栅化
+    extern const csmInt32 GlyphPreloadPerFrame;     ///< 每帧预先光栅化的最大字形数
+
+    // 二进制资源
+    extern const csmBool BinaryAssetEnable;         ///< 存在较新的 .bin 时是否代替 motion3/exp3/physics3.json 加载
+
+    // 文件读取
+    extern const csmBool MappedFileLoadEnable;      ///< 是否用 mmap 读取较大的文件
+    extern const csmSizeInt MappedFileMinBytes;     ///< 使用 mmap 的最小文件大小[字节]
+    extern const csmBool ModelPackEnable;           ///< 模型目录旁存在 .aipack 时是否从包中读取该目录的文件
+    extern const csmBool ParallelAssetLoadEnable;   ///< 是否在工作线程中并行读取并解析模型的各个文件
+
+    // GPU 计时
+    extern const csmBool GpuTimerEnable;            ///< 是否用 GL_TIME_ELAPSED 查询统计各绘制阶段的 GPU 耗时
+    extern const csmFloat32 GpuTimerLogInterval;    ///< GPU 耗时日志的输出间隔[秒]
+
+    // 分配统计
+    extern const csmBool AllocatorStatsEnable;      ///< 是否定期输出每帧分配次数与各尺寸级别的分配直方图
+    extern const csmFloat32 AllocatorStatsLogInterval;  ///< 分配统计日志的输出间隔[秒]
+    extern const csmFloat32 AllocationCheckWarmupSeconds;   ///< 加载或输入事件之后不检查稳定帧分配的时间[秒]
+    extern const csmBool AllocationCheckAbort;      ///< 稳定帧发生分配时是否中止程序
+
+    // 流水线更新
+    extern const csmBool PipelinedUpdateEnable;     ///< 是否在工作线程中更新模型，与上一帧的绘制并行
+    extern const csmFloat32 PipelineLatencyLogInterval; ///< 拖拽输入到绘制的延迟日志的输出间隔[秒]
+
     // 默认的渲染目标尺寸
     extern const csmInt32 RenderTargetWidth;  ///< 默认渲染目标宽度
     extern const csmInt32 RenderTargetHeight; ///< 默认渲染目标高度
@@ -0,0 +1,181 @@
+/**
+ * @file LAppGlyphCache.cpp
+ * 这个文件实现了聊天字体用过的字形集合的保存与启动后的分批预加载。
+ */
+#include "LAppGlyphCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+#include "imgui.h"
+
+#include "LAppDefine.hpp"
+#include "LAppLog.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+namespace {
+
+    const char CacheMagic[8] = { 'A', 'I', 'P', 'G', 'L', 'Y', 'P', 'H' };
+    const csmUint32 CacheVersion = 1;
+
+    /**
+     * @brief 文件头，之后是 count 个升序的 csmUint32 码位
+     */
+    struct CacheHeader
+    {
+        char magic[8];
+        csmUint32 version;
+        csmUint32 count;
+    };
+
+    static_assert(sizeof(CacheHeader) == 16, "CacheHeader must stay 16 bytes");
+
+    std::vector<csmUint32> s_codepoints;    ///< 读取的码位（升序）
+    size_t s_preloadedCount = 0;            ///< 已对 s_font 预加载的个数
+    ImFont* s_font = NULL;                  ///< 正在预加载的字体
+    float s_fontSize = 0.0f;                ///< Update 时字体的大小，Save 按此大小取字形
+}
+
+void LAppGlyphCache::Load()
+{
+    s_codepoints.clear();
+    s_preloadedCount = 0;
+
+    const std::string path = GetCacheFilePath();
+    if (!LAppDefine::GlyphCacheEnable || path.empty())
+    {
+        return;
+    }
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL)
+    {
+        return;
+    }
+
+    CacheHeader header;
+    if (fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) == 0
+        && header.version == CacheVersion
+        && header.count <= IM_UNICODE_CODEPOINT_MAX + 1)
+    {
+        s_codepoints.resize(header.count);
+        if (fread(s_codepoints.data(), sizeof(csmUint32), header.count, file) != header.count)
+        {
+            s_codepoints.clear();
+        }
+    }
+    fclose(file);
+
+    // 以升序为前提合并，顺序不对时按损坏处理
+    if (!std::is_sorted(s_codepoints.begin(), s_codepoints.end()))
+    {
+        s_codepoints.clear();
+    }
+
+    LAppLogInfo(Category_Texture, "glyph cache: %zu glyphs to preload", s_codepoints.size());
+}
+
+void LAppGlyphCache::Update(ImFont* font)
+{
+    if (font != s_font)
+    {
+        s_font = font;
+        s_preloadedCount = 0;
+    }
+    s_fontSize = ImGui::GetFontSize();
+
+    if (s_preloadedCount >= s_codepoints.size())
+    {
+        return;
+    }
+
+    // 与按需光栅化相同，FindGlyph 把字形放入图集，纹理的更新在 Render 之后由后端完成
+    ImFontBaked* baked = ImGui::GetFontBaked();
+    const size_t end = std::min(s_codepoints.size(), s_preloadedCount + static_cast<size_t>(LAppDefine::GlyphPreloadPerFrame));
+    for (; s_preloadedCount < end; s_preloadedCount++)
+    {
+        baked->FindGlyph(static_cast<ImWchar>(s_codepoints[s_preloadedCount]));
+    }
+}
+
+void LAppGlyphCache::Save(ImFont* font)
+{
+    const std::string path = GetCacheFilePath();
+    if (!LAppDefine::GlyphCacheEnable || path.empty() || font == NULL || s_fontSize <= 0.0f)
+    {
+        return;
+    }
+
+    ImFontBaked* baked = font->GetFontBaked(s_fontSize);
+    if (baked == NULL)
+    {
+        return;
+    }
+
+    std::vector<csmUint32> codepoints(s_codepoints);
+    for (int i = 0; i < baked->Glyphs.Size; i++)
+    {
+        codepoints.push_back(baked->Glyphs[i].Codepoint);
+    }
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    if (codepoints == s_codepoints)
+    {
+        return;
+    }
+
+    const std::string directory = path.substr(0, path.rfind('/'));
+    if (!LAppPal::MakeDirectories(directory))
+    {
+        return;
+    }
+
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = CacheVersion;
+    header.count = static_cast<csmUint32>(codepoints.size());
+
+    // 写入临时文件后改名，避免同时退出的另一个进程读到写了一半的文件
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%d.tmp", static_cast<int>(getpid()));
+    const std::string temporaryPath = path + suffix;
+
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if (file == NULL)
+    {
+        return;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(codepoints.data(), sizeof(csmUint32), codepoints.size(), file) == codepoints.size();
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok || rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        unlink(temporaryPath.c_str());
+        LAppLogWarning(Category_Texture, "glyph cache write failed: %s", path.c_str());
+        return;
+    }
+
+    LAppLogInfo(Category_Texture, "glyph cache: saved %zu glyphs (%zu new)", codepoints.size(), codepoints.size() - s_codepoints.size());
+    s_codepoints.swap(codepoints);
+}
+
+std::string LAppGlyphCache::GetCacheFilePath()
+{
+    const std::string directory = LAppPal::GetCacheDirectory();
+    if (directory.empty())
+    {
+        return std::string();
+    }
+
+    return directory + "/glyphs.bin";
+}
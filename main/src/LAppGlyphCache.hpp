@@ -0,0 +1,52 @@
+/**
+ * @file LAppGlyphCache.hpp
+ */
+#pragma once
+
+#include <string>
+
+struct ImFont;
+
+/**
+ * @brief 聊天窗口字体用过的字形集合
+ *
+ * ImGui 在后端支持 ImGuiBackendFlags_RendererHasTextures 时只光栅化实际显示的字形，
+ * 图集纹理按需扩大（字体的 GlyphRanges 只对不支持的后端预先加载）。
+ * 这里在退出时把本次与以往用过的码位写到 $XDG_CACHE_HOME/AIPet/glyphs.bin（或 ~/.cache/AIPet/glyphs.bin），
+ * 下次启动后在每帧中分批预先光栅化，使历史中出现过的字在输入与显示时不再逐字光栅化。
+ * 所有方法都在聊天窗口的线程中调用。
+ */
+class LAppGlyphCache
+{
+public:
+    /**
+     * @brief 读取上次保存的码位集合，作为预加载的对象
+     */
+    static void Load();
+
+    /**
+     * @brief 在 ImGui::PushFont(font) 之后每帧调用，预先光栅化最多 LAppDefine::GlyphPreloadPerFrame 个字形
+     *
+     * 字体被替换时对新字体重新预加载。
+     *
+     * @param[in] font 当前的聊天字体
+     */
+    static void Update(ImFont* font);
+
+    /**
+     * @brief 把字体已光栅化的码位与读取的集合合并后保存（在 ImGui::DestroyContext 之前调用）
+     *
+     * 集合没有增加时不写文件。
+     *
+     * @param[in] font 当前的聊天字体
+     */
+    static void Save(ImFont* font);
+
+private:
+    LAppGlyphCache();
+
+    /**
+     * @brief 缓存文件的路径（无法确定缓存目录时为空字符串）
+     */
+    static std::string GetCacheFilePath();
+};
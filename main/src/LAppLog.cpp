@@ -0,0 +1,458 @@
+/**
+ * @file LAppLog.cpp
+ */
+#include "LAppLog.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <strings.h>
+#include <thread>
+
+#include "LAppDefine.hpp"
+
+using namespace Csm;
+
+namespace {
+
+const size_t RecordTextBytes = 256;     ///< 一条记录的最大长度（与原先 PrintLog 的缓冲区相同，超出的部分截断）
+
+/**
+ * @brief 环形缓冲区中的一条记录
+ *
+ * sequence 为写入方与输出线程交接的序号（有界 MPMC 队列的做法）：
+ * 等于槽位的写入位置时可写，等于写入位置 + 1 时已写完、可输出。
+ */
+struct Record
+{
+    std::atomic<size_t> sequence;       ///< 交接用的序号
+    double time;                        ///< 写入时刻（Start 起的秒数）
+    csmInt32 level;                     ///< 级别
+    csmInt32 category;                  ///< 分类
+    bool newline;                       ///< 是否结束该行
+    char text[RecordTextBytes];         ///< 格式化后的文本
+};
+
+const char* const CategoryNames[LAppLog::Category_Count] = { "app", "cubism", "model", "expression", "input", "texture", "ai" };
+const char* const LevelNames[] = { "verbose", "debug", "info", "warning", "error", "off" };
+const char LevelLetters[] = { 'V', 'D', 'I', 'W', 'E', '-' };
+
+std::atomic<csmInt32> s_categoryLevels[LAppLog::Category_Count];
+
+std::unique_ptr<Record[]> s_records;    ///< 环形缓冲区（Start 之后不再释放，Stop 之后迟到的写入也不会访问已释放的内存）
+size_t s_recordMask = 0;                ///< 容量 - 1
+std::atomic<size_t> s_writePosition(0); ///< 下一条记录的写入位置
+size_t s_readPosition = 0;              ///< 下一条要输出的位置（由 s_outputMutex 保护）
+std::atomic<csmUint64> s_droppedCount(0);   ///< 缓冲区满时丢弃的记录数
+csmUint64 s_reportedDropCount = 0;      ///< 已报告的丢弃数（由 s_outputMutex 保护）
+
+std::atomic<bool> s_running(false);     ///< 输出线程是否在运行（为 false 时同步输出）
+std::thread s_thread;
+std::mutex s_wakeMutex;
+std::condition_variable s_wakeCondition;
+bool s_stopping = false;                ///< 输出线程退出标志（由 s_wakeMutex 保护）
+
+std::mutex s_outputMutex;               ///< 同步输出与输出线程共用，保证行不交错
+FILE* s_file = NULL;                    ///< 日志文件（未指定时为 NULL）
+bool s_lineOpen = false;                ///< 上一条记录没有结束该行（由 s_outputMutex 保护）
+const std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
+
+/**
+ * @brief 首次使用时按 LAppDefine 设置各分类的最低级别
+ */
+void InitializeLevels()
+{
+    static const bool initialized = []()
+    {
+        for (csmInt32 i = 0; i < LAppLog::Category_Count; i++)
+        {
+            s_categoryLevels[i].store(i == LAppLog::Category_Cubism ? LAppDefine::CubismLoggingLevel : LAppDefine::LogLevel, std::memory_order_relaxed);
+        }
+        return true;
+    }();
+    (void)initialized;
+}
+
+/**
+ * @brief 可变参数版的 LAppLog::PrintV
+ */
+void PrintFormatted(LAppLog::Level level, LAppLog::Category category, bool newline, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    LAppLog::PrintV(level, category, newline, format, args);
+    va_end(args);
+}
+
+double GetTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - s_startTime).count();
+}
+
+/**
+ * @brief 写出一条记录（持有 s_outputMutex 时调用）
+ */
+void WriteRecord(double time, csmInt32 level, csmInt32 category, bool newline, const char* text)
+{
+    char prefix[48];
+    prefix[0] = '\0';
+    if (!s_lineOpen)
+    {
+        snprintf(prefix, sizeof(prefix), "[%9.3f][%c][%s] ", time, LevelLetters[level], CategoryNames[category]);
+    }
+
+    // 文本自带的换行由记录的 newline 表示
+    size_t length = strlen(text);
+    while (length > 0 && text[length - 1] == '\n')
+    {
+        length--;
+    }
+
+    if (LAppDefine::LogConsoleEnable)
+    {
+        fputs(prefix, stdout);
+        fwrite(text, 1, length, stdout);
+        if (newline)
+        {
+            fputc('\n', stdout);
+        }
+    }
+    if (s_file != NULL)
+    {
+        fputs(prefix, s_file);
+        fwrite(text, 1, length, s_file);
+        if (newline)
+        {
+            fputc('\n', s_file);
+        }
+    }
+
+    s_lineOpen = !newline;
+}
+
+void FlushOutput()
+{
+    if (LAppDefine::LogConsoleEnable)
+    {
+        fflush(stdout);
+    }
+    if (s_file != NULL)
+    {
+        fflush(s_file);
+    }
+}
+
+/**
+ * @brief 输出缓冲区中已写完的记录
+ *
+ * @return 输出的记录数
+ */
+size_t Drain()
+{
+    std::lock_guard<std::mutex> lock(s_outputMutex);
+
+    size_t count = 0;
+    for (;;)
+    {
+        Record& record = s_records[s_readPosition & s_recordMask];
+        if (record.sequence.load(std::memory_order_acquire) != s_readPosition + 1)
+        {
+            break;
+        }
+
+        WriteRecord(record.time, record.level, record.category, record.newline, record.text);
+        record.sequence.store(s_readPosition + s_recordMask + 1, std::memory_order_release);
+        s_readPosition++;
+        count++;
+    }
+
+    const csmUint64 dropped = s_droppedCount.load(std::memory_order_relaxed);
+    if (dropped != s_reportedDropCount)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "%llu log records dropped (buffer full)", static_cast<unsigned long long>(dropped - s_reportedDropCount));
+        s_lineOpen = false;
+        WriteRecord(GetTime(), CubismFramework::Option::LogLevel_Warning, LAppLog::Category_App, true, text);
+        s_reportedDropCount = dropped;
+    }
+
+    if (count > 0)
+    {
+        FlushOutput();
+    }
+    return count;
+}
+
+void OutputThreadMain()
+{
+    const std::chrono::milliseconds interval(LAppDefine::LogFlushIntervalMilliseconds);
+
+    std::unique_lock<std::mutex> lock(s_wakeMutex);
+    while (!s_stopping)
+    {
+        lock.unlock();
+        const size_t count = Drain();
+        lock.lock();
+
+        // 写入方不加锁也不通知（警告以上除外），按间隔轮询
+        if (count == 0 && !s_stopping)
+        {
+            s_wakeCondition.wait_for(lock, interval);
+        }
+    }
+}
+
+/**
+ * @brief 按名称查找级别（找不到时返回 -1）
+ */
+csmInt32 FindLevel(const char* name, size_t length)
+{
+    for (csmInt32 i = 0; i <= CubismFramework::Option::LogLevel_Off; i++)
+    {
+        if (strlen(LevelNames[i]) == length && strncasecmp(LevelNames[i], name, length) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+}
+
+void LAppLog::Start()
+{
+    if (s_running)
+    {
+        return;
+    }
+
+    if (!s_records)
+    {
+        // 容量取不小于设定值的 2 的幂，位置与掩码取与即得到槽位
+        size_t capacity = 2;
+        while (capacity < LAppDefine::LogRingCapacity)
+        {
+            capacity *= 2;
+        }
+        s_records.reset(new Record[capacity]);
+        for (size_t i = 0; i < capacity; i++)
+        {
+            s_records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        s_recordMask = capacity - 1;
+    }
+
+    if (s_file == NULL && LAppDefine::LogFilePath[0] != '\0')
+    {
+        s_file = fopen(LAppDefine::LogFilePath, "a");
+    }
+
+    s_stopping = false;
+    s_thread = std::thread(OutputThreadMain);
+    s_running.store(true, std::memory_order_release);
+
+    // 未经 Cleanup 退出（初始化失败等）时也输出剩余记录，并在 std::thread 析构前结束输出线程
+    static const bool registered = (std::atexit(Stop) == 0);
+    (void)registered;
+}
+
+void LAppLog::Stop()
+{
+    if (!s_running)
+    {
+        return;
+    }
+
+    s_running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(s_wakeMutex);
+        s_stopping = true;
+    }
+    s_wakeCondition.notify_one();
+    s_thread.join();
+
+    // 停止前放入的记录（与 Stop 同时进行的写入可能不输出）
+    Drain();
+
+    std::lock_guard<std::mutex> lock(s_outputMutex);
+    if (s_file != NULL)
+    {
+        fclose(s_file);
+        s_file = NULL;
+    }
+}
+
+void LAppLog::Configure(const char* spec)
+{
+    if (spec == NULL)
+    {
+        return;
+    }
+
+    const char* item = spec;
+    while (*item != '\0')
+    {
+        const char* end = strchr(item, ',');
+        if (end == NULL)
+        {
+            end = item + strlen(item);
+        }
+
+        const char* separator = static_cast<const char*>(memchr(item, '=', end - item));
+        if (separator == NULL)
+        {
+            const csmInt32 level = FindLevel(item, end - item);
+            for (csmInt32 i = 0; level >= 0 && i < Category_Count; i++)
+            {
+                SetCategoryLevel(static_cast<Category>(i), static_cast<Level>(level));
+            }
+        }
+        else
+        {
+            const csmInt32 level = FindLevel(separator + 1, end - separator - 1);
+            for (csmInt32 i = 0; level >= 0 && i < Category_Count; i++)
+            {
+                if (strlen(CategoryNames[i]) == static_cast<size_t>(separator - item) && strncasecmp(CategoryNames[i], item, separator - item) == 0)
+                {
+                    SetCategoryLevel(static_cast<Category>(i), static_cast<Level>(level));
+                }
+            }
+        }
+
+        item = *end == ',' ? end + 1 : end;
+    }
+}
+
+void LAppLog::SetCategoryLevel(Category category, Level level)
+{
+    InitializeLevels();
+    s_categoryLevels[category].store(level, std::memory_order_relaxed);
+}
+
+LAppLog::Level LAppLog::GetCategoryLevel(Category category)
+{
+    InitializeLevels();
+    return static_cast<Level>(s_categoryLevels[category].load(std::memory_order_relaxed));
+}
+
+bool LAppLog::IsEnabled(Level level, Category category)
+{
+    InitializeLevels();
+    return level < CubismFramework::Option::LogLevel_Off && level >= s_categoryLevels[category].load(std::memory_order_relaxed);
+}
+
+void LAppLog::Print(Level level, Category category, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    PrintV(level, category, true, format, args);
+    va_end(args);
+}
+
+void LAppLog::PrintV(Level level, Category category, bool newline, const char* format, va_list args)
+{
+    if (!s_running.load(std::memory_order_acquire))
+    {
+        char text[RecordTextBytes];
+        vsnprintf(text, sizeof(text), format, args);
+
+        std::lock_guard<std::mutex> lock(s_outputMutex);
+        WriteRecord(GetTime(), level, category, newline, text);
+        FlushOutput();
+        return;
+    }
+
+    // 取得可写的槽位；缓冲区满（输出线程还没读到该槽位）时丢弃
+    size_t position = s_writePosition.load(std::memory_order_relaxed);
+    Record* record;
+    for (;;)
+    {
+        record = &s_records[position & s_recordMask];
+        const size_t sequence = record->sequence.load(std::memory_order_acquire);
+        const ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+        if (difference == 0)
+        {
+            if (s_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            s_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            position = s_writePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->time = GetTime();
+    record->level = level;
+    record->category = category;
+    record->newline = newline;
+    vsnprintf(record->text, sizeof(record->text), format, args);
+    record->sequence.store(position + 1, std::memory_order_release);
+
+    // 警告以上尽快输出（未加锁的通知可能错过等待，最迟在下一次轮询时输出）
+    if (level >= CubismFramework::Option::LogLevel_Warning)
+    {
+        s_wakeCondition.notify_one();
+    }
+}
+
+void LAppLog::PrintCubismMessage(const csmChar* message)
+{
+    // 框架的消息形如 "[CSM][W]..."，级别已由 CubismFramework::Option::LoggingLevel 过滤
+    Level level = CubismFramework::Option::LogLevel_Info;
+    if (strncmp(message, "[CSM][", 6) == 0 && message[6] != '\0' && message[7] == ']')
+    {
+        for (csmInt32 i = 0; i < CubismFramework::Option::LogLevel_Off; i++)
+        {
+            if (message[6] == LevelLetters[i])
+            {
+                level = static_cast<Level>(i);
+                message += 8;
+                break;
+            }
+        }
+    }
+
+    if (!IsEnabled(level, Category_Cubism))
+    {
+        return;
+    }
+
+    const size_t length = strlen(message);
+    PrintFormatted(level, Category_Cubism, length > 0 && message[length - 1] == '\n', "%s", message);
+}
+
+void LAppLog::Flush()
+{
+    if (!s_running.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // 输出线程读到调用时的写入位置为止
+    const size_t target = s_writePosition.load(std::memory_order_acquire);
+    s_wakeCondition.notify_one();
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_outputMutex);
+            if (static_cast<ptrdiff_t>(s_readPosition - target) >= 0)
+            {
+                return;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
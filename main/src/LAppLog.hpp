@@ -0,0 +1,117 @@
+/**
+ * @file LAppLog.hpp
+ */
+#pragma once
+
+#include <cstdarg>
+
+#include <CubismFramework.hpp>
+
+/**
+ * @brief 编译进程序的最低日志级别（CSM_LOG_LEVEL_VERBOSE 到 CSM_LOG_LEVEL_OFF）
+ *
+ * 由 CMake 的 AIPET_LOG_LEVEL 设置。低于该级别的 LAppLogXxx 调用连同参数的求值在编译时去除。
+ */
+#ifndef AIPET_LOG_LEVEL
+#define AIPET_LOG_LEVEL CSM_LOG_LEVEL_VERBOSE
+#endif
+
+#define LAppLogPrint(level, category, fmt, ...) \
+    do { if ((level) >= AIPET_LOG_LEVEL && LAppLog::IsEnabled((level), (category))) { LAppLog::Print((level), (category), fmt, ## __VA_ARGS__); } } while (0)
+
+#define LAppLogVerbose(category, fmt, ...)  LAppLogPrint(Csm::CubismFramework::Option::LogLevel_Verbose, LAppLog::category, fmt, ## __VA_ARGS__)
+#define LAppLogDebug(category, fmt, ...)    LAppLogPrint(Csm::CubismFramework::Option::LogLevel_Debug,   LAppLog::category, fmt, ## __VA_ARGS__)
+#define LAppLogInfo(category, fmt, ...)     LAppLogPrint(Csm::CubismFramework::Option::LogLevel_Info,    LAppLog::category, fmt, ## __VA_ARGS__)
+#define LAppLogWarning(category, fmt, ...)  LAppLogPrint(Csm::CubismFramework::Option::LogLevel_Warning, LAppLog::category, fmt, ## __VA_ARGS__)
+#define LAppLogError(category, fmt, ...)    LAppLogPrint(Csm::CubismFramework::Option::LogLevel_Error,   LAppLog::category, fmt, ## __VA_ARGS__)
+
+/**
+ * @brief 分级、分类的异步日志
+ *
+ * 记录在调用线程中格式化后放入固定大小的无锁环形缓冲区，由输出线程写到标准输出或日志文件，
+ * 调用线程不等待 I/O，也不分配内存。缓冲区满时丢弃新记录并计数，由输出线程报告丢弃的条数。
+ * 级别沿用 Cubism 框架的 LogLevel。各分类的最低级别的初始值为 LAppDefine::LogLevel
+ * （Cubism 分类为 LAppDefine::CubismLoggingLevel），可用 Configure 或 SetCategoryLevel 在运行时修改。
+ * Start 之前与 Stop 之后的记录在调用线程中同步输出。
+ */
+class LAppLog
+{
+public:
+    typedef Csm::CubismFramework::Option::LogLevel Level;
+
+    /**
+     * @brief 日志分类
+     */
+    enum Category
+    {
+        Category_App = 0,       ///< 应用全体（LAppPal::PrintLog 等）
+        Category_Cubism,        ///< Cubism 框架
+        Category_Model,         ///< 模型与资源的加载
+        Category_Expression,    ///< 表情
+        Category_Input,         ///< 鼠标与触摸输入
+        Category_Texture,       ///< 纹理
+        Category_AI,            ///< AI 对话
+        Category_Count
+    };
+
+    /**
+     * @brief 分配环形缓冲区，启动输出线程
+     */
+    static void Start();
+
+    /**
+     * @brief 输出剩余的记录并停止输出线程
+     */
+    static void Stop();
+
+    /**
+     * @brief 按文本设置各分类的最低级别
+     *
+     * 以逗号分隔，"级别" 设置全部分类，"分类=级别" 设置单个分类，例如 "info,input=debug,cubism=verbose"。
+     * 级别为 verbose / debug / info / warning / error / off，分类为 app / cubism / model /
+     * expression / input / texture / ai。无法识别的项忽略。
+     *
+     * @param[in] spec 设置文本（NULL 时不做处理）
+     */
+    static void Configure(const char* spec);
+
+    /**
+     * @brief 设置分类的最低级别
+     */
+    static void SetCategoryLevel(Category category, Level level);
+
+    /**
+     * @brief 返回分类的最低级别
+     */
+    static Level GetCategoryLevel(Category category);
+
+    /**
+     * @brief 该级别、分类的记录是否会输出
+     */
+    static bool IsEnabled(Level level, Category category);
+
+    /**
+     * @brief 输出一行记录（不检查级别，通常经 LAppLogXxx 调用）
+     */
+    static void Print(Level level, Category category, const char* format, ...);
+
+    /**
+     * @brief 输出记录
+     *
+     * @param[in] newline 是否结束该行（为 false 时下一条记录接在同一行后）
+     */
+    static void PrintV(Level level, Category category, bool newline, const char* format, va_list args);
+
+    /**
+     * @brief 作为 CubismFramework::Option::LogFunction 使用，按消息的 "[CSM][X]" 前缀判断级别
+     */
+    static void PrintCubismMessage(const Csm::csmChar* message);
+
+    /**
+     * @brief 等待此前放入的记录全部输出（中止程序前等使用）
+     */
+    static void Flush();
+
+private:
+    LAppLog();
+};
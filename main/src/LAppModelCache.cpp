@@ -0,0 +1,232 @@
+/**
+ * @file LAppModelCache.cpp
+ */
+#include "LAppModelCache.hpp"
+
+#include <map>
+#include <mutex>
+
+#include "LAppDefine.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+/**
+ * @brief 一个模型的共用数据
+ *
+ * 模板的读取与解析在锁外进行，两个实例同时解析同一文件时，后完成的一方丢弃自己的结果。
+ */
+struct LAppModelCache::Entry
+{
+    std::string path;                                           ///< model3.json 的路径
+    csmUint32 references;                                       ///< 引用该表项的实例数（由 s_entriesMutex 保护）
+
+    std::mutex mocMutex;                                        ///< 保护 moc 与它的模型计数
+    CubismMoc* moc;                                             ///< 共用的 moc
+
+    std::mutex mutex;                                           ///< 保护以下的模板
+    CubismPhysics* physics;                                     ///< 物理设置的模板
+    std::map<std::string, CubismMotion*> motions;               ///< 动作名到模板
+    std::map<std::string, CubismExpressionMotion*> expressions; ///< 表情名到模板
+};
+
+namespace {
+
+LAppModelCache* s_instance = NULL;
+
+std::mutex s_entriesMutex;
+std::map<std::string, LAppModelCache::Entry*> s_entries;
+
+/**
+ * @brief 取出名称对应的模板（没有时在锁外调用 load 并登记结果），在持有锁期间用 makeInstance 生成实例
+ *
+ * 模板的查找、登记与实例的生成在同一次持锁中完成，其他实例的 TrimMotion 不会在其间删除模板。
+ */
+template <typename T>
+T* GetOrLoad(std::mutex& mutex, std::map<std::string, T*>& templates, const std::string& name,
+    const std::function<T*()>& load, const std::function<T*(const T*)>& makeInstance)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        typename std::map<std::string, T*>::iterator it = templates.find(name);
+        if (it != templates.end())
+        {
+            return makeInstance(it->second);
+        }
+    }
+
+    T* loaded = load();
+    if (loaded == NULL)
+    {
+        return NULL;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::pair<typename std::map<std::string, T*>::iterator, bool> result = templates.insert(std::make_pair(name, loaded));
+    if (!result.second)
+    {
+        ACubismMotion::Delete(loaded);
+    }
+    return makeInstance(result.first->second);
+}
+
+}
+
+LAppModelCache* LAppModelCache::GetInstance()
+{
+    if (s_instance == NULL)
+    {
+        s_instance = new LAppModelCache();
+    }
+
+    return s_instance;
+}
+
+void LAppModelCache::ReleaseInstance()
+{
+    delete s_instance;
+    s_instance = NULL;
+}
+
+LAppModelCache::LAppModelCache()
+{
+}
+
+LAppModelCache::~LAppModelCache()
+{
+    std::lock_guard<std::mutex> lock(s_entriesMutex);
+    if (!s_entries.empty())
+    {
+        LAppPal::PrintLogLn("[APP]model cache released with %zu models still in use", s_entries.size());
+    }
+}
+
+LAppModelCache::Entry* LAppModelCache::Acquire(const std::string& modelSettingPath)
+{
+    std::lock_guard<std::mutex> lock(s_entriesMutex);
+    std::map<std::string, Entry*>::iterator it = s_entries.find(modelSettingPath);
+    if (it != s_entries.end())
+    {
+        it->second->references++;
+        return it->second;
+    }
+
+    Entry* entry = new Entry();
+    entry->path = modelSettingPath;
+    entry->references = 1;
+    entry->moc = NULL;
+    entry->physics = NULL;
+    s_entries[modelSettingPath] = entry;
+    return entry;
+}
+
+void LAppModelCache::Release(Entry* entry)
+{
+    if (entry == NULL)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_entriesMutex);
+        entry->references--;
+        if (entry->references > 0)
+        {
+            return;
+        }
+        s_entries.erase(entry->path);
+    }
+
+    for (std::map<std::string, CubismMotion*>::iterator it = entry->motions.begin(); it != entry->motions.end(); ++it)
+    {
+        ACubismMotion::Delete(it->second);
+    }
+    for (std::map<std::string, CubismExpressionMotion*>::iterator it = entry->expressions.begin(); it != entry->expressions.end(); ++it)
+    {
+        ACubismMotion::Delete(it->second);
+    }
+    CubismPhysics::Delete(entry->physics);
+    CubismMoc::Delete(entry->moc);
+
+    if (LAppDefine::DebugLogEnable)
+    {
+        LAppPal::PrintLogLn("[APP]model cache release: %s", entry->path.c_str());
+    }
+    delete entry;
+}
+
+CubismModel* LAppModelCache::CreateModel(Entry* entry, const std::function<CubismMoc*()>& loadMoc, CubismMoc** moc)
+{
+    // moc 较大，读取期间持有锁，同时加载的实例等待而不重复读取（动作等的解析不受影响）
+    std::lock_guard<std::mutex> lock(entry->mocMutex);
+    if (entry->moc == NULL)
+    {
+        entry->moc = loadMoc();
+    }
+
+    *moc = entry->moc;
+    return entry->moc != NULL ? entry->moc->CreateModel() : NULL;
+}
+
+void LAppModelCache::DeleteModel(Entry* entry, CubismModel* model)
+{
+    if (model == NULL)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(entry->mocMutex);
+    entry->moc->DeleteModel(model);
+}
+
+CubismMotion* LAppModelCache::CreateMotion(Entry* entry, const csmString& name, const std::function<CubismMotion*()>& load)
+{
+    // 共用数据的引用计数在锁内增加，之后 TrimMotion 看到的模板已处于共用状态
+    return GetOrLoad<CubismMotion>(entry->mutex, entry->motions, std::string(name.GetRawString()), load,
+        [](const CubismMotion* source) { return CubismMotion::CreateShared(source); });
+}
+
+void LAppModelCache::TrimMotion(Entry* entry, const csmString& name)
+{
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    std::map<std::string, CubismMotion*>::iterator it = entry->motions.find(name.GetRawString());
+    if (it != entry->motions.end() && !it->second->IsDataShared())
+    {
+        ACubismMotion::Delete(it->second);
+        entry->motions.erase(it);
+    }
+}
+
+CubismExpressionMotion* LAppModelCache::CreateExpression(Entry* entry, const csmString& name, const std::function<CubismExpressionMotion*()>& load)
+{
+    return GetOrLoad<CubismExpressionMotion>(entry->mutex, entry->expressions, std::string(name.GetRawString()), load,
+        [](const CubismExpressionMotion* source) { return CubismExpressionMotion::CreateShared(source); });
+}
+
+CubismPhysics* LAppModelCache::CreatePhysics(Entry* entry, const std::function<CubismPhysics*()>& load)
+{
+    {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        if (entry->physics != NULL)
+        {
+            return CubismPhysics::CreateShared(entry->physics);
+        }
+    }
+
+    CubismPhysics* loaded = load();
+    if (loaded == NULL)
+    {
+        return NULL;
+    }
+
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    if (entry->physics == NULL)
+    {
+        entry->physics = loaded;
+    }
+    else
+    {
+        CubismPhysics::Delete(loaded);
+    }
+    return CubismPhysics::CreateShared(entry->physics);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file LAppModelCache.hpp
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <CubismFramework.hpp>
+#include <Model/CubismMoc.hpp>
+#include <Model/CubismModel.hpp>
+#include <Motion/CubismExpressionMotion.hpp>
+#include <Motion/CubismMotion.hpp>
+#include <Physics/CubismPhysics.hpp>
+
+/**
+ * @brief 同一模型的多个实例共用的只读数据
+ *
+ * 进程内共享一个实例（GetInstance），按 model3.json 的路径登记，以实例数为引用计数。
+ * moc 只读取一次，各实例的 CubismModel 都由它生成；动作、表情与物理设置第一次请求时解析为模板，
+ * 之后实例得到的动作、表情与物理设置都与模板共用解析结果（各自的 CreateShared，以引用计数管理），
+ * 参数索引、参数状态、物理点与动作队列仍由各实例持有。模板本身不参与播放，只在引用它的实例全部释放后删除。
+ * 纹理由 LAppTextureManager 按路径共享，不在这里管理。
+ * 除 GetInstance 与 ReleaseInstance 以外的方法可在任意线程调用。
+ */
+class LAppModelCache
+{
+public:
+    struct Entry;
+
+    /**
+     * @brief 返回实例，首次调用时创建
+     */
+    static LAppModelCache* GetInstance();
+
+    /**
+     * @brief 释放实例（需在全部表项归还之后调用）
+     */
+    static void ReleaseInstance();
+
+    /**
+     * @brief 取得模型的表项并增加引用计数
+     *
+     * @param[in] modelSettingPath model3.json 的路径
+     */
+    Entry* Acquire(const std::string& modelSettingPath);
+
+    /**
+     * @brief 归还表项，最后一个实例归还时删除 moc 与全部模板
+     *
+     * 归还前需通过 DeleteModel 删除由该表项生成的全部模型。
+     */
+    void Release(Entry* entry);
+
+    /**
+     * @brief 用共用的 moc 生成模型，尚未读取 moc 时先调用 loadMoc 读取
+     *
+     * @param[in]  entry    表项
+     * @param[in]  loadMoc  读取 moc（失败时返回 NULL）
+     * @param[out] moc      生成模型所用的 moc
+     * @return 模型；moc 读取或模型生成失败时返回 NULL
+     */
+    Csm::CubismModel* CreateModel(Entry* entry, const std::function<Csm::CubismMoc*()>& loadMoc, Csm::CubismMoc** moc);
+
+    /**
+     * @brief 删除由 CreateModel 生成的模型
+     */
+    void DeleteModel(Entry* entry, Csm::CubismModel* model);
+
+    /**
+     * @brief 返回与模板共用曲线的动作，尚无模板时先调用 load 解析
+     *
+     * @param[in] entry 表项
+     * @param[in] name  动作名
+     * @param[in] load  读取并解析动作（失败时返回 NULL）
+     * @return 动作；解析失败时返回 NULL
+     */
+    Csm::CubismMotion* CreateMotion(Entry* entry, const Csm::csmString& name, const std::function<Csm::CubismMotion*()>& load);
+
+    /**
+     * @brief 没有实例再使用该动作时删除模板（实例按预算释放动作后调用）
+     */
+    void TrimMotion(Entry* entry, const Csm::csmString& name);
+
+    /**
+     * @brief 返回与模板共用参数表的表情，尚无模板时先调用 load 解析
+     */
+    Csm::CubismExpressionMotion* CreateExpression(Entry* entry, const Csm::csmString& name, const std::function<Csm::CubismExpressionMotion*()>& load);
+
+    /**
+     * @brief 返回与模板共用物理设置的物理演算，尚无模板时先调用 load 解析
+     */
+    Csm::CubismPhysics* CreatePhysics(Entry* entry, const std::function<Csm::CubismPhysics*()>& load);
+
+private:
+    LAppModelCache();
+    ~LAppModelCache();
+};
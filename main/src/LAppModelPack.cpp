@@ -0,0 +1,263 @@
+/**
+ * @file LAppModelPack.cpp
+ */
+#include "LAppModelPack.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LAppDefine.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+namespace {
+
+// 已挂载的包，以及已解除挂载但还有数据未归还的包
+std::mutex s_packsMutex;
+std::vector<LAppModelPack*> s_packs;
+
+}
+
+const char* const LAppModelPack::FileExtension = ".aipack";
+
+std::string LAppModelPack::GetPackPath(const std::string& directory)
+{
+    std::string path = directory;
+    while (!path.empty() && path[path.size() - 1] == '/')
+    {
+        path.erase(path.size() - 1);
+    }
+    return path + FileExtension;
+}
+
+bool LAppModelPack::Exists(const std::string& directory)
+{
+    struct stat statBuf;
+    return stat(GetPackPath(directory).c_str(), &statBuf) == 0 && S_ISREG(statBuf.st_mode);
+}
+
+LAppModelPack* LAppModelPack::Mount(const std::string& directory)
+{
+    std::string key = directory;
+    if (key.empty() || key[key.size() - 1] != '/')
+    {
+        key += '/';
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_packsMutex);
+        for (size_t i = 0; i < s_packs.size(); i++)
+        {
+            if (s_packs[i]->_mountCount > 0 && s_packs[i]->_directory == key)
+            {
+                s_packs[i]->_mountCount++;
+                return s_packs[i];
+            }
+        }
+    }
+
+    const std::string packPath = GetPackPath(key);
+    const int fd = open(packPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat statBuf;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &statBuf) == 0 && statBuf.st_size >= static_cast<off_t>(sizeof(LAppModelPackFormat::Header)))
+    {
+        // 写时复制的私有映射：原样存放的文件直接交给调用方，即使被写入也不会改动包
+        mapped = mmap(NULL, statBuf.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (mapped == MAP_FAILED)
+    {
+        LAppPal::PrintLogLn("[APP]model pack map failed: %s", packPath.c_str());
+        return NULL;
+    }
+
+    // 缺页时不做预读：默认的预读窗口会在读头部时把整个包同步读入，纹理也包括在内
+    const size_t size = static_cast<size_t>(statBuf.st_size);
+    madvise(mapped, size, MADV_RANDOM);
+
+    const LAppModelPackFormat::Header* header = LAppModelPackFormat::GetHeader(static_cast<csmByte*>(mapped), size);
+    if (header == NULL)
+    {
+        LAppPal::PrintLogLn("[APP]unsupported model pack, ignored: %s", packPath.c_str());
+        munmap(mapped, size);
+        return NULL;
+    }
+
+    // 包的前部是加载模型时马上读取的文件，提前预读；纹理等在 Find 时再预读
+    if (header->PreloadSize > 0)
+    {
+        madvise(mapped, header->PreloadSize, MADV_WILLNEED);
+    }
+
+    LAppModelPack* pack = new LAppModelPack();
+    pack->_directory = key;
+    pack->_data = static_cast<csmByte*>(mapped);
+    pack->_size = size;
+    pack->_header = header;
+    pack->_mountCount = 1;
+
+    if (LAppDefine::DebugLogEnable)
+    {
+        LAppPal::PrintLogLn("[APP]model pack mounted: %s (%u files, %zu KB)", packPath.c_str(), header->EntryCount, size / 1024);
+    }
+
+    // 两个线程同时挂载同一目录时，后完成的一方使用先登记的包
+    std::lock_guard<std::mutex> lock(s_packsMutex);
+    for (size_t i = 0; i < s_packs.size(); i++)
+    {
+        if (s_packs[i]->_mountCount > 0 && s_packs[i]->_directory == key)
+        {
+            s_packs[i]->_mountCount++;
+            delete pack;
+            return s_packs[i];
+        }
+    }
+    s_packs.push_back(pack);
+    return pack;
+}
+
+void LAppModelPack::Unmount(LAppModelPack* pack)
+{
+    if (pack == NULL)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(s_packsMutex);
+    pack->_mountCount--;
+    if (pack->_mountCount > 0 || pack->_references > 0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < s_packs.size(); i++)
+    {
+        if (s_packs[i] == pack)
+        {
+            s_packs[i] = s_packs.back();
+            s_packs.pop_back();
+            break;
+        }
+    }
+    delete pack;
+}
+
+bool LAppModelPack::Find(const char* path, File* file, bool* covered)
+{
+    bool prefetch = false;
+    {
+        std::lock_guard<std::mutex> lock(s_packsMutex);
+        LAppModelPack* pack = NULL;
+        const LAppModelPackFormat::Entry* entry = FindLocked(path, &pack, covered);
+        if (entry == NULL)
+        {
+            return false;
+        }
+
+        file->data = pack->_data + entry->DataOffset;
+        file->storedSize = entry->StoredSize;
+        file->size = entry->Size;
+        file->compression = entry->Compression;
+        pack->_references++;
+
+        prefetch = entry->DataOffset >= pack->_header->PreloadSize && entry->StoredSize >= LAppDefine::MappedFileMinBytes;
+    }
+
+    // 预读范围以外的较大文件（纹理等）与散文件一样提前预读（持有引用期间映射不会被解除）
+    if (prefetch)
+    {
+        const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(file->data) / pageSize * pageSize;
+        madvise(reinterpret_cast<void*>(begin), reinterpret_cast<uintptr_t>(file->data) + file->storedSize - begin, MADV_WILLNEED);
+    }
+    return true;
+}
+
+bool LAppModelPack::Contains(const char* path, bool* covered)
+{
+    std::lock_guard<std::mutex> lock(s_packsMutex);
+    LAppModelPack* pack = NULL;
+    return FindLocked(path, &pack, covered) != NULL;
+}
+
+bool LAppModelPack::Release(const csmByte* data)
+{
+    std::lock_guard<std::mutex> lock(s_packsMutex);
+    for (size_t i = 0; i < s_packs.size(); i++)
+    {
+        LAppModelPack* pack = s_packs[i];
+        if (data < pack->_data || data >= pack->_data + pack->_size)
+        {
+            continue;
+        }
+
+        pack->_references--;
+        if (pack->_mountCount == 0 && pack->_references == 0)
+        {
+            s_packs[i] = s_packs.back();
+            s_packs.pop_back();
+            delete pack;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+const LAppModelPackFormat::Entry* LAppModelPack::FindLocked(const char* path, LAppModelPack** pack, bool* covered)
+{
+    *covered = false;
+
+    const size_t pathLength = strlen(path);
+    for (size_t i = 0; i < s_packs.size(); i++)
+    {
+        const std::string& directory = s_packs[i]->_directory;
+        if (s_packs[i]->_mountCount == 0 || pathLength <= directory.size() || directory.compare(0, directory.size(), path, directory.size()) != 0)
+        {
+            continue;
+        }
+
+        *covered = true;
+        *pack = s_packs[i];
+
+        const char* relative = path + directory.size();
+        while (relative[0] == '.' && relative[1] == '/')
+        {
+            relative += 2;
+        }
+        return LAppModelPackFormat::FindEntry(s_packs[i]->_header, relative, strlen(relative));
+    }
+
+    return NULL;
+}
+
+LAppModelPack::LAppModelPack()
+    : _data(NULL)
+    , _size(0)
+    , _header(NULL)
+    , _mountCount(0)
+    , _references(0)
+{
+}
+
+LAppModelPack::~LAppModelPack()
+{
+    if (_data != NULL)
+    {
+        munmap(_data, _size);
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file LAppModelPack.hpp
+ */
+#pragma once
+
+#include <string>
+
+#include <CubismFramework.hpp>
+
+#include "LAppModelPackFormat.hpp"
+
+/**
+ * @brief 已挂载的模型包
+ *
+ * 模型目录 "X/Haru/" 旁存在 "X/Haru.aipack" 时，挂载后该目录下的文件都从包中读取：
+ * 整个包只 open 并 mmap 一次，LAppPal::LoadFileAsBytes 按相对路径查哈希索引取出数据，
+ * 原样存放的文件直接返回映射内的地址（不拷贝），压缩的文件解压到新的缓冲区。
+ * 挂载期间包优先于目录中的散文件，修改模型文件后需要重新生成包（AIPetModelPacker）。
+ *
+ * 同一目录可以被挂载多次（多个模型实例），按次数计数。
+ * 从包中取出且尚未 ReleaseBytes 的数据也持有包的引用（纹理可能仍在解码线程中读取），
+ * 挂载次数与引用都归零后才解除映射。所有函数都是线程安全的。
+ */
+class LAppModelPack
+{
+public:
+    static const char* const FileExtension;     ///< 包的扩展名（".aipack"）
+
+    /**
+     * @brief 从包中找到的文件
+     */
+    struct File
+    {
+        const Csm::csmByte* data;       ///< 包中的数据（映射内的地址）
+        Csm::csmSizeInt storedSize;     ///< 包中数据的字节数
+        Csm::csmSizeInt size;           ///< 原文件的字节数
+        Csm::csmUint16 compression;     ///< LAppModelPackFormat::Compression
+    };
+
+    /**
+     * @brief 返回模型目录对应的包的路径（去掉末尾的 '/' 再加扩展名）
+     */
+    static std::string GetPackPath(const std::string& directory);
+
+    /**
+     * @brief 模型目录对应的包是否存在
+     */
+    static bool Exists(const std::string& directory);
+
+    /**
+     * @brief 挂载模型目录对应的包
+     *
+     * 目录已被挂载时只增加挂载次数。
+     *
+     * @param[in] directory 模型目录（以 '/' 结尾）
+     * @return 包；包不存在或无法读取时返回 NULL
+     */
+    static LAppModelPack* Mount(const std::string& directory);
+
+    /**
+     * @brief 解除挂载（与 Mount 成对调用）
+     *
+     * @param[in] pack Mount 返回的包，可为 NULL
+     */
+    static void Unmount(LAppModelPack* pack);
+
+    /**
+     * @brief 在已挂载的包中查找文件
+     *
+     * 找到时包的引用加一，用完后必须以 file->data 调用 Release。
+     *
+     * @param[in]  path    文件路径
+     * @param[out] file    找到的文件
+     * @param[out] covered 路径是否位于某个已挂载的模型目录下
+     * @return 找到时返回 true
+     */
+    static bool Find(const char* path, File* file, bool* covered);
+
+    /**
+     * @brief 已挂载的包中是否有该文件（不取出数据）
+     *
+     * @param[in]  path    文件路径
+     * @param[out] covered 路径是否位于某个已挂载的模型目录下
+     * @return 包中有该文件时返回 true
+     */
+    static bool Contains(const char* path, bool* covered);
+
+    /**
+     * @brief 归还 Find 取出的数据
+     *
+     * @param[in] data 数据的地址（可以指向文件中间）
+     * @return data 不属于任何包时返回 false（不做任何处理）
+     */
+    static bool Release(const Csm::csmByte* data);
+
+private:
+    LAppModelPack();
+    ~LAppModelPack();
+
+    /**
+     * @brief 查找覆盖该路径的包及其中的表项（需持有登记锁）
+     */
+    static const LAppModelPackFormat::Entry* FindLocked(const char* path, LAppModelPack** pack, bool* covered);
+
+    std::string _directory;                             ///< 模型目录（以 '/' 结尾）
+    Csm::csmByte* _data;                                ///< 映射的地址
+    size_t _size;                                       ///< 映射的字节数
+    const LAppModelPackFormat::Header* _header;         ///< 检查过的头部
+    Csm::csmUint32 _mountCount;                         ///< 挂载次数
+    Csm::csmUint32 _references;                         ///< 尚未归还的数据数
+};
@@ -0,0 +1,409 @@
+/**
+ * @file LAppModelPackFormat.cpp
+ */
+#include "LAppModelPackFormat.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Csm;
+
+namespace {
+
+const size_t Lz4MinMatch = 4;           ///< 最短匹配
+const size_t Lz4LastLiterals = 5;       ///< 末尾必须是字面量的字节数
+const size_t Lz4MatchLimit = 12;        ///< 最后一个匹配的起点到末尾至少要留的字节数
+const size_t Lz4MaxOffset = 65535;      ///< 最大回溯距离
+const csmUint32 Lz4HashBits = 14;       ///< 压缩时匹配表的位数
+
+csmUint32 Read32(const csmByte* p)
+{
+    csmUint32 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+csmUint32 HashSequence(csmUint32 sequence)
+{
+    return (sequence * 2654435761U) >> (32 - Lz4HashBits);
+}
+
+/**
+ * @brief 写入 LZ4 的长度扩展字节（15 以上的部分按 255 分段）
+ */
+void WriteLength(std::vector<csmByte>& output, size_t length)
+{
+    while (length >= 255)
+    {
+        output.push_back(255);
+        length -= 255;
+    }
+    output.push_back(static_cast<csmByte>(length));
+}
+
+/**
+ * @brief 读取 LZ4 的长度扩展字节
+ */
+bool ReadLength(const csmByte*& in, const csmByte* inEnd, size_t& length)
+{
+    csmByte value;
+    do
+    {
+        if (in >= inEnd)
+        {
+            return false;
+        }
+        value = *in++;
+        length += value;
+    } while (value == 255);
+    return true;
+}
+
+void WriteSequence(std::vector<csmByte>& output, const csmByte* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+    const size_t matchCode = matchLength - Lz4MinMatch;
+    output.push_back(static_cast<csmByte>(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15)));
+    if (literalLength >= 15)
+    {
+        WriteLength(output, literalLength - 15);
+    }
+    output.insert(output.end(), literals, literals + literalLength);
+    output.push_back(static_cast<csmByte>(offset & 0xFF));
+    output.push_back(static_cast<csmByte>(offset >> 8));
+    if (matchCode >= 15)
+    {
+        WriteLength(output, matchCode - 15);
+    }
+}
+
+}
+
+csmUint64 LAppModelPackFormat::HashPath(const char* path, size_t length)
+{
+    csmUint64 hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(path[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+const LAppModelPackFormat::Header* LAppModelPackFormat::GetHeader(const csmByte* data, size_t size)
+{
+    if (data == NULL || size < sizeof(Header))
+    {
+        return NULL;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(data);
+    if (header->Magic != Magic || header->Version != Version || header->FileSize != size)
+    {
+        return NULL;
+    }
+
+    // 桶数为 2 的幂，各个表都在包的范围内
+    if (header->BucketCount == 0 || (header->BucketCount & (header->BucketCount - 1)) != 0
+        || header->EntryOffset % sizeof(csmUint64) != 0 || header->BucketOffset % sizeof(csmUint32) != 0
+        || header->EntryOffset > size || header->EntryCount > (size - header->EntryOffset) / sizeof(Entry)
+        || header->BucketOffset > size || header->BucketCount > (size - header->BucketOffset) / sizeof(csmUint32)
+        || header->StringOffset > size || header->StringSize > size - header->StringOffset
+        || header->PreloadSize > size)
+    {
+        return NULL;
+    }
+
+    const Entry* entries = reinterpret_cast<const Entry*>(data + header->EntryOffset);
+    for (csmUint32 i = 0; i < header->EntryCount; i++)
+    {
+        const Entry& entry = entries[i];
+        if (entry.DataOffset > size || entry.StoredSize > size - entry.DataOffset
+            || entry.PathOffset > header->StringSize || entry.PathLength > header->StringSize - entry.PathOffset
+            || (entry.Compression == Compression_None && entry.StoredSize != entry.Size)
+            || entry.Compression > Compression_Lz4)
+        {
+            return NULL;
+        }
+    }
+
+    const csmUint32* buckets = reinterpret_cast<const csmUint32*>(data + header->BucketOffset);
+    for (csmUint32 i = 0; i < header->BucketCount; i++)
+    {
+        if (buckets[i] != EmptyBucket && buckets[i] >= header->EntryCount)
+        {
+            return NULL;
+        }
+    }
+
+    return header;
+}
+
+const LAppModelPackFormat::Entry* LAppModelPackFormat::FindEntry(const Header* header, const char* path, size_t length)
+{
+    const csmByte* data = reinterpret_cast<const csmByte*>(header);
+    const Entry* entries = reinterpret_cast<const Entry*>(data + header->EntryOffset);
+    const csmUint32* buckets = reinterpret_cast<const csmUint32*>(data + header->BucketOffset);
+    const char* strings = reinterpret_cast<const char*>(data + header->StringOffset);
+
+    const csmUint64 hash = HashPath(path, length);
+    const csmUint64 mask = header->BucketCount - 1;
+    for (csmUint32 i = buckets[hash & mask]; i < header->EntryCount; i++)
+    {
+        const Entry& entry = entries[i];
+        if ((entry.PathHash & mask) != (hash & mask))
+        {
+            break;
+        }
+        if (entry.PathHash == hash && entry.PathLength == length && memcmp(strings + entry.PathOffset, path, length) == 0)
+        {
+            return &entry;
+        }
+    }
+
+    return NULL;
+}
+
+void LAppModelPackFormat::CompressLz4(const csmByte* source, size_t size, std::vector<csmByte>& output)
+{
+    output.clear();
+    output.reserve(size + size / 255 + 16);
+
+    size_t anchor = 0;
+    if (size > Lz4MatchLimit)
+    {
+        // 贪心匹配：每个位置只看匹配表中最近一次出现的同一 4 字节序列
+        std::vector<csmUint32> table(static_cast<size_t>(1) << Lz4HashBits, 0);
+        const size_t matchEnd = size - Lz4LastLiterals;
+        size_t position = 0;
+        while (position + Lz4MatchLimit <= size)
+        {
+            const csmUint32 sequence = Read32(source + position);
+            const csmUint32 slot = HashSequence(sequence);
+            const size_t candidate = table[slot];
+            table[slot] = static_cast<csmUint32>(position);
+
+            if (candidate >= position || position - candidate > Lz4MaxOffset || Read32(source + candidate) != sequence)
+            {
+                position++;
+                continue;
+            }
+
+            size_t matchLength = Lz4MinMatch;
+            while (position + matchLength < matchEnd && source[candidate + matchLength] == source[position + matchLength])
+            {
+                matchLength++;
+            }
+
+            WriteSequence(output, source + anchor, position - anchor, position - candidate, matchLength);
+            position += matchLength;
+            anchor = position;
+        }
+    }
+
+    // 最后一段只有字面量
+    const size_t literalLength = size - anchor;
+    output.push_back(static_cast<csmByte>((literalLength < 15 ? literalLength : 15) << 4));
+    if (literalLength >= 15)
+    {
+        WriteLength(output, literalLength - 15);
+    }
+    output.insert(output.end(), source + anchor, source + size);
+}
+
+bool LAppModelPackFormat::DecompressLz4(const csmByte* source, size_t sourceSize, csmByte* destination, size_t size)
+{
+    const csmByte* in = source;
+    const csmByte* const inEnd = source + sourceSize;
+    csmByte* out = destination;
+    csmByte* const outEnd = destination + size;
+
+    while (in < inEnd)
+    {
+        const csmByte token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(in, inEnd, literalLength))
+        {
+            return false;
+        }
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out))
+        {
+            return false;
+        }
+        memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        if (in == inEnd)
+        {
+            // 最后一段没有匹配
+            break;
+        }
+
+        if (inEnd - in < 2)
+        {
+            return false;
+        }
+        const size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(out - destination))
+        {
+            return false;
+        }
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !ReadLength(in, inEnd, matchLength))
+        {
+            return false;
+        }
+        matchLength += Lz4MinMatch;
+        if (matchLength > static_cast<size_t>(outEnd - out))
+        {
+            return false;
+        }
+
+        // 距离小于长度时源与目标重叠，必须逐字节复制
+        const csmByte* match = out - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(out, match, matchLength);
+            out += matchLength;
+        }
+        else
+        {
+            for (size_t i = 0; i < matchLength; i++)
+            {
+                *out++ = *match++;
+            }
+        }
+    }
+
+    return out == outEnd;
+}
+
+bool LAppModelPackWriter::AddFile(const std::string& path, const csmByte* data, size_t size, LAppModelPackFormat::Compression compression, bool preload)
+{
+    if (path.empty() || path.size() > 0xFFFF || size > 0xFFFFFFFFu)
+    {
+        return false;
+    }
+
+    const csmUint64 hash = LAppModelPackFormat::HashPath(path.c_str(), path.size());
+    for (size_t i = 0; i < _files.size(); i++)
+    {
+        if (_files[i].hash == hash && _files[i].path == path)
+        {
+            return false;
+        }
+    }
+
+    File file;
+    file.path = path;
+    file.hash = hash;
+    file.size = static_cast<csmUint32>(size);
+    file.compression = LAppModelPackFormat::Compression_None;
+    file.preload = preload;
+
+    if (compression == LAppModelPackFormat::Compression_Lz4 && size > 0)
+    {
+        LAppModelPackFormat::CompressLz4(data, size, file.data);
+        if (file.data.size() <= size - size / 8)
+        {
+            file.compression = LAppModelPackFormat::Compression_Lz4;
+        }
+    }
+
+    if (file.compression == LAppModelPackFormat::Compression_None)
+    {
+        file.data.assign(data, data + size);
+    }
+
+    _files.push_back(file);
+    return true;
+}
+
+void LAppModelPackWriter::Finish(std::vector<csmByte>& output) const
+{
+    typedef LAppModelPackFormat Format;
+
+    Format::Header header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = Format::Magic;
+    header.Version = Format::Version;
+    header.EntryCount = static_cast<csmUint32>(_files.size());
+
+    // 数据：先放需要预读的文件，再放其余文件
+    output.assign(sizeof(Format::Header), 0);
+    std::vector<Format::Entry> entries(_files.size());
+    std::string strings;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const bool preload = (pass == 0);
+        for (size_t i = 0; i < _files.size(); i++)
+        {
+            const File& file = _files[i];
+            if (file.preload != preload)
+            {
+                continue;
+            }
+            output.resize((output.size() + Format::DataAlignment - 1) / Format::DataAlignment * Format::DataAlignment, 0);
+
+            Format::Entry& entry = entries[i];
+            memset(&entry, 0, sizeof(entry));
+            entry.PathHash = file.hash;
+            entry.DataOffset = output.size();
+            entry.StoredSize = static_cast<csmUint32>(file.data.size());
+            entry.Size = file.size;
+            entry.PathOffset = static_cast<csmUint32>(strings.size());
+            entry.PathLength = static_cast<csmUint16>(file.path.size());
+            entry.Compression = file.compression;
+
+            output.insert(output.end(), file.data.begin(), file.data.end());
+            strings += file.path;
+        }
+
+        if (preload)
+        {
+            header.PreloadSize = output.size();
+        }
+    }
+
+    // Entry 表按桶号排列，同一个桶的表项连续
+    csmUint32 bucketCount = 1;
+    while (bucketCount < entries.size())
+    {
+        bucketCount <<= 1;
+    }
+    const csmUint64 mask = bucketCount - 1;
+    std::sort(entries.begin(), entries.end(), [mask](const Format::Entry& a, const Format::Entry& b)
+    {
+        const csmUint64 bucketA = a.PathHash & mask;
+        const csmUint64 bucketB = b.PathHash & mask;
+        return bucketA != bucketB ? bucketA < bucketB : a.DataOffset < b.DataOffset;
+    });
+
+    std::vector<csmUint32> buckets(bucketCount, Format::EmptyBucket);
+    for (size_t i = entries.size(); i-- > 0;)
+    {
+        buckets[entries[i].PathHash & mask] = static_cast<csmUint32>(i);
+    }
+    header.BucketCount = bucketCount;
+
+    output.resize((output.size() + sizeof(csmUint64) - 1) / sizeof(csmUint64) * sizeof(csmUint64), 0);
+    header.EntryOffset = output.size();
+    if (!entries.empty())
+    {
+        const csmByte* begin = reinterpret_cast<const csmByte*>(&entries[0]);
+        output.insert(output.end(), begin, begin + entries.size() * sizeof(Format::Entry));
+    }
+
+    header.BucketOffset = output.size();
+    const csmByte* bucketBegin = reinterpret_cast<const csmByte*>(&buckets[0]);
+    output.insert(output.end(), bucketBegin, bucketBegin + buckets.size() * sizeof(csmUint32));
+
+    header.StringOffset = output.size();
+    header.StringSize = strings.size();
+    output.insert(output.end(), strings.begin(), strings.end());
+
+    header.FileSize = output.size();
+    memcpy(&output[0], &header, sizeof(header));
+}
@@ -0,0 +1,168 @@
+/**
+ * @file LAppModelPackFormat.hpp
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <CubismFramework.hpp>
+
+/**
+ * @brief 模型包（.aipack）的文件格式
+ *
+ * 把一个模型目录下的全部文件（model3.json、moc3、物理、表情、动作、纹理等）
+ * 合成一个文件，应用只需 open 并 mmap 一次即可读取其中任意文件。
+ *
+ * 文件布局（小端）：
+ *   Header（64 字节）
+ *   各文件的数据，起始位置按 64 字节对齐；加载模型时马上读取的文件（JSON、moc3 等）在前，
+ *   纹理、音频等随后才在其他线程读取的文件在后，前一部分的长度记在 PreloadSize
+ *   Entry 表（EntryCount 项，按桶号排序）
+ *   哈希桶（BucketCount 个 csmUint32，存放该桶第一个 Entry 的下标，空桶为 EmptyBucket）
+ *   路径字符串表（以 '/' 分隔的相对路径，不含结尾的 '\0'）
+ *
+ * 桶号取路径哈希的低位，同一个桶的 Entry 在表中连续排列，
+ * 查找时从桶的第一项开始比较哈希与路径，直到桶号变化为止。
+ * 数据可以原样存放，也可以用 LZ4 的 block 格式压缩（解码器随应用一起编译，不依赖外部库）。
+ */
+class LAppModelPackFormat
+{
+public:
+    static const Csm::csmUint32 Magic = 0x4B504941;        ///< 开头 4 字节 "AIPK"
+    static const Csm::csmUint16 Version = 1;                ///< 格式版本，不一致的包不读取
+    static const Csm::csmUint32 DataAlignment = 64;         ///< 文件数据的对齐
+    static const Csm::csmUint32 EmptyBucket = 0xFFFFFFFF;   ///< 空桶
+
+    /**
+     * @brief 数据的存放方式
+     */
+    enum Compression
+    {
+        Compression_None = 0,   ///< 原样存放
+        Compression_Lz4 = 1     ///< LZ4 block 格式
+    };
+
+    /**
+     * @brief 文件头（64 字节）
+     */
+    struct Header
+    {
+        Csm::csmUint32 Magic;           ///< Magic
+        Csm::csmUint16 Version;         ///< Version
+        Csm::csmUint16 Reserved0;       ///< 预留（0）
+        Csm::csmUint32 EntryCount;      ///< 文件数
+        Csm::csmUint32 BucketCount;     ///< 哈希桶数（2 的幂）
+        Csm::csmUint64 FileSize;        ///< 包的总字节数
+        Csm::csmUint64 EntryOffset;     ///< Entry 表的位置
+        Csm::csmUint64 BucketOffset;    ///< 哈希桶的位置
+        Csm::csmUint64 StringOffset;    ///< 路径字符串表的位置
+        Csm::csmUint64 StringSize;      ///< 路径字符串表的字节数
+        Csm::csmUint64 PreloadSize;     ///< 从包开头起需要预读的字节数
+    };
+
+    /**
+     * @brief 文件表项（32 字节）
+     */
+    struct Entry
+    {
+        Csm::csmUint64 PathHash;        ///< 路径的哈希（HashPath）
+        Csm::csmUint64 DataOffset;      ///< 数据的位置（64 字节对齐）
+        Csm::csmUint32 StoredSize;      ///< 包中数据的字节数
+        Csm::csmUint32 Size;            ///< 原文件的字节数
+        Csm::csmUint32 PathOffset;      ///< 路径在字符串表中的位置
+        Csm::csmUint16 PathLength;      ///< 路径的字节数
+        Csm::csmUint16 Compression;     ///< Compression
+    };
+
+    /**
+     * @brief 计算相对路径的哈希（FNV-1a）
+     */
+    static Csm::csmUint64 HashPath(const char* path, size_t length);
+
+    /**
+     * @brief 检查包的头部与各个表的范围
+     *
+     * @param[in] data 包的内容（8 字节对齐）
+     * @param[in] size 包的字节数
+     * @return 合法时返回头部，否则返回 NULL
+     */
+    static const Header* GetHeader(const Csm::csmByte* data, size_t size);
+
+    /**
+     * @brief 按相对路径查找文件
+     *
+     * @param[in] header GetHeader 检查过的头部
+     * @param[in] path   以 '/' 分隔的相对路径
+     * @param[in] length 路径的字节数
+     * @return 找到时返回表项，否则返回 NULL
+     */
+    static const Entry* FindEntry(const Header* header, const char* path, size_t length);
+
+    /**
+     * @brief 以 LZ4 block 格式压缩
+     *
+     * @param[in]  source 原数据
+     * @param[in]  size   原数据的字节数
+     * @param[out] output 压缩后的数据
+     */
+    static void CompressLz4(const Csm::csmByte* source, size_t size, std::vector<Csm::csmByte>& output);
+
+    /**
+     * @brief 解压 LZ4 block 格式的数据
+     *
+     * 会检查输入与输出的边界，损坏的数据不会越界读写。
+     *
+     * @param[in]  source      压缩的数据
+     * @param[in]  sourceSize  压缩数据的字节数
+     * @param[out] destination 输出缓冲区
+     * @param[in]  size        原数据的字节数（输出必须恰好填满）
+     * @return 成功时返回 true
+     */
+    static bool DecompressLz4(const Csm::csmByte* source, size_t sourceSize, Csm::csmByte* destination, size_t size);
+};
+
+/**
+ * @brief 组装模型包
+ *
+ * AddFile 逐个添加文件后，Finish 生成包的内容。
+ * 数据按 preload 分为前后两部分，各部分内保持添加的顺序。
+ */
+class LAppModelPackWriter
+{
+public:
+    /**
+     * @brief 添加文件
+     *
+     * @param[in] path        以 '/' 分隔的相对路径
+     * @param[in] data        文件内容
+     * @param[in] size        文件的字节数
+     * @param[in] compression 存放方式；压缩后没有变小（至少 1/8）时改为原样存放
+     * @param[in] preload     加载模型时是否马上读取（放在包的前部并计入 PreloadSize）
+     * @return 路径重复或文件过大时返回 false
+     */
+    bool AddFile(const std::string& path, const Csm::csmByte* data, size_t size, LAppModelPackFormat::Compression compression, bool preload);
+
+    /**
+     * @brief 生成包的内容
+     *
+     * @param[out] output 包的内容
+     */
+    void Finish(std::vector<Csm::csmByte>& output) const;
+
+private:
+    /**
+     * @brief 添加的文件
+     */
+    struct File
+    {
+        std::string path;                       ///< 相对路径
+        Csm::csmUint64 hash;                    ///< 路径的哈希
+        Csm::csmUint32 size;                    ///< 原文件的字节数
+        Csm::csmUint16 compression;             ///< 存放方式
+        bool preload;                           ///< 是否放在包的前部
+        std::vector<Csm::csmByte> data;         ///< 存放的数据
+    };
+
+    std::vector<File> _files;   ///< 添加的文件
+};
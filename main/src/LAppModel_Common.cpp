@@ -7,25 +7,89 @@
 
 #include "LAppModel_Common.hpp"
 
+#include <sys/stat.h>
+#include <Utils/CubismBinary.hpp>
+
 #include "LAppDefine.hpp"
+#include "LAppLog.hpp"
+#include "LAppModelPack.hpp"
 #include "LAppPal.hpp"
 
+namespace {
+
+/**
+ * @brief 读取 JSON 对应的二进制资源
+ *
+ * 只有 .bin 存在、不比 JSON 旧且版本与当前框架一致时才使用，否则返回 NULL 由调用方读取 JSON。
+ */
+Csm::csmByte* LoadBinaryAsset(const Csm::csmChar* jsonPath, Csm::csmSizeInt* size)
+{
+    const Csm::csmString binaryPath = Csm::Utils::CubismBinary::GetBinaryFileName(jsonPath);
+    if (binaryPath.GetLength() == 0)
+    {
+        return NULL;
+    }
+
+    // 模型包中的 .bin 在生成包时已与 JSON 比较过新旧
+    bool covered = false;
+    if (!LAppModelPack::Contains(binaryPath.GetRawString(), &covered))
+    {
+        if (covered)
+        {
+            return NULL;
+        }
+
+        struct stat binaryStat;
+        if (stat(binaryPath.GetRawString(), &binaryStat) != 0)
+        {
+            return NULL;
+        }
+
+        struct stat jsonStat;
+        if (stat(jsonPath, &jsonStat) == 0 && binaryStat.st_mtime < jsonStat.st_mtime)
+        {
+            LAppPal::PrintLogLn("[APP]binary asset is older than json, ignored: %s", binaryPath.GetRawString());
+            return NULL;
+        }
+    }
+
+    Csm::csmByte* buffer = LAppPal::LoadFileAsBytes(binaryPath.GetRawString(), size);
+    if (buffer == NULL)
+    {
+        return NULL;
+    }
+
+    const Csm::Utils::CubismBinary::Header* header = reinterpret_cast<const Csm::Utils::CubismBinary::Header*>(buffer);
+    if (!Csm::Utils::CubismBinary::IsBinary(buffer, *size) || header->Version != Csm::Utils::CubismBinary::Version)
+    {
+        LAppPal::PrintLogLn("[APP]unsupported binary asset, ignored: %s", binaryPath.GetRawString());
+        LAppPal::ReleaseBytes(buffer);
+        return NULL;
+    }
+
+    return buffer;
+}
+
+}
+
 Csm::csmByte* LAppModel_Common::CreateBuffer(const Csm::csmChar* path, Csm::csmSizeInt* size)
 {
-    if (LAppDefine::DebugLogEnable)
+    LAppLogDebug(Category_Model, "create buffer: %s", path);
+
+    if (LAppDefine::BinaryAssetEnable)
     {
-        // 调试模式下打印创建缓冲区的日志
-        LAppPal::PrintLogLn("[APP]create buffer: %s ", path);
+        Csm::csmByte* buffer = LoadBinaryAsset(path, size);
+        if (buffer != NULL)
+        {
+            return buffer;
+        }
     }
+
     return LAppPal::LoadFileAsBytes(path, size);
 }
 
 void LAppModel_Common::DeleteBuffer(Csm::csmByte* buffer, const Csm::csmChar* path)
 {
-    if (LAppDefine::DebugLogEnable)
-    {
-        // 调试模式下打印删除缓冲区的日志
-        LAppPal::PrintLogLn("[APP]delete buffer: %s", path);
-    }
+    LAppLogDebug(Category_Model, "delete buffer: %s", path);
     LAppPal::ReleaseBytes(buffer);
 }
@@ -9,19 +9,39 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <iostream>
-#include <fstream>
+#include <mutex>
+#include <utility>
+#include <vector>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <Model/CubismMoc.hpp>
 #include "LAppDefine.hpp"
+#include "LAppAllocator_Common.hpp"
+#include "LAppLog.hpp"
+#include "LAppModelPack.hpp"
 
 using std::endl;
 using namespace Csm;
 using namespace std;
 using namespace LAppDefine;
 
+namespace {
+
+const size_t LoadAlignment = 64;    ///< read() 读入的缓冲区的对齐（CubismMoc 要求 64 字节）
+
+// 由 mmap 读取的文件（地址, 大小），ReleaseBytes 据此 munmap。加载可能在多个解码线程中进行
+typedef std::pair<csmByte*, csmSizeInt> MappedFile;
+std::mutex s_mappedFilesMutex;
+std::vector<MappedFile> s_mappedFiles;
+
+}
+
 double LAppPal::s_currentFrame = 0.0;
 double LAppPal::s_lastFrame = 0.0;
 double LAppPal::s_deltaTime = 0.0;
@@ -31,55 +51,206 @@ csmByte* LAppPal::LoadFileAsBytes(const string filePath, csmSizeInt* outSize)
     // 将传入的 std::string 转为 C 字符串路径
     const char* path = filePath.c_str();
 
-    int size = 0;
-    struct stat statBuf;
-    if (stat(path, &statBuf) == 0)
+    // 已挂载模型包的目录下的文件从包中读取，不访问文件系统
+    LAppModelPack::File packedFile;
+    bool covered = false;
+    if (LAppModelPack::Find(path, &packedFile, &covered))
+    {
+        return LoadPackedFile(packedFile, path, outSize);
+    }
+    if (covered)
     {
-        size = statBuf.st_size;
+        if (DebugLogEnable)
+        {
+            // 包中没有该文件
+            PrintLogLn("File not found in model pack. path:%s", path);
+        }
+        return NULL;
+    }
 
-        if (size == 0)
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        if (DebugLogEnable)
         {
-            if (DebugLogEnable)
-            {
-                // stat 成功但文件大小为 0
-                PrintLogLn("Stat succeeded but file size is zero. path:%s", path);
-            }
-            return NULL;
+            // 文件打开失败
+            PrintLogLn("File open failed. errno:%d path:%s", errno, path);
         }
+        return NULL;
     }
-    else
+
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) != 0)
     {
         if (DebugLogEnable)
         {
             // stat 失败，打印错误
             PrintLogLn("Stat failed. errno:%d path:%s", errno, path);
         }
+        close(fd);
         return NULL;
     }
 
-    std::fstream file;
-    file.open(path, std::ios::in | std::ios::binary);
-    if (!file.is_open())
+    const csmSizeInt size = static_cast<csmSizeInt>(statBuf.st_size);
+    if (size == 0)
     {
         if (DebugLogEnable)
         {
-            // 文件打开失败
-            PrintLogLn("File open failed. path:%s", path);
+            // stat 成功但文件大小为 0
+            PrintLogLn("Stat succeeded but file size is zero. path:%s", path);
         }
+        close(fd);
         return NULL;
     }
 
-    char* buf = new char[size];
-    file.read(buf, size);
-    file.close();
+    csmByte* buf = NULL;
+    if (MappedFileLoadEnable && size >= MappedFileMinBytes)
+    {
+        // 映射是按页对齐的；MAP_PRIVATE 写时复制，调用方写入也不会改动文件
+        void* mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            // 调用方会从头到尾读一遍（解析、哈希或拷贝），提前预读
+            madvise(mapped, size, MADV_SEQUENTIAL | MADV_WILLNEED);
+            buf = static_cast<csmByte*>(mapped);
+
+            std::lock_guard<std::mutex> lock(s_mappedFilesMutex);
+            s_mappedFiles.push_back(MappedFile(buf, size));
+        }
+    }
+
+    if (buf == NULL)
+    {
+        buf = ReadFileBytes(fd, size);
+        if (buf == NULL && DebugLogEnable)
+        {
+            // 读取失败（分配失败或读到的字节数不足）
+            PrintLogLn("File read failed. errno:%d path:%s", errno, path);
+        }
+    }
+
+    close(fd);
 
     *outSize = size;
-    return reinterpret_cast<csmByte*>(buf);
+    return buf;
+}
+
+csmByte* LAppPal::LoadPackedFile(const LAppModelPack::File& file, const char* path, csmSizeInt* outSize)
+{
+    if (file.size == 0)
+    {
+        LAppModelPack::Release(file.data);
+        if (DebugLogEnable)
+        {
+            // 包中的文件大小为 0
+            PrintLogLn("Packed file size is zero. path:%s", path);
+        }
+        return NULL;
+    }
+
+    // 原样存放的文件直接返回映射内的地址，ReleaseBytes 时归还包的引用
+    if (file.compression == LAppModelPackFormat::Compression_None)
+    {
+        *outSize = file.size;
+        return const_cast<csmByte*>(file.data);
+    }
+
+    csmByte* buf = AllocateBytes(file.size);
+    const bool decompressed = buf != NULL && LAppModelPackFormat::DecompressLz4(file.data, file.storedSize, buf, file.size);
+    LAppModelPack::Release(file.data);
+
+    if (!decompressed)
+    {
+        ReleaseBytes(buf);
+        if (DebugLogEnable)
+        {
+            // 解压失败（包已损坏）
+            PrintLogLn("Packed file decompression failed. path:%s", path);
+        }
+        return NULL;
+    }
+
+    *outSize = file.size;
+    return buf;
+}
+
+csmByte* LAppPal::AllocateBytes(csmSizeInt size)
+{
+    // 文件内容读取后即被解析并释放，优先放入分配器的临时 arena，反复加载时复用同一块内存
+    LAppAllocator_Common* allocator = LAppAllocator_Common::GetInstance();
+    if (allocator)
+    {
+        return static_cast<csmByte*>(allocator->AllocateTransient(size));
+    }
+
+    void* memory = NULL;
+    if (posix_memalign(&memory, LoadAlignment, size) != 0)
+    {
+        return NULL;
+    }
+    return static_cast<csmByte*>(memory);
+}
+
+csmByte* LAppPal::ReadFileBytes(int fd, csmSizeInt size)
+{
+    csmByte* buf = AllocateBytes(size);
+    if (buf == NULL)
+    {
+        return NULL;
+    }
+
+    csmSizeInt offset = 0;
+    while (offset < size)
+    {
+        const ssize_t count = read(fd, buf + offset, size - offset);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            ReleaseBytes(buf);
+            return NULL;
+        }
+        offset += static_cast<csmSizeInt>(count);
+    }
+
+    return buf;
 }
 
 void LAppPal::ReleaseBytes(csmByte* byteData)
 {
-    delete[] byteData;
+    if (byteData == NULL)
+    {
+        return;
+    }
+
+    if (LAppModelPack::Release(byteData))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_mappedFilesMutex);
+        for (size_t i = 0; i < s_mappedFiles.size(); i++)
+        {
+            if (s_mappedFiles[i].first == byteData)
+            {
+                munmap(byteData, s_mappedFiles[i].second);
+                s_mappedFiles[i] = s_mappedFiles.back();
+                s_mappedFiles.pop_back();
+                return;
+            }
+        }
+    }
+
+    LAppAllocator_Common* allocator = LAppAllocator_Common::GetInstance();
+    if (allocator && allocator->DeallocateTransient(byteData))
+    {
+        return;
+    }
+
+    free(byteData);
 }
 
 csmFloat32  LAppPal::GetDeltaTime()
@@ -96,21 +267,27 @@ void LAppPal::UpdateTime()
 
 void LAppPal::PrintLog(const csmChar* format, ...)
 {
+    if (!LAppLog::IsEnabled(CubismFramework::Option::LogLevel_Info, LAppLog::Category_App))
+    {
+        return;
+    }
+
     va_list args;
-    csmChar buf[256];
     va_start(args, format);
-    vsnprintf(buf, sizeof(buf), format, args); // 使用标准输出打印日志
-    std::cout << buf;
+    LAppLog::PrintV(CubismFramework::Option::LogLevel_Info, LAppLog::Category_App, false, format, args); // 经日志的输出线程打印
     va_end(args);
 }
 
 void LAppPal::PrintLogLn(const csmChar* format, ...)
 {
+    if (!LAppLog::IsEnabled(CubismFramework::Option::LogLevel_Info, LAppLog::Category_App))
+    {
+        return;
+    }
+
     va_list args;
-    csmChar buf[256];
     va_start(args, format);
-    vsnprintf(buf, sizeof(buf), format, args); // 使用标准输出打印日志并换行
-    std::cout << buf << std::endl;
+    LAppLog::PrintV(CubismFramework::Option::LogLevel_Info, LAppLog::Category_App, true, format, args); // 经日志的输出线程打印并换行
     va_end(args);
 }
 
@@ -123,3 +300,36 @@ void LAppPal::PrintMessageLn(const csmChar* message)
 {
     PrintLogLn("%s", message);
 }
+
+string LAppPal::GetCacheDirectory()
+{
+    const char* xdgCache = getenv("XDG_CACHE_HOME");
+    if (xdgCache != NULL && xdgCache[0] != '\0')
+    {
+        return string(xdgCache) + "/AIPet";
+    }
+
+    const char* home = getenv("HOME");
+    if (home != NULL && home[0] != '\0')
+    {
+        return string(home) + "/.cache/AIPet";
+    }
+
+    return string();
+}
+
+bool LAppPal::MakeDirectories(const string& path)
+{
+    for (size_t i = 1; i <= path.size(); i++)
+    {
+        if (i == path.size() || path[i] == '/')
+        {
+            const string sub = path.substr(0, i);
+            if (mkdir(sub.c_str(), 0755) != 0 && errno != EEXIST)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -12,6 +12,8 @@
 #include <cstdlib>
 #include <string>
 
+#include "LAppModelPack.hpp"
+
 /**
  * @brief 抽象化平台相关功能的 Cubism 平台抽象层（Platform Abstraction Layer）。
  *
@@ -24,6 +26,12 @@ public:
     /**
      * @brief 将文件读取为字节数据
      *
+     * 不小于 MappedFileMinBytes 的文件用 mmap 映射（写时复制，调用方写入不会改动文件），
+     * 较小的文件或映射失败时用 read() 读入。返回的地址至少按 64 字节对齐（moc3 的要求）。
+     * 位于已挂载模型包（LAppModelPack）目录下的文件从包中读取，原样存放的文件返回包的映射内的地址，
+     * 不应写入。
+     * 必须用 ReleaseBytes 释放。
+     *
      * @param[in]  filePath  要读取的文件路径
      * @param[out] outSize   输出文件大小
      * @return               读取到的字节数据指针
@@ -50,6 +58,8 @@ public:
     /**
      * @brief 输出日志（不带换行）
      *
+     * 以 Info 级别、App 分类写入 LAppLog，由日志的输出线程打印。
+     *
      * @param[in] format 格式化字符串
      * @param[in] ...    可变参数
      */
@@ -77,7 +87,39 @@ public:
      */
     static void PrintMessageLn(const Csm::csmChar* message);
 
+    /**
+     * @brief 返回本程序的缓存目录
+     *
+     * 设置了 $XDG_CACHE_HOME 时为 $XDG_CACHE_HOME/AIPet，否则为 ~/.cache/AIPet。
+     *
+     * @return 目录的路径（不以 / 结尾），两个环境变量都没有时返回空字符串
+     */
+    static std::string GetCacheDirectory();
+
+    /**
+     * @brief 逐级创建目录（已存在的目录视为成功）
+     *
+     * @param[in] path 要创建的目录
+     * @return 目录全部存在时返回 true
+     */
+    static bool MakeDirectories(const std::string& path);
+
 private:
+    /**
+     * @brief 取出模型包中的文件（压缩的文件解压到新的缓冲区）
+     */
+    static Csm::csmByte* LoadPackedFile(const LAppModelPack::File& file, const char* path, Csm::csmSizeInt* outSize);
+
+    /**
+     * @brief 分配读入文件用的缓冲区（64 字节对齐，用 ReleaseBytes 释放）
+     */
+    static Csm::csmByte* AllocateBytes(Csm::csmSizeInt size);
+
+    /**
+     * @brief 用 read() 读入整个文件（处理部分读取与 EINTR）
+     */
+    static Csm::csmByte* ReadFileBytes(int fd, Csm::csmSizeInt size);
+
     static double s_currentFrame;
     static double s_lastFrame;
     static double s_deltaTime;
@@ -0,0 +1,132 @@
+/**
+ * @file LAppTaskPool.cpp
+ */
+#include "LAppTaskPool.hpp"
+
+#include <algorithm>
+
+#include "LAppDefine.hpp"
+
+namespace {
+
+LAppTaskPool* s_instance = NULL;
+
+}
+
+LAppTaskPool* LAppTaskPool::GetInstance()
+{
+    if (s_instance == NULL)
+    {
+        s_instance = new LAppTaskPool();
+    }
+
+    return s_instance;
+}
+
+void LAppTaskPool::ReleaseInstance()
+{
+    delete s_instance;
+    s_instance = NULL;
+}
+
+LAppTaskPool::LAppTaskPool()
+    : _stopping(false)
+{
+    if (!LAppDefine::ParallelAssetLoadEnable)
+    {
+        return;
+    }
+
+    // 与纹理解码线程相同，保留一个核心给渲染线程（等待中的渲染线程也会执行任务）
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    const unsigned int threadCount = std::max(1u, std::min(4u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u));
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        _threads.push_back(std::thread(&LAppTaskPool::WorkerThreadMain, this));
+    }
+}
+
+LAppTaskPool::~LAppTaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _taskCondition.notify_all();
+
+    for (size_t i = 0; i < _threads.size(); i++)
+    {
+        _threads[i].join();
+    }
+}
+
+void LAppTaskPool::Submit(Group* group, const std::function<void()>& task)
+{
+    Task entry;
+    entry.group = group;
+    entry.function = task;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        group->_pending++;
+        _tasks.push_back(entry);
+    }
+    _taskCondition.notify_one();
+}
+
+void LAppTaskPool::Wait(Group* group)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (group->_pending > 0)
+    {
+        // 该组还有未开始的任务时自己执行，否则等待工作线程中执行的任务结束
+        if (!RunTask(lock, group))
+        {
+            _doneCondition.wait(lock);
+        }
+    }
+}
+
+void LAppTaskPool::WorkerThreadMain()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;)
+    {
+        _taskCondition.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+        if (_tasks.empty())
+        {
+            return;
+        }
+
+        RunTask(lock, NULL);
+    }
+}
+
+bool LAppTaskPool::RunTask(std::unique_lock<std::mutex>& lock, Group* group)
+{
+    std::deque<Task>::iterator it = _tasks.begin();
+    while (it != _tasks.end() && group != NULL && it->group != group)
+    {
+        ++it;
+    }
+    if (it == _tasks.end())
+    {
+        return false;
+    }
+
+    Task task;
+    task.group = it->group;
+    task.function.swap(it->function);
+    _tasks.erase(it);
+
+    lock.unlock();
+    task.function();
+    lock.lock();
+
+    task.group->_pending--;
+    if (task.group->_pending == 0)
+    {
+        _doneCondition.notify_all();
+    }
+    return true;
+}
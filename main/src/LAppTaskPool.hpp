@@ -0,0 +1,96 @@
+/**
+ * @file LAppTaskPool.hpp
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <CubismFramework.hpp>
+
+/**
+ * @brief 模型加载用的工作线程池
+ *
+ * 文件读取、JSON 解析等互不依赖的加载工作按组提交，OpenGL 线程只在需要结果时等待对应的组。
+ * 任务按提交顺序开始执行；任务把结果写入调用方准备的槽位，等待结束后由调用方按固定顺序取出，
+ * 因此加载结果与线程数、执行顺序无关。
+ * LAppDefine::ParallelAssetLoadEnable 为 false 时不创建线程，所有任务在 Wait 中按提交顺序执行。
+ */
+class LAppTaskPool
+{
+public:
+    /**
+     * @brief 一组任务的完成计数（Wait 返回后才能销毁）
+     */
+    class Group
+    {
+    public:
+        Group() : _pending(0) {}
+
+    private:
+        friend class LAppTaskPool;
+
+        Csm::csmUint32 _pending;    ///< 尚未完成的任务数（由池的锁保护）
+    };
+
+    /**
+     * @brief 返回实例，首次调用时创建线程
+     */
+    static LAppTaskPool* GetInstance();
+
+    /**
+     * @brief 释放实例（等待执行中的任务结束）
+     */
+    static void ReleaseInstance();
+
+    /**
+     * @brief 提交任务
+     *
+     * @param[in] group 任务所属的组
+     * @param[in] task  在工作线程（或 Wait 的调用线程）中执行的处理
+     */
+    void Submit(Group* group, const std::function<void()>& task);
+
+    /**
+     * @brief 等待组中的任务全部完成
+     *
+     * 等待期间调用线程也执行该组中尚未开始的任务。
+     */
+    void Wait(Group* group);
+
+private:
+    /**
+     * @brief 任务
+     */
+    struct Task
+    {
+        Group* group;                       ///< 所属的组
+        std::function<void()> function;     ///< 处理
+    };
+
+    LAppTaskPool();
+    ~LAppTaskPool();
+
+    /**
+     * @brief 工作线程主循环
+     */
+    void WorkerThreadMain();
+
+    /**
+     * @brief 取出队列中最早的任务（group 为 NULL 时不限组）并在解锁状态下执行
+     *
+     * @return 没有可执行的任务时返回 false
+     */
+    bool RunTask(std::unique_lock<std::mutex>& lock, Group* group);
+
+    std::vector<std::thread> _threads;              ///< 工作线程
+    std::mutex _mutex;                              ///< 保护下面的状态与各组的计数
+    std::condition_variable _taskCondition;         ///< 通知工作线程有新任务或退出
+    std::condition_variable _doneCondition;         ///< 通知等待方有任务完成
+    std::deque<Task> _tasks;                        ///< 尚未开始的任务
+    bool _stopping;                                 ///< 工作线程退出标志
+};
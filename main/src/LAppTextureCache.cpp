@@ -0,0 +1,513 @@
+/**
+ * @file LAppTextureCache.cpp
+ * 这个文件实现了解码后纹理的磁盘缓存（可 mmap 的 RGBA8 容器格式）。
+ */
+#include "LAppTextureCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LAppDefine.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+namespace {
+
+    const char CacheMagic[8] = { 'A', 'I', 'P', 'T', 'E', 'X', '\0', '\0' };
+    const csmUint32 CacheVersion = 1;
+    const csmUint32 CacheFlagPremultiplied = 1u << 0;
+    const size_t CacheDataAlignment = 64;
+
+    // 临时文件名的序号，避免多个解码线程互相覆盖
+    std::atomic<unsigned int> s_temporarySerial(0);
+
+    // 正在清理缓存目录（多个解码线程同时写入时只由一个线程清理）
+    std::atomic<bool> s_pruning(false);
+
+    // 超过该时间的临时文件视为写入中途退出的残留
+    const time_t TemporaryFileMaxAgeSeconds = 60 * 60;
+
+    bool HasSuffix(const char* name, const char* suffix)
+    {
+        const size_t nameLength = strlen(name);
+        const size_t suffixLength = strlen(suffix);
+        return nameLength >= suffixLength && strcmp(name + nameLength - suffixLength, suffix) == 0;
+    }
+
+    // 文件头，固定 64 字节
+    struct CacheHeader
+    {
+        char magic[8];
+        csmUint32 version;
+        csmUint32 flags;
+        csmUint64 sourceHash;
+        csmUint64 sourceSize;
+        csmInt32 width;
+        csmInt32 height;
+        csmUint32 levelCount;
+        csmUint32 reserved;
+        csmUint64 dataOffset;
+        csmUint64 dataSize;
+    };
+
+    // 层级表项，紧跟在文件头之后
+    struct CacheLevel
+    {
+        csmUint64 offset;   ///< 相对文件开头的偏移
+        csmInt32 width;
+        csmInt32 height;
+    };
+
+    static_assert(sizeof(CacheHeader) == 64, "CacheHeader must stay 64 bytes");
+    static_assert(sizeof(CacheLevel) == 16, "CacheLevel must stay 16 bytes");
+
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool WriteAll(int fd, const void* data, size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        while (size > 0)
+        {
+            const ssize_t written = write(fd, p, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            p += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+}
+
+void LAppTextureCache::ClearImage(Image* image)
+{
+    memset(image, 0, sizeof(Image));
+}
+
+void LAppTextureCache::ReleaseImage(Image* image)
+{
+    if (image->mapped != NULL)
+    {
+        munmap(image->mapped, image->mappedSize);
+    }
+    if (image->decoded != NULL)
+    {
+        // stb_image 默认使用 malloc 分配，与 stbi_image_free 等价
+        free(image->decoded);
+    }
+    if (image->mipChain != NULL)
+    {
+        free(image->mipChain);
+    }
+    ClearImage(image);
+}
+
+size_t LAppTextureCache::GetImageBytes(const Image& image)
+{
+    size_t total = 0;
+    for (csmUint32 i = 0; i < image.levelCount; i++)
+    {
+        total += static_cast<size_t>(image.levelWidth[i]) * static_cast<size_t>(image.levelHeight[i]) * 4;
+    }
+    return total;
+}
+
+void LAppTextureCache::CopyImageBytes(const Image& image, size_t offset, size_t count, unsigned char* destination)
+{
+    size_t levelStart = 0;
+    for (csmUint32 i = 0; i < image.levelCount && count > 0; i++)
+    {
+        const size_t levelBytes = static_cast<size_t>(image.levelWidth[i]) * static_cast<size_t>(image.levelHeight[i]) * 4;
+        const size_t levelEnd = levelStart + levelBytes;
+
+        if (offset < levelEnd)
+        {
+            const size_t begin = offset - levelStart;
+            const size_t copyBytes = (levelBytes - begin < count) ? levelBytes - begin : count;
+            memcpy(destination, image.levels[i] + begin, copyBytes);
+            destination += copyBytes;
+            offset += copyBytes;
+            count -= copyBytes;
+        }
+
+        levelStart = levelEnd;
+    }
+}
+
+csmUint64 LAppTextureCache::HashBytes(const unsigned char* data, size_t size)
+{
+    // 以 8 字节为单位的 FNV-1a 变体，末尾不足 8 字节的部分逐字节处理
+    const csmUint64 prime = 0x100000001b3ULL;
+    csmUint64 hash = 0xcbf29ce484222325ULL ^ static_cast<csmUint64>(size);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        csmUint64 word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * prime;
+    }
+
+    return hash;
+}
+
+std::string LAppTextureCache::GetCacheDirectory()
+{
+    const std::string directory = LAppPal::GetCacheDirectory();
+    if (directory.empty())
+    {
+        return std::string();
+    }
+
+    return directory + "/textures";
+}
+
+std::string LAppTextureCache::GetCacheFilePath(csmUint64 sourceHash)
+{
+    const std::string directory = GetCacheDirectory();
+    if (directory.empty())
+    {
+        return std::string();
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.tex", static_cast<unsigned long long>(sourceHash));
+    return directory + name;
+}
+
+bool LAppTextureCache::Load(csmUint64 sourceHash, size_t sourceSize, int sourceWidth, int sourceHeight, bool premultipliedAlpha, Image* image)
+{
+    ClearImage(image);
+
+    const std::string path = GetCacheFilePath(sourceHash);
+    if (path.empty())
+    {
+        return false;
+    }
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) != 0 || statBuf.st_size < static_cast<off_t>(sizeof(CacheHeader)))
+    {
+        close(fd);
+        return false;
+    }
+
+    // 更新修改时间，Prune 按它判断最近使用的缓存
+    futimens(fd, NULL);
+
+    const size_t fileSize = static_cast<size_t>(statBuf.st_size);
+    void* mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        return false;
+    }
+
+    const unsigned char* base = static_cast<const unsigned char*>(mapped);
+    const CacheHeader* header = reinterpret_cast<const CacheHeader*>(base);
+    const csmUint32 expectedFlags = premultipliedAlpha ? CacheFlagPremultiplied : 0;
+
+    // 范围检查都写成减法形式，损坏的文件中很大的偏移量不会因加法回绕而通过检查
+    bool valid = memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) == 0
+        && header->version == CacheVersion
+        && header->flags == expectedFlags
+        && header->sourceHash == sourceHash
+        && header->sourceSize == sourceSize
+        && sourceWidth > 0 && sourceHeight > 0
+        && header->width == sourceWidth && header->height == sourceHeight
+        && header->levelCount >= 1 && header->levelCount <= LevelMax
+        && header->levelCount * sizeof(CacheLevel) <= fileSize - sizeof(CacheHeader)
+        && header->dataOffset <= fileSize
+        && header->dataSize <= fileSize - header->dataOffset;
+
+    if (valid)
+    {
+        // 第 0 层与 PNG 的尺寸一致，之后每层减半（与 BuildMipChain 相同）
+        const CacheLevel* levels = reinterpret_cast<const CacheLevel*>(base + sizeof(CacheHeader));
+        const csmUint64 dataEnd = header->dataOffset + header->dataSize;
+        int expectedWidth = sourceWidth;
+        int expectedHeight = sourceHeight;
+        for (csmUint32 i = 0; i < header->levelCount && valid; i++)
+        {
+            const csmUint64 levelBytes = static_cast<csmUint64>(expectedWidth) * static_cast<csmUint64>(expectedHeight) * 4;
+            valid = levels[i].width == expectedWidth && levels[i].height == expectedHeight
+                && levels[i].offset >= header->dataOffset
+                && levels[i].offset <= dataEnd
+                && levelBytes <= dataEnd - levels[i].offset;
+
+            image->levelWidth[i] = levels[i].width;
+            image->levelHeight[i] = levels[i].height;
+            image->levels[i] = base + levels[i].offset;
+
+            expectedWidth = expectedWidth > 1 ? expectedWidth / 2 : 1;
+            expectedHeight = expectedHeight > 1 ? expectedHeight / 2 : 1;
+        }
+    }
+
+    if (!valid)
+    {
+        munmap(mapped, fileSize);
+        ClearImage(image);
+        return false;
+    }
+
+    // 接下来会按顺序整段拷贝到 PBO
+    madvise(mapped, fileSize, MADV_SEQUENTIAL | MADV_WILLNEED);
+
+    image->width = header->width;
+    image->height = header->height;
+    image->premultipliedAlpha = premultipliedAlpha;
+    image->levelCount = header->levelCount;
+    image->mapped = mapped;
+    image->mappedSize = fileSize;
+
+    return true;
+}
+
+void LAppTextureCache::BuildMipChain(Image* image)
+{
+    int width = image->levelWidth[0];
+    int height = image->levelHeight[0];
+
+    // 先计算层数与总字节数
+    size_t chainBytes = 0;
+    csmUint32 levelCount = 1;
+    while ((width > 1 || height > 1) && levelCount < LevelMax)
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        chainBytes += static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+        levelCount++;
+    }
+
+    if (levelCount == 1)
+    {
+        return;
+    }
+
+    image->mipChain = static_cast<unsigned char*>(malloc(chainBytes));
+    if (image->mipChain == NULL)
+    {
+        return;
+    }
+
+    unsigned char* destination = image->mipChain;
+    for (csmUint32 level = 1; level < levelCount; level++)
+    {
+        const int srcWidth = image->levelWidth[level - 1];
+        const int srcHeight = image->levelHeight[level - 1];
+        const int dstWidth = srcWidth > 1 ? srcWidth / 2 : 1;
+        const int dstHeight = srcHeight > 1 ? srcHeight / 2 : 1;
+        const unsigned char* source = image->levels[level - 1];
+
+        for (int y = 0; y < dstHeight; y++)
+        {
+            const int y0 = (y * 2 < srcHeight) ? y * 2 : srcHeight - 1;
+            const int y1 = (y * 2 + 1 < srcHeight) ? y * 2 + 1 : srcHeight - 1;
+            for (int x = 0; x < dstWidth; x++)
+            {
+                const int x0 = (x * 2 < srcWidth) ? x * 2 : srcWidth - 1;
+                const int x1 = (x * 2 + 1 < srcWidth) ? x * 2 + 1 : srcWidth - 1;
+                const unsigned char* p00 = source + (static_cast<size_t>(y0) * srcWidth + x0) * 4;
+                const unsigned char* p01 = source + (static_cast<size_t>(y0) * srcWidth + x1) * 4;
+                const unsigned char* p10 = source + (static_cast<size_t>(y1) * srcWidth + x0) * 4;
+                const unsigned char* p11 = source + (static_cast<size_t>(y1) * srcWidth + x1) * 4;
+                unsigned char* out = destination + (static_cast<size_t>(y) * dstWidth + x) * 4;
+                for (int c = 0; c < 4; c++)
+                {
+                    out[c] = static_cast<unsigned char>((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+                }
+            }
+        }
+
+        image->levelWidth[level] = dstWidth;
+        image->levelHeight[level] = dstHeight;
+        image->levels[level] = destination;
+        destination += static_cast<size_t>(dstWidth) * static_cast<size_t>(dstHeight) * 4;
+    }
+
+    image->levelCount = levelCount;
+}
+
+bool LAppTextureCache::Store(csmUint64 sourceHash, size_t sourceSize, const Image& image)
+{
+    const std::string directory = GetCacheDirectory();
+    if (directory.empty() || !LAppPal::MakeDirectories(directory))
+    {
+        return false;
+    }
+
+    const std::string path = GetCacheFilePath(sourceHash);
+
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = CacheVersion;
+    header.flags = image.premultipliedAlpha ? CacheFlagPremultiplied : 0;
+    header.sourceHash = sourceHash;
+    header.sourceSize = sourceSize;
+    header.width = image.width;
+    header.height = image.height;
+    header.levelCount = image.levelCount;
+    header.dataOffset = AlignUp(sizeof(CacheHeader) + image.levelCount * sizeof(CacheLevel), CacheDataAlignment);
+    header.dataSize = GetImageBytes(image);
+
+    CacheLevel levels[LevelMax];
+    csmUint64 offset = header.dataOffset;
+    for (csmUint32 i = 0; i < image.levelCount; i++)
+    {
+        levels[i].offset = offset;
+        levels[i].width = image.levelWidth[i];
+        levels[i].height = image.levelHeight[i];
+        offset += static_cast<csmUint64>(image.levelWidth[i]) * static_cast<csmUint64>(image.levelHeight[i]) * 4;
+    }
+
+    // 写入临时文件后改名，避免其他进程读到写了一半的缓存
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%d.%u.tmp", static_cast<int>(getpid()), s_temporarySerial.fetch_add(1));
+    const std::string temporaryPath = path + suffix;
+
+    const int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    static const unsigned char padding[CacheDataAlignment] = { 0 };
+    const size_t paddingBytes = header.dataOffset - sizeof(CacheHeader) - image.levelCount * sizeof(CacheLevel);
+
+    bool ok = WriteAll(fd, &header, sizeof(header))
+        && WriteAll(fd, levels, image.levelCount * sizeof(CacheLevel))
+        && WriteAll(fd, padding, paddingBytes);
+    for (csmUint32 i = 0; i < image.levelCount && ok; i++)
+    {
+        ok = WriteAll(fd, image.levels[i], static_cast<size_t>(image.levelWidth[i]) * static_cast<size_t>(image.levelHeight[i]) * 4);
+    }
+    ok = (close(fd) == 0) && ok;
+
+    if (!ok || rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        unlink(temporaryPath.c_str());
+        if (LAppDefine::DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]texture cache write failed: %s", path.c_str());
+        }
+        return false;
+    }
+
+    Prune();
+    return true;
+}
+
+void LAppTextureCache::Prune()
+{
+    if (s_pruning.exchange(true))
+    {
+        return;
+    }
+
+    const std::string directory = GetCacheDirectory();
+    DIR* dir = directory.empty() ? NULL : opendir(directory.c_str());
+    if (dir == NULL)
+    {
+        s_pruning = false;
+        return;
+    }
+
+    struct CacheFile
+    {
+        std::string path;
+        time_t modifiedTime;
+        csmUint64 bytes;
+    };
+
+    std::vector<CacheFile> files;
+    csmUint64 totalBytes = 0;
+    const time_t now = time(NULL);
+    for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir))
+    {
+        const bool temporary = HasSuffix(entry->d_name, ".tmp");
+        if (!temporary && !HasSuffix(entry->d_name, ".tex"))
+        {
+            continue;
+        }
+
+        const std::string path = directory + "/" + entry->d_name;
+        struct stat statBuf;
+        if (stat(path.c_str(), &statBuf) != 0)
+        {
+            continue;
+        }
+
+        if (temporary)
+        {
+            if (now - statBuf.st_mtime > TemporaryFileMaxAgeSeconds)
+            {
+                unlink(path.c_str());
+            }
+            continue;
+        }
+
+        CacheFile file;
+        file.path = path;
+        file.modifiedTime = statBuf.st_mtime;
+        file.bytes = static_cast<csmUint64>(statBuf.st_size);
+        files.push_back(file);
+        totalBytes += file.bytes;
+    }
+    closedir(dir);
+
+    // 超出预算时从最久未使用的开始删除（命中时 Load 会更新修改时间）
+    if (totalBytes > LAppDefine::TextureCacheMaxBytes)
+    {
+        std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) { return a.modifiedTime < b.modifiedTime; });
+
+        size_t removedCount = 0;
+        for (size_t i = 0; i < files.size() && totalBytes > LAppDefine::TextureCacheMaxBytes; i++)
+        {
+            if (unlink(files[i].path.c_str()) == 0)
+            {
+                totalBytes -= files[i].bytes;
+                removedCount++;
+            }
+        }
+
+        if (LAppDefine::DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]texture cache pruned %zu files, %llu MB left", removedCount, static_cast<unsigned long long>(totalBytes / (1024 * 1024)));
+        }
+    }
+
+    s_pruning = false;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file LAppTextureCache.hpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <CubismFramework.hpp>
+
+/**
+ * @brief 解码后纹理的磁盘缓存
+ *
+ * 以 PNG 文件内容的哈希为键，把解码（及预乘、mipmap）后的 RGBA8 数据
+ * 存成可直接 mmap 的文件，再次启动时跳过 PNG 解压。
+ * PNG 内容变化后哈希随之变化，旧缓存自然失效。
+ *
+ * 文件格式（小端）：64 字节文件头，随后是 levelCount 个层级表项，
+ * 像素数据从 64 字节对齐的位置开始，各层级依次紧密排列。
+ */
+class LAppTextureCache
+{
+public:
+    static const Csm::csmUint32 LevelMax = 16;     ///< 支持的最大 mipmap 层数（32768x32768）
+
+    /**
+     * @brief 纹理的像素数据（可能来自 mmap 的缓存文件，也可能是刚解码的数据）
+     */
+    struct Image
+    {
+        int width;                                  ///< 第 0 层宽度
+        int height;                                 ///< 第 0 层高度
+        bool premultipliedAlpha;                    ///< 是否已预乘 alpha
+        Csm::csmUint32 levelCount;                  ///< 层数，为 1 时由 GPU 生成 mipmap
+        int levelWidth[LevelMax];                   ///< 各层宽度
+        int levelHeight[LevelMax];                  ///< 各层高度
+        const unsigned char* levels[LevelMax];      ///< 各层像素
+        void* mapped;                               ///< 缓存命中时的映射地址
+        size_t mappedSize;                          ///< 映射长度
+        unsigned char* decoded;                     ///< 缓存未命中时 stb_image 解码出的第 0 层
+        unsigned char* mipChain;                    ///< 缓存未命中时在 CPU 上生成的第 1 层以后
+    };
+
+    /**
+     * @brief 把 Image 置为空
+     */
+    static void ClearImage(Image* image);
+
+    /**
+     * @brief 释放 Image 持有的映射或内存
+     */
+    static void ReleaseImage(Image* image);
+
+    /**
+     * @brief 所有层级的字节数之和
+     */
+    static size_t GetImageBytes(const Image& image);
+
+    /**
+     * @brief 把各层像素视为一段连续数据，从 offset 开始拷贝 count 字节
+     */
+    static void CopyImageBytes(const Image& image, size_t offset, size_t count, unsigned char* destination);
+
+    /**
+     * @brief 计算 PNG 文件内容的哈希
+     */
+    static Csm::csmUint64 HashBytes(const unsigned char* data, size_t size);
+
+    /**
+     * @brief 查找并映射缓存文件
+     *
+     * 文件头与各层的尺寸、偏移都与 PNG 对照检查，损坏或截断的文件按未命中处理。
+     *
+     * @param[in]  sourceHash          PNG 内容的哈希
+     * @param[in]  sourceSize          PNG 文件大小
+     * @param[in]  sourceWidth         PNG 的宽度
+     * @param[in]  sourceHeight        PNG 的高度
+     * @param[in]  premultipliedAlpha  需要的预乘状态
+     * @param[out] image               命中时填充
+     * @return 命中返回 true
+     */
+    static bool Load(Csm::csmUint64 sourceHash, size_t sourceSize, int sourceWidth, int sourceHeight, bool premultipliedAlpha, Image* image);
+
+    /**
+     * @brief 在 CPU 上生成完整的 mipmap 链（2x2 盒式滤波）
+     *
+     * image 的第 0 层需已就绪，生成结果存放在 image->mipChain 中。
+     */
+    static void BuildMipChain(Image* image);
+
+    /**
+     * @brief 写入缓存文件（先写临时文件再改名，可在任意线程调用）
+     *
+     * @return 写入成功返回 true
+     */
+    static bool Store(Csm::csmUint64 sourceHash, size_t sourceSize, const Image& image);
+
+    /**
+     * @brief 缓存目录超过 LAppDefine::TextureCacheMaxBytes 时删除最久未使用的文件，并删除残留的临时文件
+     *
+     * 每次写入后由 Store 调用。
+     */
+    static void Prune();
+
+private:
+    /**
+     * @brief 缓存目录（$XDG_CACHE_HOME/AIPet/textures 或 ~/.cache/AIPet/textures）
+     */
+    static std::string GetCacheDirectory();
+
+    /**
+     * @brief 缓存文件路径
+     */
+    static std::string GetCacheFilePath(Csm::csmUint64 sourceHash);
+};
@@ -3,6 +3,8 @@
  * 这个文件实现了纹理管理器，负责从 PNG 文件加载纹理并管理其生命周期。
  */
 #include "LAppTextureManager.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #define STBI_NO_STDIO
 #define STBI_ONLY_PNG
@@ -16,118 +18,610 @@
 #pragma clang diagnostic pop
 #endif
 #include "LAppPal.hpp"
+#include "LAppDefine.hpp"
 
-LAppTextureManager::LAppTextureManager() : LAppTextureManager_Common()
-{
+namespace {
+    LAppTextureManager* instance = NULL;
 }
 
-LAppTextureManager::~LAppTextureManager()
+LAppTextureManager* LAppTextureManager::GetInstance()
 {
-    ReleaseTextures();
+    if (!instance)
+    {
+        instance = new LAppTextureManager();
+    }
+
+    return instance;
 }
 
-LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromPngFile(std::string fileName)
+void LAppTextureManager::ReleaseInstance()
 {
-    // 检查是否已加载该纹理（按文件名查找）
-    for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
+    if (instance)
     {
-        if (_texturesInfo[i]->fileName == fileName)
-        {
-            return _texturesInfo[i];
-        }
+        delete instance;
     }
 
-    GLuint textureId;
-    int width, height, channels;
+    instance = NULL;
+}
+
+LAppTextureManager::LAppTextureManager()
+    : LAppTextureManager_Common()
+    , _decodeStopping(false)
+    , _textureBytes(0)
+{
+}
+
+LAppTextureManager::~LAppTextureManager()
+{
+    StopDecodeThreads();
+    ReleaseTextures();
+}
+
+bool LAppTextureManager::LoadImageFile(const std::string& fileName, LAppTextureCache::Image* image)
+{
+    int channels;
     unsigned int size;
-    unsigned char* png;
     unsigned char* address;
 
+    LAppTextureCache::ClearImage(image);
+
+    const double loadStart = glfwGetTime();
     address = LAppPal::LoadFileAsBytes(fileName, &size);
+    if (address == NULL)
+    {
+        return false;
+    }
+
+    // 按 PNG 内容查找已解码的缓存，命中时跳过解压
+    Csm::csmUint64 sourceHash = 0;
+    if (LAppDefine::TextureCacheEnable)
+    {
+        // 只读取 PNG 头中的尺寸，用于校验缓存
+        int sourceWidth = 0;
+        int sourceHeight = 0;
+        sourceHash = LAppTextureCache::HashBytes(address, size);
+        if (stbi_info_from_memory(address, static_cast<int>(size), &sourceWidth, &sourceHeight, &channels)
+            && LAppTextureCache::Load(sourceHash, size, sourceWidth, sourceHeight, LAppDefine::PremultipliedAlphaEnable, image))
+        {
+            LAppPal::ReleaseBytes(address);
+            if (LAppDefine::DebugLogEnable)
+            {
+                LAppPal::PrintLogLn("[APP]texture cache hit: %s %.2f ms", fileName.c_str(), (glfwGetTime() - loadStart) * 1000.0);
+            }
+            return true;
+        }
+    }
 
     // 从内存中加载 PNG 数据
-    png = stbi_load_from_memory(
+    image->decoded = stbi_load_from_memory(
         address,
         static_cast<int>(size),
-        &width,
-        &height,
+        &image->width,
+        &image->height,
         &channels,
         STBI_rgb_alpha);
+
+    if (image->decoded == NULL)
     {
+        LAppPal::ReleaseBytes(address);
+        if (LAppDefine::DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]png decode failed: %s", fileName.c_str());
+        }
+        return false;
+    }
+
+    image->levelCount = 1;
+    image->levelWidth[0] = image->width;
+    image->levelHeight[0] = image->height;
+    image->levels[0] = image->decoded;
 
-#ifdef PREMULTIPLIED_ALPHA_ENABLE
-        unsigned int* fourBytes = reinterpret_cast<unsigned int*>(png);
-        for (int i = 0; i < width * height; i++)
+    // 预乘 alpha（向量化实现，结果与逐像素 Premultiply 相同）
+    if (LAppDefine::PremultipliedAlphaEnable)
+    {
+        const double premultiplyStart = glfwGetTime();
+        PremultiplyPixels(image->decoded, static_cast<size_t>(image->width) * static_cast<size_t>(image->height));
+        image->premultipliedAlpha = true;
+        if (LAppDefine::DebugLogEnable)
         {
-            unsigned char* p = png + i * 4;
-            fourBytes[i] = Premultiply(p[0], p[1], p[2], p[3]);
+            LAppPal::PrintLogLn("[APP]premultiply %dx%d: %.2f ms", image->width, image->height, (glfwGetTime() - premultiplyStart) * 1000.0);
         }
-#endif
     }
 
-    // 为 OpenGL 创建纹理
-    glGenTextures(1, &textureId);
+    if (LAppDefine::TextureCacheEnable)
+    {
+        if (LAppDefine::TextureCacheMipmapEnable)
+        {
+            LAppTextureCache::BuildMipChain(image);
+        }
+        LAppTextureCache::Store(sourceHash, size, *image);
+    }
+
+    LAppPal::ReleaseBytes(address);
+
+    if (LAppDefine::DebugLogEnable)
+    {
+        LAppPal::PrintLogLn("[APP]texture decoded: %s %.2f ms", fileName.c_str(), (glfwGetTime() - loadStart) * 1000.0);
+    }
+
+    return true;
+}
+
+void LAppTextureManager::UploadTexture(GLuint textureId, const LAppTextureCache::Image& image, bool fromPixelBuffer)
+{
     glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, png);
-    glGenerateMipmap(GL_TEXTURE_2D);
+
+    // 从 PBO 上传时各层按顺序紧密排列，参数为 PBO 内的偏移
+    size_t offset = 0;
+    for (Csm::csmUint32 level = 0; level < image.levelCount; level++)
+    {
+        const void* pixels = fromPixelBuffer ? reinterpret_cast<const void*>(offset) : image.levels[level];
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, image.levelWidth[level], image.levelHeight[level], 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        offset += static_cast<size_t>(image.levelWidth[level]) * static_cast<size_t>(image.levelHeight[level]) * 4;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.levelCount > 1 ? static_cast<GLint>(image.levelCount - 1) : 1000);
+    if (image.levelCount == 1)
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-    // 释放资源
-    stbi_image_free(png);
-    LAppPal::ReleaseBytes(address);
+LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromPngFile(std::string fileName)
+{
+    // 已加载（或正在加载）的纹理直接共用
+    TextureInfo* loaded = GetTextureInfoByName(fileName);
+    if (loaded != NULL)
+    {
+        loaded->refCount++;
+        return loaded;
+    }
+
+    LAppTextureCache::Image image;
+    if (!LoadImageFile(fileName, &image))
+    {
+        return NULL;
+    }
+
+    // 为 OpenGL 创建纹理
+    GLuint textureId;
+    glGenTextures(1, &textureId);
+    UploadTexture(textureId, image, false);
 
     LAppTextureManager::TextureInfo* textureInfo = new LAppTextureManager::TextureInfo();
-    if (textureInfo != NULL)
+    textureInfo->fileName = fileName;
+    textureInfo->width = image.width;
+    textureInfo->height = image.height;
+    textureInfo->id = textureId;
+    textureInfo->premultipliedAlpha = image.premultipliedAlpha;
+    textureInfo->ready = true;
+    textureInfo->failed = false;
+    textureInfo->refCount = 1;
+    RegisterTexture(textureInfo);
+    SetTextureBytes(textureInfo, EstimateTextureBytes(image.width, image.height, true));
+
+    // 释放资源
+    LAppTextureCache::ReleaseImage(&image);
+
+    return textureInfo;
+}
+
+LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromPngFileAsync(std::string fileName)
+{
+    // 已加载（或正在加载）的纹理直接共用
+    TextureInfo* loaded = GetTextureInfoByName(fileName);
+    if (loaded != NULL)
     {
-        textureInfo->fileName = fileName;
-        textureInfo->width = width;
-        textureInfo->height = height;
-        textureInfo->id = textureId;
+        loaded->refCount++;
+        return loaded;
+    }
+
+    // 先放入 1x1 透明占位图，保证纹理在解码完成前也可以绑定和绘制
+    static const unsigned char placeholder[4] = { 0, 0, 0, 0 };
 
-        _texturesInfo.PushBack(textureInfo);
+    GLuint textureId;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    LAppTextureManager::TextureInfo* textureInfo = new LAppTextureManager::TextureInfo();
+    textureInfo->fileName = fileName;
+    textureInfo->width = 1;
+    textureInfo->height = 1;
+    textureInfo->id = textureId;
+    textureInfo->premultipliedAlpha = LAppDefine::PremultipliedAlphaEnable;
+    textureInfo->ready = false;
+    textureInfo->failed = false;
+    textureInfo->refCount = 1;
+    RegisterTexture(textureInfo);
+    SetTextureBytes(textureInfo, EstimateTextureBytes(1, 1, false));
+
+    StartDecodeThreads();
+    {
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+        DecodeJob job;
+        job.textureId = textureId;
+        job.fileName = fileName;
+        _decodeJobs.push_back(job);
     }
+    _decodeCondition.notify_one();
 
     return textureInfo;
+}
+
+void LAppTextureManager::UpdatePendingTextures()
+{
+    // 取出解码完成的图像，为其准备 PBO
+    {
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+        while (!_decodedImages.empty())
+        {
+            PendingUpload upload;
+            upload.decoded = _decodedImages.front();
+            upload.pixelBuffer = 0;
+            upload.mapped = NULL;
+            upload.copiedBytes = 0;
+            _decodedImages.pop_front();
+            _pendingUploads.push_back(upload);
+        }
+    }
+
+    size_t budget = static_cast<size_t>(LAppDefine::TextureUploadBytesPerFrame);
+
+    while (!_pendingUploads.empty() && budget > 0)
+    {
+        PendingUpload& upload = _pendingUploads.front();
 
+        // 纹理已被释放（ID 可能已被新纹理复用）或解码失败
+        TextureInfo* textureInfo = GetTextureInfoById(upload.decoded.textureId);
+        if (textureInfo == NULL || textureInfo->ready || textureInfo->fileName != upload.decoded.fileName || upload.decoded.image.levelCount == 0)
+        {
+            // 解码失败时记为失败并保留占位图，等待该纹理的模型据此结束加载
+            if (textureInfo != NULL && !textureInfo->ready && textureInfo->fileName == upload.decoded.fileName)
+            {
+                textureInfo->failed = true;
+                LAppPal::PrintLogLn("[APP]texture load failed: %s", textureInfo->fileName.c_str());
+            }
+            CancelUpload(upload);
+            _pendingUploads.pop_front();
+            continue;
+        }
+
+        const size_t totalBytes = LAppTextureCache::GetImageBytes(upload.decoded.image);
+
+        if (upload.pixelBuffer == 0)
+        {
+            glGenBuffers(1, &upload.pixelBuffer);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pixelBuffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(totalBytes), NULL, GL_STREAM_DRAW);
+            upload.mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(totalBytes),
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            if (upload.mapped == NULL)
+            {
+                // 无法映射时退回到直接从内存上传
+                glDeleteBuffers(1, &upload.pixelBuffer);
+                upload.pixelBuffer = 0;
+                upload.copiedBytes = totalBytes;
+            }
+        }
+
+        // 映射状态属于缓冲对象本身，解绑后映射地址依旧有效，可以跨帧写入
+        if (upload.mapped != NULL)
+        {
+            const size_t copyBytes = std::min(budget, totalBytes - upload.copiedBytes);
+            LAppTextureCache::CopyImageBytes(upload.decoded.image, upload.copiedBytes, copyBytes, upload.mapped + upload.copiedBytes);
+            upload.copiedBytes += copyBytes;
+            budget -= copyBytes;
+        }
+
+        if (upload.copiedBytes < totalBytes)
+        {
+            break;
+        }
+
+        FinishUpload(upload);
+        _pendingUploads.pop_front();
+    }
 }
 
-void LAppTextureManager::ReleaseTextures()
+bool LAppTextureManager::HasPendingTextures() const
 {
     for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
     {
-        glDeleteTextures(1, &(_texturesInfo[i]->id));
+        if (!_texturesInfo[i]->ready && !_texturesInfo[i]->failed)
+        {
+            return true;
+        }
     }
 
-    ReleaseTexturesInfo();
+    return false;
 }
 
-void LAppTextureManager::ReleaseTexture(Csm::csmUint32 textureId)
+void LAppTextureManager::FinishUpload(PendingUpload& upload)
 {
-    for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
+    TextureInfo* textureInfo = GetTextureInfoById(upload.decoded.textureId);
+    bool fromPixelBuffer = false;
+
+    if (upload.pixelBuffer != 0)
     {
-        if (_texturesInfo[i]->id != textureId)
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pixelBuffer);
+        // 映射期间数据损坏时返回 GL_FALSE，此时退回到直接上传
+        fromPixelBuffer = (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE);
+        if (!fromPixelBuffer)
         {
-            continue;
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
         }
-        glDeleteTextures(1, &(_texturesInfo[i]->id));
-        delete _texturesInfo[i];
-        _texturesInfo.Remove(i);
-        break;
+    }
+
+    UploadTexture(upload.decoded.textureId, upload.decoded.image, fromPixelBuffer);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (upload.pixelBuffer != 0)
+    {
+        glDeleteBuffers(1, &upload.pixelBuffer);
+    }
+
+    textureInfo->width = upload.decoded.image.width;
+    textureInfo->height = upload.decoded.image.height;
+    textureInfo->ready = true;
+    SetTextureBytes(textureInfo, EstimateTextureBytes(textureInfo->width, textureInfo->height, true));
+    LAppTextureCache::ReleaseImage(&upload.decoded.image);
+
+    if (LAppDefine::DebugLogEnable)
+    {
+        LAppPal::PrintLogLn("[APP]texture ready: %s (%u textures, %.1f MB)", textureInfo->fileName.c_str(),
+            GetTextureCount(), static_cast<double>(_textureBytes) / (1024.0 * 1024.0));
     }
 }
 
-void LAppTextureManager::ReleaseTexture(std::string fileName)
+void LAppTextureManager::CancelUpload(PendingUpload& upload)
+{
+    if (upload.pixelBuffer != 0)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pixelBuffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &upload.pixelBuffer);
+    }
+    LAppTextureCache::ReleaseImage(&upload.decoded.image);
+}
+
+void LAppTextureManager::CancelPendingTexture(Csm::csmUint32 textureId)
+{
+    {
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+        for (std::deque<DecodeJob>::iterator it = _decodeJobs.begin(); it != _decodeJobs.end(); )
+        {
+            it = (it->textureId == textureId) ? _decodeJobs.erase(it) : it + 1;
+        }
+        for (std::deque<DecodedImage>::iterator it = _decodedImages.begin(); it != _decodedImages.end(); )
+        {
+            if (it->textureId == textureId)
+            {
+                LAppTextureCache::ReleaseImage(&it->image);
+                it = _decodedImages.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (std::deque<PendingUpload>::iterator it = _pendingUploads.begin(); it != _pendingUploads.end(); )
+    {
+        if (it->decoded.textureId == textureId)
+        {
+            CancelUpload(*it);
+            it = _pendingUploads.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void LAppTextureManager::StartDecodeThreads()
+{
+    if (!_decodeThreads.empty())
+    {
+        return;
+    }
+
+    // 保留一个核心给渲染线程
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    const unsigned int threadCount = std::max(1u, std::min(4u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u));
+
+    _decodeStopping = false;
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        _decodeThreads.push_back(std::thread(&LAppTextureManager::DecodeThreadMain, this));
+    }
+}
+
+void LAppTextureManager::StopDecodeThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+        _decodeStopping = true;
+        _decodeJobs.clear();
+    }
+    _decodeCondition.notify_all();
+
+    for (size_t i = 0; i < _decodeThreads.size(); i++)
+    {
+        _decodeThreads[i].join();
+    }
+    _decodeThreads.clear();
+
+    for (size_t i = 0; i < _decodedImages.size(); i++)
+    {
+        LAppTextureCache::ReleaseImage(&_decodedImages[i].image);
+    }
+    _decodedImages.clear();
+
+    for (size_t i = 0; i < _pendingUploads.size(); i++)
+    {
+        CancelUpload(_pendingUploads[i]);
+    }
+    _pendingUploads.clear();
+}
+
+void LAppTextureManager::DecodeThreadMain()
+{
+    for (;;)
+    {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(_decodeMutex);
+            _decodeCondition.wait(lock, [this] { return _decodeStopping || !_decodeJobs.empty(); });
+            if (_decodeStopping)
+            {
+                return;
+            }
+            job = _decodeJobs.front();
+            _decodeJobs.pop_front();
+        }
+
+        DecodedImage decoded;
+        decoded.textureId = job.textureId;
+        decoded.fileName = job.fileName;
+        LoadImageFile(job.fileName, &decoded.image);
+
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+        if (_decodeStopping)
+        {
+            LAppTextureCache::ReleaseImage(&decoded.image);
+            return;
+        }
+        _decodedImages.push_back(decoded);
+    }
+}
+
+void LAppTextureManager::ReleaseTextures()
 {
     for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
     {
-        if (_texturesInfo[i]->fileName == fileName)
+        if (!_texturesInfo[i]->ready)
         {
-            glDeleteTextures(1, &(_texturesInfo[i]->id));
-            delete _texturesInfo[i];
-            _texturesInfo.Remove(i);
-            break;
+            CancelPendingTexture(_texturesInfo[i]->id);
         }
+        glDeleteTextures(1, &(_texturesInfo[i]->id));
     }
+
+    ReleaseTexturesInfo();
+    _indexByName.clear();
+    _indexById.clear();
+    _textureBytes = 0;
+}
+
+void LAppTextureManager::ReleaseTexture(Csm::csmUint32 textureId)
+{
+    std::unordered_map<Csm::csmUint32, Csm::csmUint32>::const_iterator it = _indexById.find(textureId);
+    if (it == _indexById.end())
+    {
+        return;
+    }
+
+    TextureInfo* textureInfo = _texturesInfo[it->second];
+    if (--textureInfo->refCount > 0)
+    {
+        return;
+    }
+
+    if (!textureInfo->ready)
+    {
+        CancelPendingTexture(textureInfo->id);
+    }
+    DestroyTexture(it->second);
+}
+
+void LAppTextureManager::ReleaseTexture(std::string fileName)
+{
+    TextureInfo* textureInfo = GetTextureInfoByName(fileName);
+    if (textureInfo != NULL)
+    {
+        ReleaseTexture(textureInfo->id);
+    }
+}
+
+LAppTextureManager::TextureInfo* LAppTextureManager::GetTextureInfoByName(std::string& fileName) const
+{
+    std::unordered_map<std::string, Csm::csmUint32>::const_iterator it = _indexByName.find(fileName);
+    return (it != _indexByName.end()) ? _texturesInfo[it->second] : NULL;
+}
+
+LAppTextureManager::TextureInfo* LAppTextureManager::GetTextureInfoById(Csm::csmUint32 textureId) const
+{
+    std::unordered_map<Csm::csmUint32, Csm::csmUint32>::const_iterator it = _indexById.find(textureId);
+    return (it != _indexById.end()) ? _texturesInfo[it->second] : NULL;
+}
+
+Csm::csmUint32 LAppTextureManager::GetTextureCount() const
+{
+    return static_cast<Csm::csmUint32>(_texturesInfo.GetSize());
+}
+
+size_t LAppTextureManager::GetTextureMemoryBytes() const
+{
+    return _textureBytes;
+}
+
+size_t LAppTextureManager::EstimateTextureBytes(int width, int height, bool mipmapped)
+{
+    size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    while (mipmapped && (width > 1 || height > 1))
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        bytes += static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    }
+    return bytes;
+}
+
+void LAppTextureManager::RegisterTexture(TextureInfo* textureInfo)
+{
+    const Csm::csmUint32 index = static_cast<Csm::csmUint32>(_texturesInfo.GetSize());
+    _texturesInfo.PushBack(textureInfo);
+    _indexByName[textureInfo->fileName] = index;
+    _indexById[textureInfo->id] = index;
+    textureInfo->gpuBytes = 0;
+}
+
+void LAppTextureManager::DestroyTexture(Csm::csmUint32 index)
+{
+    TextureInfo* textureInfo = _texturesInfo[index];
+
+    glDeleteTextures(1, &textureInfo->id);
+    _indexByName.erase(textureInfo->fileName);
+    _indexById.erase(textureInfo->id);
+    _textureBytes -= textureInfo->gpuBytes;
+
+    // 用末尾元素填补空位，避免移动整个数组
+    const Csm::csmUint32 last = static_cast<Csm::csmUint32>(_texturesInfo.GetSize()) - 1;
+    if (index != last)
+    {
+        TextureInfo* moved = _texturesInfo[last];
+        _texturesInfo[index] = moved;
+        _indexByName[moved->fileName] = index;
+        _indexById[moved->id] = index;
+    }
+    _texturesInfo.Remove(last);
+
+    delete textureInfo;
+}
+
+void LAppTextureManager::SetTextureBytes(TextureInfo* textureInfo, size_t bytes)
+{
+    _textureBytes = _textureBytes - textureInfo->gpuBytes + bytes;
+    textureInfo->gpuBytes = bytes;
 }
@@ -3,21 +3,43 @@
  */
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <Type/csmVector.hpp>
 
+#include "LAppTextureCache.hpp"
 #include "LAppTextureManager_Common.hpp"
 
 /**
  * @brief 纹理管理类（继承自 LAppTextureManager_Common）
  *
  * 负责图像的加载与管理。
+ * 进程内共享一个实例（GetInstance），按路径与纹理 ID 建立哈希索引，
+ * 以引用计数管理纹理，多个模型共用同一张图集时只加载一次。
  */
 class LAppTextureManager : public LAppTextureManager_Common
 {
 public:
+    /**
+    * @brief 返回进程内共享的实例
+    *
+    * 若实例尚未创建则内部创建并返回。
+    * @return 实例指针
+    */
+    static LAppTextureManager* GetInstance();
+
+    /**
+    * @brief 释放共享实例（需在 OpenGL 上下文有效时调用）
+    */
+    static void ReleaseInstance();
+
     /**
     * @brief 构造函数
     */
@@ -31,29 +53,157 @@ public:
     /**
     * @brief 从 PNG 文件创建纹理
     *
+    * 已加载过的文件直接返回已有纹理并增加引用计数。
+    *
     * @param[in] fileName 要加载的图片文件路径
     * @return 纹理信息，加载失败时返回 NULL
     */
     TextureInfo* CreateTextureFromPngFile(std::string fileName);
 
+    /**
+    * @brief 异步地从 PNG 文件创建纹理
+    *
+    * 立即返回一个绑定了 1x1 透明占位图的纹理（ready 为 false），
+    * PNG 的读取与解码在工作线程中进行，之后由 UpdatePendingTextures 经 PBO 分帧上传。
+    * 已加载过的文件直接返回已有纹理并增加引用计数。
+    *
+    * @param[in] fileName 要加载的图片文件路径
+    * @return 纹理信息
+    */
+    TextureInfo* CreateTextureFromPngFileAsync(std::string fileName);
+
+    /**
+    * @brief 推进异步纹理的上传
+    *
+    * 需要在 OpenGL 线程中每帧调用一次。每帧最多向 PBO 写入
+    * LAppDefine::TextureUploadBytesPerFrame 字节，写满后提交上传并标记 ready。
+    */
+    void UpdatePendingTextures();
+
+    /**
+    * @brief 是否仍有正在加载的纹理（解码失败的纹理视为加载结束）
+    */
+    bool HasPendingTextures() const;
+
     /**
     * @brief 释放所有纹理
     *
-    * 释放存储在数组中的所有纹理
+    * 不论引用计数，释放存储在数组中的所有纹理
     */
     void ReleaseTextures();
 
     /**
-     * @brief 释放指定纹理 ID 的纹理
+     * @brief 减少指定纹理 ID 的引用计数，归零时释放纹理
      *
      * @param[in] textureId 要释放的纹理 ID
      */
     void ReleaseTexture(Csm::csmUint32 textureId);
 
     /**
-    * @brief 释放指定文件名对应的纹理
+    * @brief 减少指定文件名对应纹理的引用计数，归零时释放纹理
     *
     * @param[in] fileName 要释放的纹理文件路径
     */
     void ReleaseTexture(std::string fileName);
+
+    /**
+     * @brief 根据文件名获取纹理信息（哈希查找）
+     */
+    virtual TextureInfo* GetTextureInfoByName(std::string& fileName) const;
+
+    /**
+     * @brief 根据纹理 ID 获取纹理信息（哈希查找）
+     */
+    virtual TextureInfo* GetTextureInfoById(Csm::csmUint32 textureId) const;
+
+    /**
+     * @brief 当前持有的纹理数量
+     */
+    Csm::csmUint32 GetTextureCount() const;
+
+    /**
+     * @brief 当前纹理占用的显存字节数（含 mipmap 的估算值）
+     */
+    size_t GetTextureMemoryBytes() const;
+
+private:
+    /**
+     * @brief 解码任务
+     */
+    struct DecodeJob
+    {
+        Csm::csmUint32 textureId;   ///< 目标纹理 ID
+        std::string fileName;       ///< 文件路径
+    };
+
+    /**
+     * @brief 工作线程解码完成的图像
+     */
+    struct DecodedImage
+    {
+        Csm::csmUint32 textureId;       ///< 目标纹理 ID
+        std::string fileName;           ///< 文件路径（纹理 ID 可能被复用，上传前需再次核对）
+        LAppTextureCache::Image image;  ///< 像素数据（加载失败时 levelCount 为 0）
+    };
+
+    /**
+     * @brief 正在经 PBO 上传的图像
+     */
+    struct PendingUpload
+    {
+        DecodedImage decoded;       ///< 解码结果
+        GLuint pixelBuffer;         ///< PBO（映射失败时为 0，直接从内存上传）
+        unsigned char* mapped;      ///< PBO 的映射地址
+        size_t copiedBytes;         ///< 已写入 PBO 的字节数
+    };
+
+    /**
+     * @brief 读取 PNG 文件并取得像素（可在任意线程调用）
+     *
+     * 启用纹理缓存时先按 PNG 内容哈希查找缓存，命中则直接 mmap，
+     * 未命中则解码、预乘并生成 mipmap 后写入缓存。
+     *
+     * @param[in]  fileName 文件路径
+     * @param[out] image    像素数据，需用 LAppTextureCache::ReleaseImage 释放
+     * @return 成功返回 true
+     */
+    static bool LoadImageFile(const std::string& fileName, LAppTextureCache::Image* image);
+
+    /**
+     * @brief 将像素上传到纹理，缓存中没有 mipmap 时由 GPU 生成
+     *
+     * @param[in] textureId        纹理 ID
+     * @param[in] image            像素数据
+     * @param[in] fromPixelBuffer  为 true 时从当前绑定的 PBO 中按层级顺序读取
+     */
+    static void UploadTexture(GLuint textureId, const LAppTextureCache::Image& image, bool fromPixelBuffer);
+
+    /**
+     * @brief 估算纹理（含完整 mipmap 链）占用的显存字节数
+     */
+    static size_t EstimateTextureBytes(int width, int height, bool mipmapped);
+
+    void RegisterTexture(TextureInfo* textureInfo);     ///< 加入列表与索引
+    void DestroyTexture(Csm::csmUint32 index);          ///< 删除 GL 纹理并从列表与索引中移除
+    void SetTextureBytes(TextureInfo* textureInfo, size_t bytes);   ///< 更新显存统计
+
+    void StartDecodeThreads();          ///< 按需启动解码线程
+    void StopDecodeThreads();           ///< 停止并等待解码线程
+    void DecodeThreadMain();            ///< 解码线程主循环
+    void FinishUpload(PendingUpload& upload);   ///< 结束一次上传
+    void CancelUpload(PendingUpload& upload);   ///< 放弃一次上传
+    void CancelPendingTexture(Csm::csmUint32 textureId);    ///< 放弃指定纹理的异步加载
+
+    std::vector<std::thread> _decodeThreads;        ///< 解码线程池
+    std::mutex _decodeMutex;                        ///< 保护下面的队列
+    std::condition_variable _decodeCondition;       ///< 通知解码线程有新任务
+    std::deque<DecodeJob> _decodeJobs;              ///< 待解码
+    std::deque<DecodedImage> _decodedImages;        ///< 已解码待上传
+    bool _decodeStopping;                           ///< 解码线程退出标志
+
+    std::deque<PendingUpload> _pendingUploads;      ///< 上传中的图像（仅在 OpenGL 线程访问）
+
+    std::unordered_map<std::string, Csm::csmUint32> _indexByName;     ///< 文件名 -> _texturesInfo 下标
+    std::unordered_map<Csm::csmUint32, Csm::csmUint32> _indexById;    ///< 纹理 ID -> _texturesInfo 下标
+    size_t _textureBytes;                           ///< 显存占用合计
 };
@@ -7,6 +7,144 @@
 
 #include "LAppTextureManager_Common.hpp"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LAPP_PREMULTIPLY_X86
+#endif
+
+#ifdef AIPET_PREMULTIPLY_SELF_CHECK
+#include <cstring>
+#include <vector>
+#include "LAppLog.hpp"
+#endif
+
+namespace {
+
+#ifdef LAPP_PREMULTIPLY_X86
+    // 每个 16 位通道计算 c * (a + 1) >> 8，alpha 通道保持原值
+    __attribute__((target("sse2")))
+    size_t PremultiplySse2(unsigned char* rgba, size_t pixelCount)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+        size_t i = 0;
+        for (; i + 4 <= pixelCount; i += 4)
+        {
+            __m128i* p = reinterpret_cast<__m128i*>(rgba + i * 4);
+            const __m128i src = _mm_loadu_si128(p);
+
+            __m128i lo = _mm_unpacklo_epi8(src, zero);
+            __m128i hi = _mm_unpackhi_epi8(src, zero);
+
+            const __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128i mulLo = _mm_srli_epi16(_mm_mullo_epi16(lo, _mm_add_epi16(alphaLo, one)), 8);
+            __m128i mulHi = _mm_srli_epi16(_mm_mullo_epi16(hi, _mm_add_epi16(alphaHi, one)), 8);
+
+            lo = _mm_or_si128(_mm_and_si128(alphaMask, lo), _mm_andnot_si128(alphaMask, mulLo));
+            hi = _mm_or_si128(_mm_and_si128(alphaMask, hi), _mm_andnot_si128(alphaMask, mulHi));
+
+            _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+        }
+
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    size_t PremultiplyAvx2(unsigned char* rgba, size_t pixelCount)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi16(1);
+        const __m256i alphaMask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+
+        size_t i = 0;
+        for (; i + 8 <= pixelCount; i += 8)
+        {
+            __m256i* p = reinterpret_cast<__m256i*>(rgba + i * 4);
+            const __m256i src = _mm256_loadu_si256(p);
+
+            // unpack / pack 均按 128 位通道进行，像素顺序保持不变
+            __m256i lo = _mm256_unpacklo_epi8(src, zero);
+            __m256i hi = _mm256_unpackhi_epi8(src, zero);
+
+            const __m256i alphaLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            const __m256i alphaHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m256i mulLo = _mm256_srli_epi16(_mm256_mullo_epi16(lo, _mm256_add_epi16(alphaLo, one)), 8);
+            __m256i mulHi = _mm256_srli_epi16(_mm256_mullo_epi16(hi, _mm256_add_epi16(alphaHi, one)), 8);
+
+            lo = _mm256_blendv_epi8(mulLo, lo, alphaMask);
+            hi = _mm256_blendv_epi8(mulHi, hi, alphaMask);
+
+            _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+        }
+
+        return i;
+    }
+#endif
+
+#if defined(AIPET_PREMULTIPLY_SELF_CHECK) && defined(LAPP_PREMULTIPLY_X86)
+    typedef size_t (*PremultiplyKernel)(unsigned char* rgba, size_t pixelCount);
+
+    // 向量化实现处理整组像素，剩余像素与 PremultiplyPixels 一样交给标量循环
+    void PremultiplyWithKernel(PremultiplyKernel kernel, unsigned char* rgba, size_t pixelCount)
+    {
+        const size_t done = kernel(rgba, pixelCount);
+        LAppTextureManager_Common::PremultiplyPixelsScalar(rgba + done * 4, pixelCount - done);
+    }
+
+    bool CheckKernel(const char* name, PremultiplyKernel kernel)
+    {
+        // 全部 alpha 与颜色的组合，颜色分量各取不同的值
+        std::vector<unsigned char> source(256 * 256 * 4);
+        for (size_t i = 0; i < 256 * 256; i++)
+        {
+            const unsigned char color = static_cast<unsigned char>(i & 0xFF);
+            source[i * 4 + 0] = color;
+            source[i * 4 + 1] = static_cast<unsigned char>(color ^ 0x5A);
+            source[i * 4 + 2] = static_cast<unsigned char>(255 - color);
+            source[i * 4 + 3] = static_cast<unsigned char>(i >> 8);
+        }
+
+        std::vector<unsigned char> expected(source);
+        std::vector<unsigned char> actual(source);
+        LAppTextureManager_Common::PremultiplyPixelsScalar(expected.data(), 256 * 256);
+        PremultiplyWithKernel(kernel, actual.data(), 256 * 256);
+        if (memcmp(expected.data(), actual.data(), expected.size()) != 0)
+        {
+            LAppLogError(Category_Texture, "premultiply self-check: %s differs from the scalar result", name);
+            return false;
+        }
+
+        // 各种长度（覆盖 8 / 4 像素一组之后的剩余）与非对齐的起始地址，前后留出哨兵字节检查越界写入
+        const size_t MaxPixels = 67;
+        const size_t Guard = 64;
+        for (size_t offset = 0; offset < 16; offset++)
+        {
+            for (size_t pixelCount = 0; pixelCount <= MaxPixels; pixelCount++)
+            {
+                std::vector<unsigned char> expectedBuffer(Guard + offset + MaxPixels * 4 + Guard, 0xA5);
+                memcpy(expectedBuffer.data() + Guard + offset, source.data() + pixelCount * 977 % (256 * 256 - MaxPixels) * 4, pixelCount * 4);
+                std::vector<unsigned char> actualBuffer(expectedBuffer);
+
+                LAppTextureManager_Common::PremultiplyPixelsScalar(expectedBuffer.data() + Guard + offset, pixelCount);
+                PremultiplyWithKernel(kernel, actualBuffer.data() + Guard + offset, pixelCount);
+                if (expectedBuffer != actualBuffer)
+                {
+                    LAppLogError(Category_Texture, "premultiply self-check: %s differs at %zu pixels, offset %zu", name, pixelCount, offset);
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+#endif
+}
+
 LAppTextureManager_Common::LAppTextureManager_Common()
 {
 }
@@ -28,6 +166,65 @@ void LAppTextureManager_Common::ReleaseTexturesInfo()
     _texturesInfo.Clear();
 }
 
+void LAppTextureManager_Common::PremultiplyPixels(unsigned char* rgba, size_t pixelCount)
+{
+    size_t done = 0;
+
+#ifdef LAPP_PREMULTIPLY_X86
+    // 按 CPU 支持情况选择向量化实现，剩余不足一组的像素交给标量循环
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    static const bool hasSse2 = __builtin_cpu_supports("sse2");
+    if (hasAvx2)
+    {
+        done = PremultiplyAvx2(rgba, pixelCount);
+    }
+    else if (hasSse2)
+    {
+        done = PremultiplySse2(rgba, pixelCount);
+    }
+#endif
+
+    PremultiplyPixelsScalar(rgba + done * 4, pixelCount - done);
+}
+
+void LAppTextureManager_Common::PremultiplyPixelsScalar(unsigned char* rgba, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        unsigned char* p = rgba + i * 4;
+        const unsigned int alpha = p[3] + 1;
+        p[0] = static_cast<unsigned char>(p[0] * alpha >> 8);
+        p[1] = static_cast<unsigned char>(p[1] * alpha >> 8);
+        p[2] = static_cast<unsigned char>(p[2] * alpha >> 8);
+    }
+}
+
+bool LAppTextureManager_Common::CheckPremultiplyPixels()
+{
+#if defined(AIPET_PREMULTIPLY_SELF_CHECK) && defined(LAPP_PREMULTIPLY_X86)
+    bool ok = true;
+    int checked = 0;
+    if (__builtin_cpu_supports("avx2"))
+    {
+        ok = CheckKernel("AVX2", PremultiplyAvx2) && ok;
+        checked++;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        ok = CheckKernel("SSE2", PremultiplySse2) && ok;
+        checked++;
+    }
+
+    if (ok)
+    {
+        LAppLogInfo(Category_Texture, "premultiply self-check: %d SIMD kernels match the scalar result", checked);
+    }
+    return ok;
+#else
+    return true;
+#endif
+}
+
 LAppTextureManager_Common::TextureInfo* LAppTextureManager_Common::GetTextureInfoByName(std::string& fileName) const
 {
     // 遍历已加载的纹理列表，按文件名匹配
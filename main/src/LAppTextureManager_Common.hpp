@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include <Type/CubismBasicType.hpp>
@@ -29,6 +30,11 @@ public:
         int width;              ///< 宽度
         int height;             ///< 高度
         std::string fileName;   ///< 文件名
+        bool premultipliedAlpha; ///< 像素数据是否已预乘 alpha
+        bool ready;             ///< 像素是否已上传完毕（异步加载期间为占位图）
+        bool failed;            ///< 异步解码是否失败（保留 1x1 占位图，不再上传，视为加载结束）
+        int refCount;           ///< 引用计数
+        size_t gpuBytes;        ///< 占用的显存字节数（估算）
     };
 
     /**
@@ -65,6 +71,36 @@ public:
             );
     }
 
+    /**
+     * @brief 对整块 RGBA8 像素数据原地做预乘处理
+     *
+     * 结果与逐像素调用 Premultiply 完全一致。
+     * 运行时按 CPU 支持选择 AVX2 / SSE2 实现，否则退回标量循环。
+     *
+     * @param[in,out] rgba       RGBA8 像素数据
+     * @param[in]     pixelCount 像素个数
+     */
+    static void PremultiplyPixels(unsigned char* rgba, size_t pixelCount);
+
+    /**
+     * @brief 预乘处理的标量实现（作为 SIMD 实现的参照）
+     *
+     * @param[in,out] rgba       RGBA8 像素数据
+     * @param[in]     pixelCount 像素个数
+     */
+    static void PremultiplyPixelsScalar(unsigned char* rgba, size_t pixelCount);
+
+    /**
+     * @brief 检查各向量化实现与标量实现的结果是否一致
+     *
+     * 以 CMake 选项 AIPET_PREMULTIPLY_SELF_CHECK 构建时，对本机支持的 AVX2 / SSE2 实现
+     * 逐一检查全部 256 种 alpha 与颜色的组合，以及各种长度与非对齐起始地址（含不足一组的剩余像素），
+     * 不一致时输出日志。未启用时不做任何处理并返回 true。
+     *
+     * @return 全部一致（或未启用）时返回 true
+     */
+    static bool CheckPremultiplyPixels();
+
     /**
      * @brief 根据文件名获取纹理信息
      *
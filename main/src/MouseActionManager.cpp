@@ -3,7 +3,7 @@
  * 这个文件实现了鼠标操作管理器，支持鼠标拖拽模型和视图平移缩放功能。
  */
 #include "MouseActionManager.hpp"
-#include <iostream>
+#include "LAppLog.hpp"
 
 namespace {
     MouseActionManager* instance = NULL;
@@ -71,11 +71,11 @@ void MouseActionManager::OnMouseCallBack(GLFWwindow* window, int button, int act
             _middleCaptured = true;
             _lastMouseX = _mouseX;
             _lastMouseY = _mouseY;
-            std::cout << "[Mouse] Middle button pressed - start panning at (" << _lastMouseX << ", " << _lastMouseY << ")" << std::endl;
+            LAppLogDebug(Category_Input, "Middle button pressed - start panning at (%.1f, %.1f)", _lastMouseX, _lastMouseY);
             break;
         case GLFW_RELEASE:
             _middleCaptured = false;
-            std::cout << "[Mouse] Middle button released - stop panning" << std::endl;
+            LAppLogDebug(Category_Input, "Middle button released - stop panning");
             break;
         default:
             break;
@@ -111,7 +111,7 @@ void MouseActionManager::OnMouseCallBack(GLFWwindow* window, double x, double y)
 
         _viewMatrix->AdjustTranslate(dx, dy);
 
-        std::cout << "[Mouse] Panning view by (" << dx << ", " << dy << ")" << std::endl;
+        LAppLogVerbose(Category_Input, "Panning view by (%.4f, %.4f)", dx, dy);
         _lastMouseX = _mouseX;
         _lastMouseY = _mouseY;
         return;
@@ -143,6 +143,6 @@ void MouseActionManager::OnScroll(GLFWwindow* window, double xoffset, double yof
     float factor = 1.0f + static_cast<float>(yoffset) * 0.5f;
     if (factor <= 0.0f) factor = 1.0f;
 
-    std::cout << "[Mouse] Scroll detected yoffset=" << yoffset << " factor=" << factor << std::endl;
+    LAppLogDebug(Category_Input, "Scroll detected yoffset=%.2f factor=%.2f", yoffset, factor);
     _viewMatrix->AdjustScale(viewX, viewY, factor);
 }
@@ -0,0 +1,200 @@
+/**
+ * @file AIPetAssetConverter.cpp
+ * @brief 把 motion3/exp3/physics3.json 转换为 Utils::CubismBinary 格式的命令行工具
+ *
+ * 用法：AIPetAssetConverter <文件或目录>...
+ * 目录会被递归遍历。输出写在 JSON 旁边，扩展名 .json 替换为 .bin。
+ * 应用加载时若 .bin 存在且不比 JSON 旧，则直接读取 .bin，跳过 JSON 解析。
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <CubismFramework.hpp>
+#include <Motion/CubismMotion.hpp>
+#include <Motion/CubismExpressionMotion.hpp>
+#include <Physics/CubismPhysics.hpp>
+#include <Utils/CubismBinary.hpp>
+
+#include "LAppAllocator_Common.hpp"
+
+using namespace Csm;
+
+namespace {
+
+/**
+ * @brief 判断字符串是否以指定后缀结尾
+ */
+bool EndsWith(const std::string& text, const char* suffix)
+{
+    const size_t length = strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+/**
+ * @brief 读取整个文件
+ */
+bool ReadFile(const std::string& path, std::vector<csmByte>& data)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * @brief 先写临时文件再改名，避免应用读到写了一半的文件
+ */
+bool WriteFile(const std::string& path, const csmVector<csmByte>& data)
+{
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        // 空的数据写成 0 字节的文件（此时不能取 data[0] 的地址）
+        if (data.GetSize() > 0)
+        {
+            file.write(reinterpret_cast<const char*>(&data[0]), data.GetSize());
+        }
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    return !error;
+}
+
+/**
+ * @brief 转换单个文件
+ *
+ * @return 成功返回 true；不支持的文件类型也返回 true（跳过）
+ */
+bool ConvertFile(const std::string& path)
+{
+    const csmString binaryPath = Utils::CubismBinary::GetBinaryFileName(path.c_str());
+    if (binaryPath.GetLength() == 0)
+    {
+        return true;
+    }
+
+    std::vector<csmByte> json;
+    if (!ReadFile(path, json) || json.empty())
+    {
+        fprintf(stderr, "无法读取：%s\n", path.c_str());
+        return false;
+    }
+
+    const csmSizeInt size = static_cast<csmSizeInt>(json.size());
+    csmVector<csmByte> binary;
+    bool converted = false;
+
+    if (EndsWith(path, ".motion3.json"))
+    {
+        CubismMotion* motion = CubismMotion::Create(json.data(), size);
+        if (motion != NULL)
+        {
+            motion->ExportBinary(binary);
+            ACubismMotion::Delete(motion);
+            converted = true;
+        }
+    }
+    else if (EndsWith(path, ".exp3.json"))
+    {
+        CubismExpressionMotion* expression = CubismExpressionMotion::Create(json.data(), size);
+        if (expression != NULL)
+        {
+            expression->ExportBinary(binary);
+            ACubismMotion::Delete(expression);
+            converted = true;
+        }
+    }
+    else if (EndsWith(path, ".physics3.json"))
+    {
+        CubismPhysics* physics = CubismPhysics::Create(json.data(), size);
+        if (physics != NULL)
+        {
+            physics->ExportBinary(binary);
+            CubismPhysics::Delete(physics);
+            converted = true;
+        }
+    }
+
+    if (!converted)
+    {
+        fprintf(stderr, "解析失败：%s\n", path.c_str());
+        return false;
+    }
+
+    if (!WriteFile(binaryPath.GetRawString(), binary))
+    {
+        fprintf(stderr, "无法写入：%s\n", binaryPath.GetRawString());
+        return false;
+    }
+
+    printf("%s -> %s (%zu -> %u bytes)\n", path.c_str(), binaryPath.GetRawString(), json.size(), binary.GetSize());
+    return true;
+}
+
+/**
+ * @brief 框架日志输出到标准错误
+ */
+void PrintMessage(const csmChar* message)
+{
+    fputs(message, stderr);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "用法：%s <motion3/exp3/physics3.json 文件或目录>...\n", argv[0]);
+        return 2;
+    }
+
+    LAppAllocator_Common allocator;
+    CubismFramework::Option option;
+    option.LogFunction = PrintMessage;
+    option.LoggingLevel = CubismFramework::Option::LogLevel_Warning;
+    CubismFramework::StartUp(&allocator, &option);
+    CubismFramework::Initialize();
+
+    int failures = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::error_code error;
+        if (std::filesystem::is_directory(argv[i], error))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(argv[i], error))
+            {
+                if (entry.is_regular_file() && !ConvertFile(entry.path().string()))
+                {
+                    ++failures;
+                }
+            }
+        }
+        else if (!ConvertFile(argv[i]))
+        {
+            ++failures;
+        }
+    }
+
+    CubismFramework::Dispose();
+
+    return failures == 0 ? 0 : 1;
+}
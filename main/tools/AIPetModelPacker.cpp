@@ -0,0 +1,233 @@
+/**
+ * @file AIPetModelPacker.cpp
+ * @brief 把模型目录打包为单个 .aipack 文件的命令行工具
+ *
+ * 用法：AIPetModelPacker [--store] <模型目录>...
+ * 目录 X/Haru/ 的包写在 X/Haru.aipack。目录被递归遍历，文件按相对路径存入包中。
+ * 默认用 LZ4 压缩，压缩后没有变小 1/8 的文件（PNG 等）原样存放；--store 时全部原样存放。
+ * 加载模型时马上读取的文件（model3.json、moc3、.bin 等）放在包的前部，应用挂载时只预读这一部分；
+ * 纹理、音频以及已有 .bin 的 JSON 放在后部。
+ * 比对应 JSON 旧的 .bin（AIPetAssetConverter 的输出）不会被打包，应用加载包时不再比较新旧。
+ * 修改模型文件后需要重新运行本工具，否则应用仍读取包中的旧数据。
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "LAppModelPackFormat.hpp"
+
+using namespace Csm;
+
+namespace {
+
+/**
+ * @brief 判断字符串是否以指定后缀结尾
+ */
+bool EndsWith(const std::string& text, const char* suffix)
+{
+    const size_t length = strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+/**
+ * @brief 读取整个文件
+ */
+bool ReadFile(const std::string& path, std::vector<csmByte>& data)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * @brief 先写临时文件再改名，避免应用读到写了一半的包
+ */
+bool WriteFile(const std::string& path, const std::vector<csmByte>& data)
+{
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    return !error;
+}
+
+/**
+ * @brief 是否为比对应 JSON 旧的 .bin
+ */
+bool IsStaleBinary(const std::filesystem::path& path)
+{
+    if (path.extension() != ".bin")
+    {
+        return false;
+    }
+
+    std::filesystem::path jsonPath = path;
+    jsonPath.replace_extension(".json");
+
+    std::error_code error;
+    const std::filesystem::file_time_type jsonTime = std::filesystem::last_write_time(jsonPath, error);
+    if (error)
+    {
+        return false;
+    }
+    return std::filesystem::last_write_time(path, error) < jsonTime;
+}
+
+/**
+ * @brief 是否为加载模型时马上读取的文件
+ *
+ * 纹理与音频在其他线程或播放时才读取；有可用 .bin 的 JSON 在应用中不会被读取。
+ */
+bool IsPreloadFile(const std::filesystem::path& path)
+{
+    const std::string extension = path.extension().string();
+    if (extension == ".png" || extension == ".wav")
+    {
+        return false;
+    }
+
+    if (extension == ".json")
+    {
+        std::filesystem::path binaryPath = path;
+        binaryPath.replace_extension(".bin");
+
+        std::error_code error;
+        if (std::filesystem::is_regular_file(binaryPath, error) && !IsStaleBinary(binaryPath))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 打包单个模型目录
+ */
+bool PackDirectory(const std::string& directory, LAppModelPackFormat::Compression compression)
+{
+    std::filesystem::path root(directory);
+    if (!root.has_filename())
+    {
+        root = root.parent_path();
+    }
+    const std::string packPath = root.string() + ".aipack";
+
+    // 遍历顺序由文件系统决定，排序后包的内容才稳定
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error))
+    {
+        const std::string name = entry.path().filename().string();
+        if (!entry.is_regular_file() || name[0] == '.' || EndsWith(name, ".tmp"))
+        {
+            continue;
+        }
+        if (IsStaleBinary(entry.path()))
+        {
+            fprintf(stderr, "跳过比 JSON 旧的 .bin：%s\n", entry.path().string().c_str());
+            continue;
+        }
+        files.push_back(entry.path());
+    }
+    if (error)
+    {
+        fprintf(stderr, "无法遍历目录：%s\n", directory.c_str());
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+
+    LAppModelPackWriter writer;
+    size_t sourceBytes = 0;
+    std::vector<csmByte> data;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        const std::string relativePath = files[i].lexically_relative(root).generic_string();
+        if (!ReadFile(files[i].string(), data))
+        {
+            fprintf(stderr, "无法读取：%s\n", files[i].string().c_str());
+            return false;
+        }
+        if (!writer.AddFile(relativePath, data.data(), data.size(), compression, IsPreloadFile(files[i])))
+        {
+            fprintf(stderr, "无法加入包中：%s\n", files[i].string().c_str());
+            return false;
+        }
+        sourceBytes += data.size();
+    }
+
+    std::vector<csmByte> pack;
+    writer.Finish(pack);
+    if (!WriteFile(packPath, pack))
+    {
+        fprintf(stderr, "无法写入：%s\n", packPath.c_str());
+        return false;
+    }
+
+    printf("%s -> %s (%zu files, %zu -> %zu bytes)\n", directory.c_str(), packPath.c_str(), files.size(), sourceBytes, pack.size());
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    LAppModelPackFormat::Compression compression = LAppModelPackFormat::Compression_Lz4;
+    std::vector<std::string> directories;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--store") == 0)
+        {
+            compression = LAppModelPackFormat::Compression_None;
+        }
+        else
+        {
+            directories.push_back(argv[i]);
+        }
+    }
+
+    if (directories.empty())
+    {
+        fprintf(stderr, "用法：%s [--store] <模型目录>...\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (size_t i = 0; i < directories.size(); ++i)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(directories[i], error))
+        {
+            fprintf(stderr, "不是目录：%s\n", directories[i].c_str());
+            ++failures;
+        }
+        else if (!PackDirectory(directories[i], compression))
+        {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}